@@ -0,0 +1,51 @@
+//=======================================================================
+// Copyright Baptiste Wicht 2011-2016.
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <boost/property_tree/ptree.hpp>
+
+namespace eddic {
+
+namespace bench {
+
+/*!
+ * Return the nearest-rank percentile of the given samples.
+ * \param samples The samples, must not be empty.
+ * \param p The percentile, between 0 and 100.
+ */
+template<typename T>
+T percentile(std::vector<T> samples, double p){
+    std::sort(samples.begin(), samples.end());
+
+    auto rank = static_cast<std::size_t>(std::ceil(p / 100.0 * samples.size()));
+    return samples[std::clamp<std::size_t>(rank, 1, samples.size()) - 1];
+}
+
+template<typename T>
+T median(const std::vector<T>& samples){
+    return percentile(samples, 50.0);
+}
+
+/*!
+ * Return a path of a property tree whose elements are separated by slashes, the keys can contain dots.
+ */
+inline boost::property_tree::ptree::path_type tree_path(const std::string& path){
+    return {path, '/'};
+}
+
+} //end of bench
+
+} //end of eddic
+
+#endif
@@ -0,0 +1,328 @@
+//=======================================================================
+// Copyright Baptiste Wicht 2011-2016.
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "boost_cfg.hpp"
+#include <boost/algorithm/string.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+#include "Options.hpp"
+#include "Compiler.hpp"
+#include "GlobalContext.hpp"
+#include "StopWatch.hpp"
+
+#include "bench.hpp"
+
+/*
+ * Compile-time benchmark of eddic.
+ *
+ * Every source of test/cases and eddi_samples is compiled in-process several times for each
+ * optimization level. One sample of a phase is the time spent in this phase for all the sources
+ * during one repetition, the median and the 90th percentile of the samples are reported.
+ *
+ * The results can be saved as a JSON baseline and compared against a previous baseline, in which
+ * case the benchmark fails if the median of a phase regressed by more than the threshold or if the
+ * number of sources that fail to compile changed.
+ *
+ * Must be run from the root of the repository.
+ */
+
+using namespace eddic;
+using bench::median;
+using bench::percentile;
+
+namespace {
+
+const std::string output_file = "bench.out";
+
+struct bench_options {
+    std::size_t runs = 5;
+    std::size_t warmup = 1;
+    std::vector<std::string> levels = {"O0", "O1", "O2", "O3"};
+    std::string baseline;
+    std::string save;
+    double threshold = 10.0;    //In percent
+    double min_time = 1.0;      //The phases faster than this (in ms) are too noisy to be compared
+};
+
+using Samples = std::map<std::string, std::vector<double>>;
+
+struct level_results {
+    Samples samples;
+    std::size_t failures = 0;   //Number of sources that do not compile, they are still timed
+};
+
+using Results = std::map<std::string, level_results>;
+
+void print_usage(){
+    std::cout << "Usage: bench [options]" << std::endl;
+    std::cout << "    --runs=N           Number of measured repetitions for each level (default 5)" << std::endl;
+    std::cout << "    --warmup=N         Number of repetitions before measuring (default 1)" << std::endl;
+    std::cout << "    --levels=O0,O2     Optimization levels to benchmark (default O0,O1,O2,O3)" << std::endl;
+    std::cout << "    --baseline=FILE    Compare the results against the given baseline" << std::endl;
+    std::cout << "    --save=FILE        Save the results as a baseline" << std::endl;
+    std::cout << "    --threshold=P      Regression threshold in percent of the baseline median (default 10)" << std::endl;
+    std::cout << "    --min-time=MS      Minimum baseline median of the compared phases (default 1)" << std::endl;
+}
+
+bool parse_arguments(int argc, const char* argv[], bench_options& options){
+    for(int i = 1; i < argc; ++i){
+        std::string argument = argv[i];
+
+        auto equals = argument.find('=');
+        auto name = argument.substr(0, equals);
+        auto value = equals == std::string::npos ? std::string() : argument.substr(equals + 1);
+
+        try {
+            if(name == "--runs"){
+                options.runs = std::stoul(value);
+            } else if(name == "--warmup"){
+                options.warmup = std::stoul(value);
+            } else if(name == "--levels"){
+                options.levels.clear();
+                boost::split(options.levels, value, boost::is_any_of(","));
+            } else if(name == "--baseline"){
+                options.baseline = value;
+            } else if(name == "--save"){
+                options.save = value;
+            } else if(name == "--threshold"){
+                options.threshold = std::stod(value);
+            } else if(name == "--min-time"){
+                options.min_time = std::stod(value);
+            } else {
+                return false;
+            }
+        } catch (const std::logic_error&) {
+            std::cout << "Invalid value for " << name << ": \"" << value << "\"" << std::endl;
+
+            return false;
+        }
+    }
+
+    return options.runs > 0;
+}
+
+std::vector<std::string> bench_sources(){
+    std::vector<std::string> sources;
+
+    for(auto directory : {"test/cases", "eddi_samples"}){
+        if(!std::filesystem::is_directory(directory)){
+            continue;
+        }
+
+        for(auto& entry : std::filesystem::directory_iterator(directory)){
+            if(entry.path().extension() == ".eddi"){
+                sources.push_back(entry.path().string());
+            }
+        }
+    }
+
+    //Always compile the sources in the same order
+    std::sort(sources.begin(), sources.end());
+
+    return sources;
+}
+
+std::shared_ptr<Configuration> bench_configuration(const std::string& source, const std::string& level){
+    std::string level_option = "--" + level;
+    std::string output_option = "--output=" + output_file;
+
+    const char* argv[] = {"bench", "--quiet", "--64", level_option.c_str(), output_option.c_str(), source.c_str()};
+
+    return parseOptions(6, argv);
+}
+
+/*!
+ * Compile all the sources once and add the time of each phase to the given times.
+ * \return The number of sources that failed to compile.
+ */
+std::size_t compile_all(const std::vector<std::string>& sources, const std::string& level, std::map<std::string, double>& times){
+    std::size_t failures = 0;
+
+    for(auto& source : sources){
+        auto configuration = bench_configuration(source, level);
+
+        Compiler compiler;
+
+        StopWatch watch;
+        auto code = compiler.compile(source, configuration);
+        times["total"] += watch.elapsed();
+
+        for(auto& timing : compiler.global_context().timing()){
+            times[timing.first] += timing.second;
+        }
+
+        if(code != 0){
+            ++failures;
+        }
+    }
+
+    return failures;
+}
+
+void report(const std::string& level, const level_results& results){
+    auto& samples = results.samples;
+
+    std::vector<std::pair<std::string, double>> phases;
+    for(auto& [phase, values] : samples){
+        phases.emplace_back(phase, median(values));
+    }
+
+    std::sort(phases.begin(), phases.end(), [](auto& lhs, auto& rhs){ return lhs.second > rhs.second; });
+
+    std::cout << "Level " << level << " (" << results.failures << " sources do not compile)" << std::endl;
+    std::cout << "    " << std::left << std::setw(40) << "phase" << std::right
+        << std::setw(12) << "median" << std::setw(12) << "p90" << std::setw(12) << "min" << std::setw(12) << "max" << std::endl;
+
+    std::cout << std::fixed << std::setprecision(2);
+
+    for(auto& [phase, phase_median] : phases){
+        auto& values = samples.at(phase);
+
+        std::cout << "    " << std::left << std::setw(40) << phase << std::right
+            << std::setw(12) << phase_median
+            << std::setw(12) << percentile(values, 90.0)
+            << std::setw(12) << *std::min_element(values.begin(), values.end())
+            << std::setw(12) << *std::max_element(values.begin(), values.end()) << std::endl;
+    }
+
+    std::cout << std::defaultfloat;
+}
+
+boost::property_tree::ptree::path_type path(const std::string& level, const std::string& phase, const std::string& value){
+    return bench::tree_path(level + "/" + phase + "/" + value);
+}
+
+void save_baseline(const std::string& file, const Results& results){
+    boost::property_tree::ptree tree;
+
+    for(auto& [level, level_result] : results){
+        tree.put(bench::tree_path(level + "/failures"), level_result.failures);
+
+        for(auto& [phase, values] : level_result.samples){
+            tree.put(path(level, phase, "median"), median(values));
+            tree.put(path(level, phase, "p90"), percentile(values, 90.0));
+        }
+    }
+
+    boost::property_tree::write_json(file, tree);
+
+    std::cout << "Baseline saved to " << file << std::endl;
+}
+
+/*!
+ * Compare the medians and the number of failures of the results against the baseline.
+ * \return The number of phases that regressed plus the number of levels whose failures changed.
+ */
+std::size_t compare_baseline(const std::string& file, const Results& results, const bench_options& options){
+    boost::property_tree::ptree tree;
+    boost::property_tree::read_json(file, tree);
+
+    std::size_t regressions = 0;
+
+    std::cout << "Comparison against " << file << " (threshold " << options.threshold << "%)" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+
+    for(auto& [level, level_result] : results){
+        //A different number of failures means that different code is compiled, the times are not comparable
+        auto failures = tree.get_optional<std::size_t>(bench::tree_path(level + "/failures"));
+
+        if(failures && *failures != level_result.failures){
+            std::cout << "    FAILURES " << level << ": " << *failures << " -> " << level_result.failures << " sources do not compile" << std::endl;
+            ++regressions;
+        }
+
+        for(auto& [phase, values] : level_result.samples){
+            auto baseline = tree.get_optional<double>(path(level, phase, "median"));
+
+            if(!baseline || *baseline < options.min_time){
+                continue;
+            }
+
+            auto current = median(values);
+            auto change = (current - *baseline) / *baseline * 100.0;
+
+            if(change > options.threshold){
+                std::cout << "    REGRESSION " << level << " " << phase << ": " << *baseline << "ms -> " << current << "ms (+" << change << "%)" << std::endl;
+                ++regressions;
+            } else if(change < -options.threshold){
+                std::cout << "    improvement " << level << " " << phase << ": " << *baseline << "ms -> " << current << "ms (" << change << "%)" << std::endl;
+            }
+        }
+    }
+
+    std::cout << std::defaultfloat;
+    std::cout << regressions << " regression(s)" << std::endl;
+
+    return regressions;
+}
+
+} //end of anonymous namespace
+
+int main(int argc, const char* argv[]){
+    bench_options options;
+
+    if(!parse_arguments(argc, argv, options)){
+        print_usage();
+        return 1;
+    }
+
+    auto sources = bench_sources();
+
+    if(sources.empty()){
+        std::cout << "No sources found, the benchmark must be run from the root of the repository" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Benchmark " << sources.size() << " sources, " << options.runs << " runs after " << options.warmup << " warmup runs" << std::endl;
+
+    Results results;
+
+    for(auto& level : options.levels){
+        for(std::size_t i = 0; i < options.warmup; ++i){
+            std::map<std::string, double> times;
+            compile_all(sources, level, times);
+        }
+
+        auto& level_result = results[level];
+
+        for(std::size_t i = 0; i < options.runs; ++i){
+            std::map<std::string, double> times;
+
+            //Some test cases are expected not to compile, the compilation is deterministic
+            level_result.failures = compile_all(sources, level, times);
+
+            for(auto& [phase, time] : times){
+                level_result.samples[phase].push_back(time);
+            }
+        }
+
+        report(level, level_result);
+    }
+
+    std::remove(output_file.c_str());
+
+    if(!options.save.empty()){
+        save_baseline(options.save, results);
+    }
+
+    if(!options.baseline.empty()){
+        return compare_baseline(options.baseline, results, options) ? 1 : 0;
+    }
+
+    return 0;
+}
@@ -0,0 +1,458 @@
+//=======================================================================
+// Copyright Baptiste Wicht 2011-2016.
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "boost_cfg.hpp"
+#include <boost/algorithm/string.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+#include "Options.hpp"
+#include "Compiler.hpp"
+
+#include "bench.hpp"
+
+/*
+ * Runtime benchmark of the code generated by eddic.
+ *
+ * Every kernel of the kernels directory is compiled for each platform and each optimization
+ * level and then run several times. For each configuration, the size of the executable, the
+ * minimum and median time and the median number of instructions and cycles are reported. The
+ * hardware counters are read with perf_event_open, they are omitted when the system does not
+ * allow it (see /proc/sys/kernel/perf_event_paranoid).
+ *
+ * The output of a kernel must be the same at every optimization level, otherwise the
+ * configuration is considered as failed.
+ *
+ * Must be run from the root of the repository.
+ */
+
+using namespace eddic;
+using bench::median;
+
+namespace {
+
+const std::string executable = "./kernel.out";
+const std::string output = "kernel.out.txt";
+
+struct bench_options {
+    std::size_t runs = 5;
+    std::vector<std::string> levels = {"O0", "O1", "O2", "O3"};
+    std::vector<std::string> platforms = {"32", "64"};
+    std::vector<std::string> kernels;
+    std::string baseline;
+    std::string save;
+};
+
+struct run_result {
+    bool success = false;
+    double time = 0.0;  //In ms
+    std::optional<std::uint64_t> instructions;
+    std::optional<std::uint64_t> cycles;
+};
+
+struct configuration_result {
+    bool success = true;
+    std::uintmax_t size = 0;
+    std::vector<double> times;
+    std::vector<std::uint64_t> instructions;
+    std::vector<std::uint64_t> cycles;
+};
+
+//kernel -> platform -> level -> result
+using Results = std::map<std::string, std::map<std::string, std::map<std::string, configuration_result>>>;
+
+void print_usage(){
+    std::cout << "Usage: runtime_bench [options]" << std::endl;
+    std::cout << "    --runs=N               Number of runs of each kernel in each configuration (default 5)" << std::endl;
+    std::cout << "    --levels=O0,O2         Optimization levels to benchmark (default O0,O1,O2,O3)" << std::endl;
+    std::cout << "    --platforms=32,64      Platforms to benchmark (default 32,64)" << std::endl;
+    std::cout << "    --kernels=fibonacci    Kernels to benchmark (default all the kernels)" << std::endl;
+    std::cout << "    --baseline=FILE        Compare the results against the given results" << std::endl;
+    std::cout << "    --save=FILE            Save the results" << std::endl;
+}
+
+bool parse_arguments(int argc, const char* argv[], bench_options& options){
+    for(int i = 1; i < argc; ++i){
+        std::string argument = argv[i];
+
+        auto equals = argument.find('=');
+        auto name = argument.substr(0, equals);
+        auto value = equals == std::string::npos ? std::string() : argument.substr(equals + 1);
+
+        if(name == "--runs"){
+            options.runs = std::stoul(value);
+        } else if(name == "--levels"){
+            options.levels.clear();
+            boost::split(options.levels, value, boost::is_any_of(","));
+        } else if(name == "--platforms"){
+            options.platforms.clear();
+            boost::split(options.platforms, value, boost::is_any_of(","));
+        } else if(name == "--kernels"){
+            options.kernels.clear();
+            boost::split(options.kernels, value, boost::is_any_of(","));
+        } else if(name == "--baseline"){
+            options.baseline = value;
+        } else if(name == "--save"){
+            options.save = value;
+        } else {
+            return false;
+        }
+    }
+
+    return options.runs > 0;
+}
+
+std::vector<std::string> bench_kernels(const bench_options& options){
+    if(!options.kernels.empty()){
+        return options.kernels;
+    }
+
+    std::vector<std::string> kernels;
+
+    if(std::filesystem::is_directory("kernels")){
+        for(auto& entry : std::filesystem::directory_iterator("kernels")){
+            if(entry.path().extension() == ".eddi"){
+                kernels.push_back(entry.path().stem().string());
+            }
+        }
+    }
+
+    std::sort(kernels.begin(), kernels.end());
+
+    return kernels;
+}
+
+bool compile_kernel(const std::string& kernel, const std::string& platform, const std::string& level){
+    std::string source = "kernels/" + kernel + ".eddi";
+    std::string platform_option = "--" + platform;
+    std::string level_option = "--" + level;
+    std::string output_option = "--output=" + executable;
+
+    const char* argv[] = {"runtime_bench", "--quiet", platform_option.c_str(), level_option.c_str(), output_option.c_str(), source.c_str()};
+
+    auto configuration = parseOptions(6, argv);
+
+    Compiler compiler;
+    return configuration && compiler.compile(source, configuration) == 0;
+}
+
+/*!
+ * \brief A hardware counter of a process, enabled when the process calls exec.
+ */
+struct perf_counter {
+    int fd;
+
+    perf_counter(pid_t pid, std::uint64_t config){
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = config;
+        attr.disabled = 1;
+        attr.enable_on_exec = 1;
+        attr.inherit = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+
+        fd = syscall(SYS_perf_event_open, &attr, pid, -1, -1, PERF_FLAG_FD_CLOEXEC);
+    }
+
+    perf_counter(const perf_counter& rhs) = delete;
+    perf_counter& operator=(const perf_counter& rhs) = delete;
+
+    ~perf_counter(){
+        if(fd >= 0){
+            close(fd);
+        }
+    }
+
+    std::optional<std::uint64_t> value() const {
+        std::uint64_t count = 0;
+
+        if(fd >= 0 && read(fd, &count, sizeof(count)) == sizeof(count)){
+            return count;
+        }
+
+        return {};
+    }
+};
+
+run_result run_kernel(){
+    run_result result;
+
+    //The child waits for the counters to be attached before calling exec
+    int start_pipe[2];
+    if(pipe(start_pipe) != 0){
+        return result;
+    }
+
+    pid_t pid = fork();
+
+    if(pid < 0){
+        close(start_pipe[0]);
+        close(start_pipe[1]);
+        return result;
+    }
+
+    if(pid == 0){
+        close(start_pipe[1]);
+
+        char c;
+        if(read(start_pipe[0], &c, 1) != 1){
+            _exit(127);
+        }
+
+        int fd = open(output.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if(fd < 0 || dup2(fd, STDOUT_FILENO) < 0){
+            _exit(127);
+        }
+
+        execl(executable.c_str(), executable.c_str(), static_cast<char*>(nullptr));
+        _exit(127);
+    }
+
+    close(start_pipe[0]);
+
+    perf_counter instructions(pid, PERF_COUNT_HW_INSTRUCTIONS);
+    perf_counter cycles(pid, PERF_COUNT_HW_CPU_CYCLES);
+
+    auto start = std::chrono::steady_clock::now();
+
+    char c = 0;
+    bool started = write(start_pipe[1], &c, 1) == 1;
+    close(start_pipe[1]);
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+
+    auto end = std::chrono::steady_clock::now();
+
+    result.success = started && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    result.time = std::chrono::duration<double, std::milli>(end - start).count();
+    result.instructions = instructions.value();
+    result.cycles = cycles.value();
+
+    return result;
+}
+
+std::string read_output(){
+    std::ifstream stream(output);
+    return {std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+}
+
+configuration_result bench_configuration(const std::string& kernel, const std::string& platform, const std::string& level, std::size_t runs, std::optional<std::string>& reference){
+    configuration_result result;
+
+    if(!compile_kernel(kernel, platform, level)){
+        std::cout << kernel << " does not compile with --" << platform << " --" << level << std::endl;
+        result.success = false;
+        return result;
+    }
+
+    result.size = std::filesystem::file_size(executable);
+
+    for(std::size_t i = 0; i < runs; ++i){
+        auto run = run_kernel();
+
+        if(!run.success){
+            std::cout << kernel << " failed with --" << platform << " --" << level << std::endl;
+            result.success = false;
+            return result;
+        }
+
+        result.times.push_back(run.time);
+
+        if(run.instructions && run.cycles){
+            result.instructions.push_back(*run.instructions);
+            result.cycles.push_back(*run.cycles);
+        }
+    }
+
+    //All the optimization levels must produce the output of the first one
+    auto kernel_output = read_output();
+
+    if(!reference){
+        reference = kernel_output;
+    } else if(*reference != kernel_output){
+        std::cout << kernel << " produces a different output with --" << platform << " --" << level << std::endl;
+        result.success = false;
+    }
+
+    return result;
+}
+
+bool has_counters(const configuration_result& result){
+    return !result.instructions.empty() && result.instructions.size() == result.times.size();
+}
+
+void report(const std::string& kernel, const std::string& platform, const std::string& level, const configuration_result& result){
+    std::cout << std::left << std::setw(20) << kernel << std::setw(5) << platform << std::setw(5) << level << std::right;
+
+    if(!result.success){
+        std::cout << std::setw(12) << "failed" << std::endl;
+        return;
+    }
+
+    std::cout << std::fixed << std::setprecision(2)
+        << std::setw(12) << result.size
+        << std::setw(12) << *std::min_element(result.times.begin(), result.times.end())
+        << std::setw(12) << median(result.times);
+
+    if(has_counters(result)){
+        std::cout << std::setw(16) << median(result.instructions) << std::setw(16) << median(result.cycles);
+    } else {
+        std::cout << std::setw(16) << "-" << std::setw(16) << "-";
+    }
+
+    std::cout << std::defaultfloat << std::endl;
+}
+
+std::string tree_key(const std::string& kernel, const std::string& platform, const std::string& level){
+    return kernel + "/" + platform + "/" + level;
+}
+
+void save_results(const std::string& file, const Results& results){
+    boost::property_tree::ptree tree;
+
+    for(auto& [kernel, platforms] : results){
+        for(auto& [platform, levels] : platforms){
+            for(auto& [level, result] : levels){
+                if(!result.success){
+                    continue;
+                }
+
+                auto key = tree_key(kernel, platform, level);
+
+                tree.put(bench::tree_path(key + "/size"), result.size);
+                tree.put(bench::tree_path(key + "/time_min"), *std::min_element(result.times.begin(), result.times.end()));
+                tree.put(bench::tree_path(key + "/time_median"), median(result.times));
+
+                if(has_counters(result)){
+                    tree.put(bench::tree_path(key + "/instructions"), median(result.instructions));
+                    tree.put(bench::tree_path(key + "/cycles"), median(result.cycles));
+                }
+            }
+        }
+    }
+
+    boost::property_tree::write_json(file, tree);
+
+    std::cout << "Results saved to " << file << std::endl;
+}
+
+void print_change(const std::string& name, double baseline, double current){
+    auto change = baseline > 0.0 ? (current - baseline) / baseline * 100.0 : 0.0;
+    std::cout << std::setw(14) << name << std::setw(9) << (change >= 0.0 ? "+" : "") + std::to_string(static_cast<int>(std::round(change))) + "%";
+}
+
+void compare_results(const std::string& file, const Results& results){
+    boost::property_tree::ptree tree;
+    boost::property_tree::read_json(file, tree);
+
+    std::cout << "Comparison against " << file << std::endl;
+
+    for(auto& [kernel, platforms] : results){
+        for(auto& [platform, levels] : platforms){
+            for(auto& [level, result] : levels){
+                auto key = tree_key(kernel, platform, level);
+                auto baseline = tree.get_child_optional(bench::tree_path(key));
+
+                if(!result.success || !baseline){
+                    continue;
+                }
+
+                std::cout << std::left << std::setw(20) << kernel << std::setw(5) << platform << std::setw(5) << level << std::right;
+
+                print_change("size", baseline->get<double>("size"), result.size);
+                print_change("time", baseline->get<double>("time_median"), median(result.times));
+
+                auto instructions = baseline->get_optional<double>("instructions");
+                if(instructions && has_counters(result)){
+                    print_change("instructions", *instructions, median(result.instructions));
+                }
+
+                std::cout << std::endl;
+            }
+        }
+    }
+}
+
+} //end of anonymous namespace
+
+int main(int argc, const char* argv[]){
+    bench_options options;
+
+    if(!parse_arguments(argc, argv, options)){
+        print_usage();
+        return 1;
+    }
+
+    auto kernels = bench_kernels(options);
+
+    if(kernels.empty()){
+        std::cout << "No kernels found, the benchmark must be run from the root of the repository" << std::endl;
+        return 1;
+    }
+
+    std::cout << std::left << std::setw(20) << "kernel" << std::setw(5) << "bits" << std::setw(5) << "opt" << std::right
+        << std::setw(12) << "size" << std::setw(12) << "min (ms)" << std::setw(12) << "median (ms)"
+        << std::setw(16) << "instructions" << std::setw(16) << "cycles" << std::endl;
+
+    Results results;
+    bool success = true;
+
+    for(auto& kernel : kernels){
+        for(auto& platform : options.platforms){
+            std::optional<std::string> reference;
+
+            for(auto& level : options.levels){
+                auto& result = results[kernel][platform][level];
+                result = bench_configuration(kernel, platform, level, options.runs, reference);
+
+                report(kernel, platform, level, result);
+
+                success &= result.success;
+            }
+        }
+    }
+
+    std::remove(executable.c_str());
+    std::remove(output.c_str());
+
+    if(!options.save.empty()){
+        save_results(options.save, results);
+    }
+
+    if(!options.baseline.empty()){
+        compare_results(options.baseline, results);
+    }
+
+    return success ? 0 : 1;
+}
@@ -5,79 +5,188 @@ mov ebp, esp
 push ebx
 push ecx
 push edx
-push edi
 push esi
+push edi
 
-;Add the size of the header
-add ecx, 8
+;The header of a block is its size, with the free flag (1) and the previous free flag (2)
+;The free small blocks are linked with the second word of their header
+;The free large blocks are linked with the first two words after the header and end with their size
 
-;ebx = start, edx = last
-mov eax, [V_mem_start]
-mov edx, [V_mem_last]
+;edx = size of the block with its header, rounded to 8 bytes
+lea edx, [ecx + 15]
+and edx, -8
 
-.start:
+cmp edx, 512
+ja .large
 
-;Check if we are at the end
-cmp eax, edx
-je .alloc
+;ecx = offset of the free list of the size class (size / 8 * 4)
+mov ecx, edx
+shr ecx, 1
 
-;edi = availability of the block
-;esi = size of the block
-mov edi, [eax]
-mov esi, [eax + 4]
-cmp edi, 1
-jne .move
+mov eax, [V_mem_bins + ecx + 4]
+cmp eax, 0
+je .bump
 
-cmp esi, ecx
-jl .move
+;Pop the first block of the size class
+mov ebx, [eax + 4]
+mov [V_mem_bins + ecx + 4], ebx
 
-;The block is available and of the good size
-;The block is of the good size
+jmp .found
 
-;make it unavailable
-mov dword [eax], 0
+.large:
 
-;The pointer is past the header
-add eax, 8
+;First fit in the free list of the large blocks
+mov eax, [V_mem_large]
 
-pop esi
-pop edi
-pop edx
-pop ecx
-pop ebx
+.next:
 
-leave
-ret
+cmp eax, 0
+je .bump
 
-.move:
+;ebx = size of the block
+mov ebx, [eax]
+and ebx, -8
+cmp ebx, edx
+jae .take
 
-;switch to the next block
-add eax, esi
+mov eax, [eax + 8]
+jmp .next
 
-jmp .start
+.take:
 
-.alloc:
+;Unlink the block, ecx = next, esi = previous
+mov ecx, [eax + 8]
+mov esi, [eax + 12]
 
-mov edi, eax
+cmp esi, 0
+je .unlink_head
 
-;alloc new block of the good size
-lea ebx, [eax + ecx]
-mov eax, 45
-int 80h
+mov [esi + 8], ecx
+jmp .unlink_next
 
-mov [V_mem_last], ebx
+.unlink_head:
 
-mov dword [edi], 0
-mov dword [edi + 4], ecx
+mov [V_mem_large], ecx
 
-;the pointer is past the header
-lea eax, [edi + 8]
+.unlink_next:
+
+cmp ecx, 0
+je .split
+
+mov [ecx + 12], esi
+
+.split:
+
+;esi = size of the remainder, only split when it is a large block
+mov esi, ebx
+sub esi, edx
+cmp esi, 520
+jb .whole
+
+mov [eax], edx
+
+;The remainder is a free block, its next block is already marked
+lea edi, [eax + edx]
+lea ecx, [esi + 1]
+mov [edi], ecx
+mov [edi + esi - 4], esi
+
+mov ecx, [V_mem_large]
+mov [edi + 8], ecx
+mov dword [edi + 12], 0
+
+cmp ecx, 0
+je .split_head
+
+mov [ecx + 12], edi
+
+.split_head:
+
+mov [V_mem_large], edi
+
+jmp .found
+
+.whole:
+
+;The whole block is used, the next block has no more a free previous block
+mov [eax], ebx
+and dword [eax + ebx], -3
+
+jmp .found
+
+.bump:
+
+;Allocate the block at the top of the current chunk
+mov eax, [V_mem_top]
+lea ebx, [eax + edx]
+cmp ebx, [V_mem_end]
+ja .chunk
+
+.bumped:
+
+mov [V_mem_top], ebx
+
+;The top of the chunk is always marked by an empty used header
+mov [eax], edx
+mov dword [ebx], 0
+
+jmp .found
+
+.chunk:
+
+;The very large blocks get their own mapping, rounded to pages
+cmp edx, 65536
+jae .dedicated
+
+;Map a new chunk, the end of the current one is lost
+mov ecx, 1048576
+call .map
+
+mov [V_mem_top], eax
+lea ebx, [eax + 1048568]
+mov [V_mem_end], ebx
+
+lea ebx, [eax + edx]
+jmp .bumped
+
+.dedicated:
+
+lea ecx, [edx + 4103]
+and ecx, -4096
+call .map
+
+mov [eax], edx
+mov dword [eax + edx], 0
+
+.found:
+
+;The pointer is past the header
+add eax, 8
 
-pop esi
 pop edi
+pop esi
 pop edx
 pop ecx
 pop ebx
 
 leave
 ret
+
+.map:
+
+;mmap2(0, ecx, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)
+push ebx
+push edx
+push ebp
+xor ebx, ebx
+mov edx, 3
+mov esi, 34
+mov edi, -1
+xor ebp, ebp
+mov eax, 192
+int 80h
+pop ebp
+pop edx
+pop ebx
+
+ret
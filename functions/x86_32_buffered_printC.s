@@ -0,0 +1,25 @@
+_F5printC:
+push ebp
+mov ebp, esp
+
+push eax
+
+;Flush the buffer if it is full
+mov eax, [V_out_size]
+cmp eax, 4096
+jb .store
+
+call _F5flush
+xor eax, eax
+
+.store:
+
+;Append the char to the buffer
+mov [V_out_buffer + eax + 4], cl
+inc eax
+mov [V_out_size], eax
+
+pop eax
+
+leave
+ret
@@ -0,0 +1,58 @@
+_F5printS:
+push ebp
+mov ebp, esp
+
+push eax
+push ebx
+push ecx
+push edx
+push esi
+push edi
+
+mov esi, [ebp + 8]
+mov edx, [ebp + 12]
+
+;The strings larger than the buffer are written directly
+cmp edx, 4096
+jae .direct
+
+;Flush the buffer if the string does not fit
+mov eax, [V_out_size]
+add eax, edx
+cmp eax, 4096
+jbe .copy
+
+call _F5flush
+
+.copy:
+
+;Append the string to the buffer
+mov eax, [V_out_size]
+lea edi, [V_out_buffer + eax + 4]
+add eax, edx
+mov [V_out_size], eax
+mov ecx, edx
+rep movsb
+
+jmp .end
+
+.direct:
+
+call _F5flush
+
+mov eax, 4
+mov ebx, 1
+mov ecx, esi
+int 80h
+
+.end:
+
+pop edi
+pop esi
+pop edx
+pop ecx
+pop ebx
+pop eax
+
+leave
+ret
@@ -0,0 +1,30 @@
+_F5flush:
+push ebp
+mov ebp, esp
+
+push eax
+push ebx
+push ecx
+push edx
+
+;Write the buffered output, if any
+mov edx, [V_out_size]
+cmp edx, 0
+je .end
+
+mov eax, 4
+mov ebx, 1
+lea ecx, [V_out_buffer + 4]
+int 80h
+
+mov dword [V_out_size], 0
+
+.end:
+
+pop edx
+pop ecx
+pop ebx
+pop eax
+
+leave
+ret
@@ -2,8 +2,132 @@ _F4freePI:
 push ebp
 mov ebp, esp
 
-;block->available = 1
-mov dword [ecx - 8], 1
+push eax
+push ebx
+push ecx
+push edx
+push esi
+push edi
+
+;eax = header of the block, ebx = size of the block
+lea eax, [ecx - 8]
+mov ebx, [eax]
+and ebx, -8
+
+cmp ebx, 512
+ja .large
+
+;Push the block on the free list of its size class
+shr ebx, 1
+mov ecx, [V_mem_bins + ebx + 4]
+mov [eax + 4], ecx
+mov [V_mem_bins + ebx + 4], eax
+
+jmp .end
+
+.large:
+
+;Merge with the next block if it is free
+lea esi, [eax + ebx]
+mov ecx, [esi]
+bt ecx, 0
+jnc .previous
+
+and ecx, -8
+add ebx, ecx
+
+mov edx, [esi + 8]
+mov edi, [esi + 12]
+
+cmp edi, 0
+je .next_head
+
+mov [edi + 8], edx
+jmp .next_unlinked
+
+.next_head:
+
+mov [V_mem_large], edx
+
+.next_unlinked:
+
+cmp edx, 0
+je .previous
+
+mov [edx + 12], edi
+
+.previous:
+
+;Merge with the previous block if it is free, its size is at its end
+mov ecx, [eax]
+bt ecx, 1
+jnc .merged
+
+mov ecx, [eax - 4]
+sub eax, ecx
+add ebx, ecx
+
+mov edx, [eax + 8]
+mov edi, [eax + 12]
+
+cmp edi, 0
+je .previous_head
+
+mov [edi + 8], edx
+jmp .previous_unlinked
+
+.previous_head:
+
+mov [V_mem_large], edx
+
+.previous_unlinked:
+
+cmp edx, 0
+je .merged
+
+mov [edx + 12], edi
+
+.merged:
+
+;Give the block back to the top of the chunk if it is the last one
+lea esi, [eax + ebx]
+cmp esi, [V_mem_top]
+jne .insert
+
+mov [V_mem_top], eax
+mov dword [eax], 0
+
+jmp .end
+
+.insert:
+
+;Mark the block free and push it on the free list of the large blocks
+lea ecx, [ebx + 1]
+mov [eax], ecx
+mov [eax + ebx - 4], ebx
+or dword [esi], 2
+
+mov ecx, [V_mem_large]
+mov [eax + 8], ecx
+mov dword [eax + 12], 0
+
+cmp ecx, 0
+je .insert_head
+
+mov [ecx + 12], eax
+
+.insert_head:
+
+mov [V_mem_large], eax
+
+.end:
+
+pop edi
+pop esi
+pop edx
+pop ecx
+pop ebx
+pop eax
 
 leave
 ret
@@ -2,13 +2,22 @@ _F4init:
 push ebp
 mov ebp, esp
 
-; get start of system brk
+; map the first chunk of the heap with mmap2
 xor ebx, ebx
-mov eax, 45
+mov ecx, 1048576
+mov edx, 3
+mov esi, 34
+mov edi, -1
+push ebp
+xor ebp, ebp
+mov eax, 192
 int 80h
+pop ebp
 
-mov [V_mem_start], eax
-mov [V_mem_last], eax
+; the end keeps room for the header marking the top
+mov [V_mem_top], eax
+lea eax, [eax + 1048568]
+mov [V_mem_end], eax
 
 leave
 ret
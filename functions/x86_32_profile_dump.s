@@ -0,0 +1,31 @@
+_F12profile_dump:
+push ebp
+mov ebp, esp
+
+;Create the profile file (O_WRONLY | O_CREAT | O_TRUNC, 0644)
+mov eax, 5
+mov ebx, V__profile_file
+mov ecx, 577
+mov edx, 420
+int 80h
+
+;The profile is lost if the file cannot be created
+cmp eax, 0
+js .done
+
+;Write the counters preceded by their number
+mov ebx, eax
+mov edx, [V__profile_counters]
+inc edx
+shl edx, 2
+mov eax, 4
+lea ecx, [V__profile_counters]
+int 80h
+
+;Close the profile file
+mov eax, 6
+int 80h
+
+.done:
+leave
+ret
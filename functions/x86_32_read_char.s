@@ -3,6 +3,9 @@ push ebp
 mov ebp, esp
 sub esp, 4
 
+;The pending output is written before waiting for the input
+call _F5flush
+
 push ebx
 push ecx
 push edx
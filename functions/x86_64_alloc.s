@@ -2,83 +2,195 @@ _F5allocI:
 push rbp
 mov rbp, rsp
 
+push rbx
+push rcx
+push rdx
+push rsi
 push rdi
+push r8
+push r9
 push r10
 push r11
-push r12
-push r13
-push r14
 
-;Add the size of the header
-add r14, 16
+;The header of a block is its size, with the free flag (1) and the previous free flag (2)
+;The free small blocks are linked with the second word of their header
+;The free large blocks are linked with the first two words after the header and end with their size
 
-;r12 = start, r13 = last
-mov r12, [V_mem_start]
-mov r13, [V_mem_last]
+;r11 = size of the block with its header, rounded to 16 bytes
+lea r11, [r14 + 31]
+and r11, -16
 
-.start:
+cmp r11, 1024
+ja .large
 
-;Check if we are at the end
-cmp r12, r13
-je .alloc
+;r10 = offset of the free list of the size class (size / 16 * 8)
+mov r10, r11
+shr r10, 1
 
-;r10 = availability of the block
-;r11 = size of the block
-mov r10, [r12]
-mov r11, [r12 + 8]
-cmp r10, 1
-jne .move
+mov rax, [V_mem_bins + r10 + 8]
+cmp rax, 0
+je .bump
 
-cmp r11, r14
-jl .move
+;Pop the first block of the size class
+mov rbx, [rax + 8]
+mov [V_mem_bins + r10 + 8], rbx
 
-;The block is available and of the good size
-;The block is of the good size
+jmp .found
 
-;make it unavailable
-mov qword [r12], 0
+.large:
 
-;The pointer is past the header
-lea rax, [r12 + 16]
+;First fit in the free list of the large blocks
+mov rax, [V_mem_large]
 
-pop r14
-pop r13
-pop r12
-pop r11
-pop r10
-pop rdi
+.next:
 
-leave
-ret
+cmp rax, 0
+je .bump
 
-.move:
+;rbx = size of the block
+mov rbx, [rax]
+and rbx, -16
+cmp rbx, r11
+jae .take
 
-;switch to the next block
-add r12, r11
+mov rax, [rax + 16]
+jmp .next
 
-jmp .start
+.take:
 
-.alloc:
+;Unlink the block, rcx = next, rdx = previous
+mov rcx, [rax + 16]
+mov rdx, [rax + 24]
 
-;alloc new block of the good size
-lea rdi, [r12 + r14]
-mov rax, 12
-syscall
+cmp rdx, 0
+je .unlink_head
+
+mov [rdx + 16], rcx
+jmp .unlink_next
+
+.unlink_head:
+
+mov [V_mem_large], rcx
+
+.unlink_next:
+
+cmp rcx, 0
+je .split
+
+mov [rcx + 24], rdx
+
+.split:
+
+;rdx = size of the remainder, only split when it is a large block
+mov rdx, rbx
+sub rdx, r11
+cmp rdx, 1040
+jb .whole
+
+mov [rax], r11
+
+;The remainder is a free block, its next block is already marked
+lea rsi, [rax + r11]
+lea rcx, [rdx + 1]
+mov [rsi], rcx
+mov [rsi + rdx - 8], rdx
+
+mov rcx, [V_mem_large]
+mov [rsi + 16], rcx
+mov qword [rsi + 24], 0
+
+cmp rcx, 0
+je .split_head
+
+mov [rcx + 24], rsi
+
+.split_head:
+
+mov [V_mem_large], rsi
+
+jmp .found
+
+.whole:
 
-mov [V_mem_last], rdi
+;The whole block is used, the next block has no more a free previous block
+mov [rax], rbx
+and qword [rax + rbx], -3
 
-mov qword [r12], 0
-mov qword [r12 + 8], r14
+jmp .found
 
-;the pointer is past the header
-lea rax, [r12 + 16]
+.bump:
+
+;Allocate the block at the top of the current chunk
+mov rax, [V_mem_top]
+lea rbx, [rax + r11]
+cmp rbx, [V_mem_end]
+ja .chunk
+
+.bumped:
+
+mov [V_mem_top], rbx
+
+;The top of the chunk is always marked by an empty used header
+mov [rax], r11
+mov qword [rbx], 0
+
+jmp .found
+
+.chunk:
+
+;The very large blocks get their own mapping, rounded to pages
+cmp r11, 65536
+jae .dedicated
+
+;Map a new chunk, the end of the current one is lost
+mov rsi, 1048576
+call .map
+
+mov [V_mem_top], rax
+lea rbx, [rax + 1048560]
+mov [V_mem_end], rbx
+
+lea rbx, [rax + r11]
+jmp .bumped
+
+.dedicated:
+
+lea rsi, [r11 + 4111]
+and rsi, -4096
+call .map
+
+mov [rax], r11
+mov qword [rax + r11], 0
+
+.found:
+
+;The pointer is past the header
+lea rax, [rax + 16]
 
-pop r14
-pop r13
-pop r12
 pop r11
 pop r10
+pop r9
+pop r8
 pop rdi
+pop rsi
+pop rdx
+pop rcx
+pop rbx
 
 leave
 ret
+
+.map:
+
+;mmap(0, rsi, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)
+push r11
+xor rdi, rdi
+mov rdx, 3
+mov r10, 34
+mov r8, -1
+xor r9, r9
+mov rax, 9
+syscall
+pop r11
+
+ret
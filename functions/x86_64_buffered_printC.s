@@ -0,0 +1,25 @@
+_F5printC:
+push rbp
+mov rbp, rsp
+
+push rax
+
+;Flush the buffer if it is full
+mov rax, [V_out_size]
+cmp rax, 4096
+jb .store
+
+call _F5flush
+xor rax, rax
+
+.store:
+
+;Append the char to the buffer
+mov [V_out_buffer + rax + 8], r14b
+inc rax
+mov [V_out_size], rax
+
+pop rax
+
+leave
+ret
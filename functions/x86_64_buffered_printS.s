@@ -0,0 +1,57 @@
+_F5printS:
+push rbp
+mov rbp, rsp
+
+push rax
+push rcx
+push rdi
+push rsi
+push rdx
+push r11
+
+mov rsi, [rbp + 16]
+mov rdx, [rbp + 24]
+
+;The strings larger than the buffer are written directly
+cmp rdx, 4096
+jae .direct
+
+;Flush the buffer if the string does not fit
+mov rax, [V_out_size]
+add rax, rdx
+cmp rax, 4096
+jbe .copy
+
+call _F5flush
+
+.copy:
+
+;Append the string to the buffer
+mov rax, [V_out_size]
+lea rdi, [V_out_buffer + rax + 8]
+add rax, rdx
+mov [V_out_size], rax
+mov rcx, rdx
+rep movsb
+
+jmp .end
+
+.direct:
+
+call _F5flush
+
+mov rax, 1
+mov rdi, 1
+syscall
+
+.end:
+
+pop r11
+pop rdx
+pop rsi
+pop rdi
+pop rcx
+pop rax
+
+leave
+ret
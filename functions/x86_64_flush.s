@@ -0,0 +1,34 @@
+_F5flush:
+push rbp
+mov rbp, rsp
+
+push rax
+push rcx
+push rdi
+push rsi
+push rdx
+push r11
+
+;Write the buffered output, if any
+mov rdx, [V_out_size]
+cmp rdx, 0
+je .end
+
+mov rax, 1
+mov rdi, 1
+lea rsi, [V_out_buffer + 8]
+syscall
+
+mov qword [V_out_size], 0
+
+.end:
+
+pop r11
+pop rdx
+pop rsi
+pop rdi
+pop rcx
+pop rax
+
+leave
+ret
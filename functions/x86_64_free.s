@@ -2,8 +2,132 @@ _F4freePI:
 push rbp
 mov rbp, rsp
 
-;block->available = 1
-mov qword [r14 - 16], 1
+push rax
+push rbx
+push rcx
+push rdx
+push rsi
+push rdi
+
+;rax = header of the block, rbx = size of the block
+lea rax, [r14 - 16]
+mov rbx, [rax]
+and rbx, -16
+
+cmp rbx, 1024
+ja .large
+
+;Push the block on the free list of its size class
+shr rbx, 1
+mov rcx, [V_mem_bins + rbx + 8]
+mov [rax + 8], rcx
+mov [V_mem_bins + rbx + 8], rax
+
+jmp .end
+
+.large:
+
+;Merge with the next block if it is free
+lea rsi, [rax + rbx]
+mov rcx, [rsi]
+bt rcx, 0
+jnc .previous
+
+and rcx, -16
+add rbx, rcx
+
+mov rdx, [rsi + 16]
+mov rdi, [rsi + 24]
+
+cmp rdi, 0
+je .next_head
+
+mov [rdi + 16], rdx
+jmp .next_unlinked
+
+.next_head:
+
+mov [V_mem_large], rdx
+
+.next_unlinked:
+
+cmp rdx, 0
+je .previous
+
+mov [rdx + 24], rdi
+
+.previous:
+
+;Merge with the previous block if it is free, its size is at its end
+mov rcx, [rax]
+bt rcx, 1
+jnc .merged
+
+mov rcx, [rax - 8]
+sub rax, rcx
+add rbx, rcx
+
+mov rdx, [rax + 16]
+mov rdi, [rax + 24]
+
+cmp rdi, 0
+je .previous_head
+
+mov [rdi + 16], rdx
+jmp .previous_unlinked
+
+.previous_head:
+
+mov [V_mem_large], rdx
+
+.previous_unlinked:
+
+cmp rdx, 0
+je .merged
+
+mov [rdx + 24], rdi
+
+.merged:
+
+;Give the block back to the top of the chunk if it is the last one
+lea rsi, [rax + rbx]
+cmp rsi, [V_mem_top]
+jne .insert
+
+mov [V_mem_top], rax
+mov qword [rax], 0
+
+jmp .end
+
+.insert:
+
+;Mark the block free and push it on the free list of the large blocks
+lea rcx, [rbx + 1]
+mov [rax], rcx
+mov [rax + rbx - 8], rbx
+or qword [rsi], 2
+
+mov rcx, [V_mem_large]
+mov [rax + 16], rcx
+mov qword [rax + 24], 0
+
+cmp rcx, 0
+je .insert_head
+
+mov [rcx + 24], rax
+
+.insert_head:
+
+mov [V_mem_large], rax
+
+.end:
+
+pop rdi
+pop rsi
+pop rdx
+pop rcx
+pop rbx
+pop rax
 
 leave
 ret
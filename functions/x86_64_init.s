@@ -2,13 +2,20 @@ _F4init:
 push rbp
 mov rbp, rsp
 
-; get start of system brk
-mov rax, 12
+; map the first chunk of the heap
 xor rdi, rdi
+mov rsi, 1048576
+mov rdx, 3
+mov r10, 34
+mov r8, -1
+xor r9, r9
+mov rax, 9
 syscall
 
-mov [V_mem_start], rax
-mov [V_mem_last], rax
+; the end keeps room for the header marking the top
+mov [V_mem_top], rax
+lea rax, [rax + 1048560]
+mov [V_mem_end], rax
 
 leave
 ret
@@ -0,0 +1,31 @@
+_F12profile_dump:
+push rbp
+mov rbp, rsp
+
+;Create the profile file (O_WRONLY | O_CREAT | O_TRUNC, 0644)
+mov rax, 2
+mov rdi, V__profile_file
+mov rsi, 577
+mov rdx, 420
+syscall
+
+;The profile is lost if the file cannot be created
+cmp rax, 0
+js .done
+
+;Write the counters preceded by their number
+mov rdi, rax
+mov rdx, [V__profile_counters]
+inc rdx
+shl rdx, 3
+mov rax, 1
+lea rsi, [V__profile_counters]
+syscall
+
+;Close the profile file
+mov rax, 3
+syscall
+
+.done:
+leave
+ret
@@ -3,6 +3,9 @@ push rbp
 mov rbp, rsp
 sub rsp, 8
 
+;The pending output is written before waiting for the input
+call _F5flush
+
 push rcx
 push rdi
 push rsi
@@ -9,6 +9,7 @@
 #define ASSEMBLER_H
 
 #include <string>
+#include <string_view>
 
 #include "Platform.hpp"
 
@@ -23,6 +24,15 @@ namespace eddic {
  */
 void assemble(Platform platform, const std::string& s, const std::string& o, const std::string& output, bool debug, bool verbose);
 
+/*!
+ * \brief Assemble and link the assembly code in memory with the integrated assembler, without running any process.
+ * \param platform The target platform.
+ * \param assembly The assembly code.
+ * \param output The output file path.
+ * \param verbose The verbose mode flag.
+ */
+void assemble_integrated(Platform platform, std::string_view assembly, const std::string& output, bool verbose);
+
 void verify_dependencies();
 
 } //end of eddic
@@ -8,38 +8,80 @@
 #ifndef ASSEMBLY_FILE_WRITER_H
 #define ASSEMBLY_FILE_WRITER_H
 
-#include <fstream>
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <type_traits>
 
 namespace eddic {
 
 /*!
  * \class AssemblyFileWriter
- * \brief A simple writer to append assembly code to the assembly output file. 
- * This class give access to its internal buffer that is only outputted to the file 
- * when the write() function is called. 
+ * \brief A simple writer to append assembly code to an in-memory buffer.
+ *
+ * The values are appended directly to the buffer, without any formatting state. The
+ * buffer is only outputted to a file when the write() function is called, otherwise it
+ * can be given directly to the assembler.
  */
 class AssemblyFileWriter {
     private:
-        std::ofstream m_stream;
-	
+        std::string m_buffer;
+
     public:
-    	/*!
-    	 * Construct an AssemblyFileWriter that will output on the given path. 
-    	 * \param path The path to the file. 
-    	 */
-        AssemblyFileWriter(const std::string& path);
-        
         /*!
-         * Close the file stream. 
+         * Construct an empty AssemblyFileWriter.
+         */
+        AssemblyFileWriter();
+
+        AssemblyFileWriter& operator<<(std::string_view value){
+            m_buffer.append(value);
+            return *this;
+        }
+
+        AssemblyFileWriter& operator<<(const std::string& value){
+            m_buffer.append(value);
+            return *this;
+        }
+
+        AssemblyFileWriter& operator<<(const char* value){
+            m_buffer.append(value);
+            return *this;
+        }
+
+        AssemblyFileWriter& operator<<(char value){
+            m_buffer.push_back(value);
+            return *this;
+        }
+
+        AssemblyFileWriter& operator<<(bool value){
+            m_buffer.push_back(value ? '1' : '0');
+            return *this;
+        }
+
+        /*!
+         * \brief Append the given floating point value in fixed notation, with six decimals.
          */
-        ~AssemblyFileWriter();
-        
+        AssemblyFileWriter& operator<<(double value);
+
+        template<typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+        AssemblyFileWriter& operator<<(T value){
+            char buffer[24];
+            auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+            m_buffer.append(buffer, result.ptr);
+            return *this;
+        }
+
+        /*!
+         * \brief Return the assembly code appended so far.
+         * \return A view of the internal buffer.
+         */
+        std::string_view buffer() const;
+
         /*!
-         * \brief Return the enclosing stream. 
-         * This method should be used to output assembly instruction to the file. 
-         * \return A reference to the enclosing stream. 
+         * \brief Output the assembly code to the given file.
+         * \param path The path to the file.
          */
-        std::ostream& stream();
+        void write(const std::string& path) const;
 };
 
 } //end of eddic
@@ -54,6 +54,12 @@ struct Compiler {
 
     void setup_context(Platform platform);
 
+    /*!
+     * Return the global context of the last compilation, with its timings and statistics. 
+     * \return The global context of the last compilation. 
+     */
+    GlobalContext& global_context();
+
 private:
     std::unique_ptr<GlobalContext> context;
 };
@@ -8,7 +8,10 @@
 #ifndef GLOBAL_CONTEXT_H
 #define GLOBAL_CONTEXT_H
 
+#include <deque>
+#include <iosfwd>
 #include <map>
+#include <mutex>
 
 #include "Context.hpp"
 #include "Function.hpp"
@@ -16,6 +19,8 @@
 #include "Platform.hpp"
 #include "statistics.hpp"
 #include "timing.hpp"
+#include "mapped_file.hpp"
+#include "variable_ref.hpp"
 
 #include "parser_x3/error_handling.hpp"
 
@@ -106,6 +111,37 @@ struct GlobalContext final : Context {
      */
     bool struct_exists(std::shared_ptr<const Type> type) const;
 
+    /*!
+     * Returns the layout of the given structure. The layout must have been computed with
+     * compute_layout once the members of the structure were collected. The lookup does not lock, it
+     * can be done concurrently by the optimization workers.
+     * \param struct_ The structure.
+     * \return The layout of the structure.
+     */
+    const StructLayout & layout(std::shared_ptr<const Struct> struct_) const;
+
+    /*!
+     * Compute the layout of the given structure, once all its members are known. The layout is only
+     * recomputed if members have been added to the structure since then. This must not be called
+     * while the layouts are read by several threads.
+     * \param struct_ The structure.
+     * \return The layout of the structure.
+     */
+    const StructLayout & compute_layout(std::shared_ptr<const Struct> struct_) const;
+
+    /*!
+     * Returns the natural alignment of a value of the given type.
+     * \param type The type.
+     * \return The alignment, in bytes.
+     */
+    int alignment_of(std::shared_ptr<const Type> type) const;
+
+    /*!
+     * Print the layout of all the structures.
+     * \param out The stream to print to.
+     */
+    void print_struct_layouts(std::ostream & out) const;
+
     std::shared_ptr<const Type> member_type(std::shared_ptr<const Struct> struct_, int offset) const;
     int                         member_offset(std::shared_ptr<const Struct> struct_, const std::string & member) const;
 
@@ -113,8 +149,14 @@ struct GlobalContext final : Context {
     int  total_size_of_struct(std::shared_ptr<const Struct> struct_) const;
     bool is_recursively_nested(std::shared_ptr<const Struct> struct_) const;
 
+    /*!
+     * Register and map a new source file. This can be called concurrently by several parsers, the
+     * references returned by get_file_content and get_file_name stay valid.
+     * \param file_name The path to the file.
+     * \return The index of the new file.
+     */
     std::size_t         new_file(const std::string & file_name);
-    std::string &       get_file_content(std::size_t file);
+    const mapped_file & get_file_content(std::size_t file);
     const std::string & get_file_name(std::size_t file);
 
     const FunctionMap & functions() const;
@@ -124,7 +166,16 @@ struct GlobalContext final : Context {
     statistics &    stats();
     timing_system & timing();
 
+    /*!
+     * Return the table of all the variables of the compilation. It must be made current with a
+     * variable_table::scope while the intermediate representation is used.
+     */
+    variable_table & variables_table();
+
 private:
+    //All the variables of the compilation, referenced by the intermediate representation
+    variable_table m_variables;
+
     FunctionMap   m_functions;
     StructMap     m_structs;
     statistics    m_statistics;
@@ -133,8 +184,13 @@ private:
 
     std::vector<std::shared_ptr<FunctionContext>> function_contexts; // TODO: We can probably avoid the shared_ptr
 
-    std::vector<std::string> file_names;
-    std::vector<std::string> file_contents;
+    //The layouts are computed during the collection of the types and only read afterwards
+    mutable std::unordered_map<const Struct *, StructLayout> layouts;
+    mutable std::recursive_mutex                            layouts_mutex;
+
+    std::deque<std::string> file_names;
+    std::deque<mapped_file> file_contents;
+    std::mutex              files_mutex;
 
     void addPrintFunction(const std::string & function, std::shared_ptr<const Type> parameterType);
     void defineStandardFunctions();
@@ -18,13 +18,14 @@ namespace eddic {
  * \struct StringPool
  * \brief The string pool of the program. 
  * All the strings are stored and referred only by an index.  
+ * The pool can be safely accessed by several threads. 
  */
 struct StringPool {
     private:
         std::unordered_map<std::string, std::string> pool;
         unsigned int currentString;
 
-//        mutable std::mutex mutex;
+        mutable std::mutex mutex;
 
     public:
         StringPool();
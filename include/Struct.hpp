@@ -10,6 +10,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace eddic {
@@ -93,6 +94,23 @@ struct Struct {
         unsigned int references = 0;
 };
 
+/*!
+ * \class StructLayout
+ * \brief The memory layout of a structure.
+ *
+ * The members are naturally aligned. The layout of a structure starts with its own members, followed
+ * by the layout of its parent.
+ */
+struct StructLayout {
+    std::size_t members = 0;    /*!< The number of members the layout has been computed for */
+    int self_size = 0;          /*!< The size of the own members, padded so that the parent is aligned */
+    int total_size = 0;         /*!< The size of the structure with its parents, padded to the alignment */
+    int alignment = 1;          /*!< The alignment of the structure with its parents */
+
+    std::unordered_map<std::string, int> offsets;                         /*!< The offset of each own member */
+    std::vector<std::pair<int, std::shared_ptr<const Type>>> by_offset;  /*!< The own members sorted by offset */
+};
+
 } //end of eddic
 
 #endif
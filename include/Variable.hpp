@@ -8,6 +8,7 @@
 #ifndef VARIABLE_H
 #define VARIABLE_H
 
+#include <cstdint>
 #include <utility>
 #include <string>
 #include <memory>
@@ -15,6 +16,7 @@
 
 #include "variant.hpp"
 #include "Position.hpp"
+#include "variable_ref.hpp"
 
 #include "parser_x3/error_handling.hpp"
 
@@ -33,6 +35,7 @@ using Offset = boost::variant<int, std::shared_ptr<Variable>>;
 class Variable {
     private:
         std::size_t m_references = 0;
+        uint32_t m_id = 0;
 
         const std::string m_name;
         std::shared_ptr<const Type> m_type;
@@ -56,6 +59,12 @@ class Variable {
         std::size_t references() const;
         void add_reference();
 
+        /*!
+         * Return the id of the variable in the variable table, 0 if it has not been added to it.
+         */
+        uint32_t id() const;
+        void set_id(uint32_t id);
+
         std::string name() const ;
         std::shared_ptr<const Type> type() const ;
         Position position() const ;
@@ -72,6 +81,16 @@ class Variable {
         Offset reference_offset() const;
 };
 
+/*!
+ * Create a new variable and add it to the variable table of the current compilation.
+ */
+template<typename... Args>
+std::shared_ptr<Variable> make_variable(Args&&... args){
+    auto variable = std::make_shared<Variable>(std::forward<Args>(args)...);
+    variable_table::current().add(variable);
+    return variable;
+}
+
 std::ostream& operator<<(std::ostream& stream, const Variable& variable);
 std::ostream& operator<<(std::ostream& stream, const std::shared_ptr<Variable>& variable);
 
@@ -15,6 +15,7 @@
 namespace eddic {
 
 struct GlobalContext;
+struct Configuration;
 
 namespace as {
 
@@ -27,9 +28,10 @@ struct CodeGeneratorFactory {
      * Create a code generator for the givne platform. 
      * \param platform The target platform. 
      * \param writer The assembly file writer to use. 
+     * \param configuration The configuration of the compilation.
      * \return A pointer to the code generator corresponding to the platform. 
      */
-    std::unique_ptr<CodeGenerator> get(Platform platform, AssemblyFileWriter& writer, mtac::Program& program, GlobalContext & context);
+    std::unique_ptr<CodeGenerator> get(Platform platform, AssemblyFileWriter& writer, mtac::Program& program, GlobalContext & context, std::shared_ptr<Configuration> configuration);
 };
 
 } //end of as
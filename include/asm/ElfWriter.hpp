@@ -0,0 +1,37 @@
+//=======================================================================
+// Copyright Baptiste Wicht 2011-2016.
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#ifndef ASM_ELF_WRITER_H
+#define ASM_ELF_WRITER_H
+
+#include <string>
+
+#include "Platform.hpp"
+
+namespace eddic {
+
+namespace as {
+
+struct ObjectCode;
+
+/*!
+ * \brief Resolve the symbols of the object code and write it as a static ELF executable.
+ *
+ * The text and the data are loaded in two segments, the entry point is the _start symbol.
+ * \param platform The target platform.
+ * \param object The object code to link.
+ * \param path The path to the executable.
+ * \param error The error message, set when the executable cannot be written.
+ * \return true if the executable has been written, false otherwise.
+ */
+bool write_elf(Platform platform, ObjectCode& object, const std::string& path, std::string& error);
+
+} //end of as
+
+} //end of eddic
+
+#endif
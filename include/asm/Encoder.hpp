@@ -0,0 +1,91 @@
+//=======================================================================
+// Copyright Baptiste Wicht 2011-2016.
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#ifndef ASM_ENCODER_H
+#define ASM_ENCODER_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Platform.hpp"
+
+namespace eddic {
+
+namespace as {
+
+/*!
+ * \enum Section
+ * \brief A section of the object code.
+ */
+enum class Section : unsigned int {
+    TEXT,
+    DATA
+};
+
+/*!
+ * \enum FixupKind
+ * \brief The way a symbol is written into an encoded field.
+ */
+enum class FixupKind : unsigned int {
+    ABSOLUTE_32,    /**< The 32-bit address of the symbol */
+    ABSOLUTE_64,    /**< The 64-bit address of the symbol */
+    RELATIVE_32     /**< The 32-bit distance from the end of the field to the symbol */
+};
+
+/*!
+ * \struct Symbol
+ * \brief The position of a label in the object code.
+ */
+struct Symbol {
+    Section section;
+    std::size_t offset;
+};
+
+/*!
+ * \struct Fixup
+ * \brief A field of the object code that depends on the address of a symbol.
+ */
+struct Fixup {
+    Section section;
+    std::size_t offset;
+    std::string symbol;
+    int64_t addend;
+    FixupKind kind;
+};
+
+/*!
+ * \struct ObjectCode
+ * \brief The machine code and the data of a program, before the symbols are resolved.
+ */
+struct ObjectCode {
+    std::vector<uint8_t> text;
+    std::vector<uint8_t> data;
+    std::unordered_map<std::string, Symbol> symbols;
+    std::vector<Fixup> fixups;
+};
+
+/*!
+ * \brief Encode the assembly produced by the code generators into machine code.
+ *
+ * Only the subset of the NASM syntax used by the code generators and by the
+ * runtime functions is supported.
+ * \param platform The target platform.
+ * \param assembly The assembly code.
+ * \param object The object code to fill.
+ * \param error The error message, set when the assembly cannot be encoded.
+ * \return true if the assembly has been encoded, false otherwise.
+ */
+bool encode(Platform platform, std::string_view assembly, ObjectCode& object, std::string& error);
+
+} //end of as
+
+} //end of eddic
+
+#endif
@@ -18,6 +18,7 @@ namespace eddic {
 
 class AssemblyFileWriter;
 struct GlobalContext;
+struct Configuration;
 class Function;
 
 namespace as {
@@ -28,12 +29,13 @@ namespace as {
  */
 class IntelCodeGenerator : public CodeGenerator {
     public:
-        IntelCodeGenerator(AssemblyFileWriter& writer, mtac::Program& program, GlobalContext & context);
+        IntelCodeGenerator(AssemblyFileWriter& writer, mtac::Program& program, GlobalContext & context, std::shared_ptr<Configuration> configuration);
         
         void generate(StringPool& pool, FloatPool& float_pool) override;
 
     protected:
         GlobalContext & context;
+        std::shared_ptr<Configuration> configuration;
 
         void addGlobalVariables(StringPool& pool, FloatPool& float_pool);
         
@@ -55,6 +57,19 @@ class IntelCodeGenerator : public CodeGenerator {
         virtual void declareFloat(const std::string& label, double value) = 0;
 
         void output_function(const std::string& function);
+
+        /*!
+         * \brief Indicates if the program uses the output buffer of the print functions.
+         *
+         * The buffer is flushed before reading input and before exiting.
+         */
+        bool uses_output_buffer() const;
+
+        /*!
+         * \brief Return the prefix of the runtime files of the print functions.
+         * \param platform The prefix of the runtime files of the platform.
+         */
+        std::string print_functions(const std::string& platform) const;
 };
 
 } //end of as
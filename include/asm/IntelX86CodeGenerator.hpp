@@ -20,7 +20,7 @@ namespace as {
  */
 class IntelX86CodeGenerator : public IntelCodeGenerator {
     public:
-        IntelX86CodeGenerator(AssemblyFileWriter& writer, mtac::Program& program, GlobalContext & context);
+        IntelX86CodeGenerator(AssemblyFileWriter& writer, mtac::Program& program, GlobalContext & context, std::shared_ptr<Configuration> configuration);
 
     protected:        
         void writeRuntimeSupport();
@@ -20,7 +20,7 @@ namespace as {
  */
 class IntelX86_64CodeGenerator : public IntelCodeGenerator {
     public:
-        IntelX86_64CodeGenerator(AssemblyFileWriter& writer, mtac::Program& program, GlobalContext &  context);
+        IntelX86_64CodeGenerator(AssemblyFileWriter& writer, mtac::Program& program, GlobalContext & context, std::shared_ptr<Configuration> configuration);
         
     protected:        
         void writeRuntimeSupport();
@@ -8,22 +8,31 @@
 #ifndef STRING_CONVERTER_H
 #define STRING_CONVERTER_H
 
-#include <string>
-
 #include "ltac/forward.hpp"
 
 namespace eddic {
 
+class AssemblyFileWriter;
+
 namespace as {
 
+/*!
+ * \struct StringConverter
+ * \brief Base of the visitors appending the LTAC arguments to the assembly.
+ */
 struct StringConverter {
-    std::string address_to_string(eddic::ltac::Address& address) const;
-    std::string register_to_string(eddic::ltac::AddressRegister& reg) const;
+    explicit StringConverter(AssemblyFileWriter& writer) : writer(writer) {}
+
+    void address(eddic::ltac::Address& address) const;
+    void address_register(eddic::ltac::AddressRegister& reg) const;
+
+    virtual void operator()(ltac::Register& reg) const = 0;
+    virtual void operator()(ltac::FloatRegister& reg) const = 0;
+    virtual void operator()(ltac::PseudoRegister& reg) const = 0;
+    virtual void operator()(ltac::PseudoFloatRegister& reg) const = 0;
 
-    virtual std::string operator()(ltac::Register& reg) const = 0;
-    virtual std::string operator()(ltac::FloatRegister& reg) const = 0;
-    virtual std::string operator()(ltac::PseudoRegister& reg) const = 0;
-    virtual std::string operator()(ltac::PseudoFloatRegister& reg) const = 0;
+    protected:
+        AssemblyFileWriter& writer;
 };
 
 } //end of namespace as
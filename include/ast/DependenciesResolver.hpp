@@ -8,6 +8,8 @@
 #ifndef DEPENDENCIES_RESOLVER_H
 #define DEPENDENCIES_RESOLVER_H
 
+#include <cstddef>
+
 #include "ast/source_def.hpp"
 
 namespace eddic {
@@ -18,7 +20,17 @@ namespace parser_x3 {
 
 namespace ast {
 
-void resolveDependencies(ast::SourceFile& program, parser_x3::SpiritParser& parser);
+/*!
+ * \brief Parse the files imported by the program and add their blocks to the program.
+ *
+ * The imported files are parsed concurrently, but their blocks are always added in
+ * the same order. Each file is only imported once.
+ *
+ * \param program The program to complete.
+ * \param parser The parser to use for the imported files.
+ * \param threads The maximum number of files parsed at the same time.
+ */
+void resolveDependencies(ast::SourceFile& program, parser_x3::SpiritParser& parser, std::size_t threads);
 
 } //end of ast
 
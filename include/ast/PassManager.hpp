@@ -45,6 +45,9 @@ class PassManager {
         void apply_member_function_instantiated(Pass & pass, ast::struct_definition & struct_, ast::TemplateFunctionDeclaration& function);
         void apply_struct_instantiated(Pass & pass, ast::struct_definition& struct_);
 
+        template<typename Functor>
+        void apply_instantiated(Pass & pass, Functor functor);
+
         unsigned int template_depth = 0;
 
         std::shared_ptr<ast::TemplateEngine> template_engine;
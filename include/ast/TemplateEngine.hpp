@@ -28,11 +28,13 @@ struct TemplateEngine {
         using function_template_map_sub = std::unordered_multimap<std::string, std::pair<ast::struct_definition *, ast::TemplateFunctionDeclaration>>;
         using function_template_map = std::unordered_map<std::string, function_template_map_sub>;
 
-        using LocalFunctionInstantiationMap = std::unordered_multimap<std::string, std::vector<ast::Type>>;
-        using FunctionInstantiationMap      = std::unordered_map<std::string, LocalFunctionInstantiationMap>;
+        /*!
+         * The instantiations are indexed by a canonical key built from the context, the name and
+         * the template types, so that checking for an instantiation is a single hashed lookup.
+         */
+        using InstantiationSet = std::unordered_set<std::string>;
 
-        using ClassTemplateMap      = std::unordered_multimap<std::string, ast::struct_definition>;
-        using ClassInstantiationMap = std::unordered_multimap<std::string, std::vector<ast::Type>>;
+        using ClassTemplateMap = std::unordered_multimap<std::string, ast::struct_definition>;
 
         void check_function(ast::FunctionCall& function_call);
         void check_member_function(std::shared_ptr<const eddic::Type> left, ast::Operation& operation, x3::file_position_tagged& position);
@@ -43,10 +45,10 @@ struct TemplateEngine {
         void add_template_member_function(const std::string & function, ast::struct_definition & struct_, ast::TemplateFunctionDeclaration & declaration);
 
         function_template_map function_templates;
-        FunctionInstantiationMap function_template_instantiations;
+        InstantiationSet function_template_instantiations;
 
         ClassTemplateMap class_templates;
-        ClassInstantiationMap class_template_instantiations;
+        InstantiationSet class_template_instantiations;
 
     private:
         ast::PassManager& pass_manager;
@@ -59,8 +61,7 @@ struct TemplateEngine {
                                   const std::string &                name,
                                   std::vector<ast::Type> &           template_types);
 
-        bool is_instantiated(const std::string& name, const std::string& context, const std::vector<ast::Type>& template_types);
-        bool is_class_instantiated(const std::string& name, const std::vector<ast::Type>& template_types);
+        bool mark_instantiated(InstantiationSet& instantiations, const std::string& name, const std::string& context, const std::vector<ast::Type>& template_types);
 };
 
 } // namespace eddic::ast
@@ -0,0 +1,89 @@
+//=======================================================================
+// Copyright Baptiste Wicht 2011-2016.
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#ifndef INTERNED_STRING_H
+#define INTERNED_STRING_H
+
+#include <functional>
+#include <ostream>
+#include <string>
+
+namespace eddic {
+
+/*!
+ * \class interned_string
+ * \brief An immutable string stored once in a global pool.
+ *
+ * Copying an interned string only copies a pointer and two interned strings are equal if
+ * they point to the same storage. The strings are never released, this is only meant for the
+ * labels and the constants of the intermediate representations. The pool can be safely
+ * accessed by several threads.
+ */
+class interned_string {
+    public:
+        interned_string();
+        interned_string(const std::string& value);
+        interned_string(const char* value);
+
+        const std::string& str() const {
+            return *value;
+        }
+
+        operator const std::string&() const {
+            return *value;
+        }
+
+        bool empty() const {
+            return value->empty();
+        }
+
+        friend bool operator==(const interned_string& lhs, const interned_string& rhs){
+            return lhs.value == rhs.value;
+        }
+
+        friend bool operator!=(const interned_string& lhs, const interned_string& rhs){
+            return lhs.value != rhs.value;
+        }
+
+        friend bool operator==(const interned_string& lhs, const std::string& rhs){
+            return *lhs.value == rhs;
+        }
+
+        friend bool operator==(const std::string& lhs, const interned_string& rhs){
+            return lhs == *rhs.value;
+        }
+
+        friend bool operator<(const interned_string& lhs, const interned_string& rhs){
+            return *lhs.value < *rhs.value;
+        }
+
+        friend std::size_t hash_value(const interned_string& string){
+            return std::hash<const std::string*>()(string.value);
+        }
+
+    private:
+        const std::string* value;
+};
+
+inline std::ostream& operator<<(std::ostream& stream, const interned_string& string){
+    return stream << string.str();
+}
+
+} //end of eddic
+
+namespace std {
+
+template<>
+struct hash<eddic::interned_string> {
+    std::size_t operator()(const eddic::interned_string& string) const {
+        return hash_value(string);
+    }
+};
+
+} //end of std
+
+#endif
@@ -9,6 +9,7 @@
 #define LTAC_ADDRESS_H
 
 #include "variant.hpp"
+#include "interned_string.hpp"
 
 #include <boost/optional.hpp>
 
@@ -27,7 +28,7 @@ struct Address {
     boost::optional<unsigned int> scale;
     boost::optional<int> displacement;
 
-    boost::optional<std::string> absolute;
+    boost::optional<interned_string> absolute;
 
     Address();
     explicit Address(std::string absolute);
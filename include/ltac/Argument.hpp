@@ -11,6 +11,7 @@
 #include <string>
 
 #include "variant.hpp"
+#include "interned_string.hpp"
 
 #include "ltac/forward.hpp"
 
@@ -26,7 +27,7 @@ typedef boost::variant<
         /* Address */
         eddic::ltac::Address, 
         /* Literals */
-        std::string, 
+        eddic::interned_string, 
         /* Constants */
         double, int
     > Argument;
@@ -24,15 +24,38 @@
 
 #include "tac/Size.hpp"
 
+#include "interned_string.hpp"
+
 namespace eddic {
 
 class Function;
 
 namespace ltac {
 
+/*!
+ * \struct RegisterUsage
+ * \brief The registers implicitly used and killed by an instruction.
+ *
+ * Only calls, returns, divisions and a few jumps have such registers, so they are kept out of line.
+ */
+struct RegisterUsage {
+    std::vector<ltac::PseudoRegister> uses;
+    std::vector<ltac::PseudoFloatRegister> float_uses;
+
+    std::vector<ltac::Register> hard_uses;
+    std::vector<ltac::FloatRegister> hard_float_uses;
+
+    std::vector<ltac::PseudoRegister> kills;
+    std::vector<ltac::PseudoFloatRegister> float_kills;
+
+    std::vector<ltac::Register> hard_kills;
+    std::vector<ltac::FloatRegister> hard_float_kills;
+};
+
 struct Instruction {
     private:
         std::size_t _uid;
+        std::unique_ptr<RegisterUsage> _usage;  //Only allocated when an implicit register is added
 
     public:
         ltac::Operator op;
@@ -41,20 +64,8 @@ struct Instruction {
         boost::optional<Argument> arg3;
         tac::Size size;
     
-        std::string label;                      //Only if jump
-        eddic::Function* target_function;       //Only if a call
-
-        std::vector<ltac::PseudoRegister> uses;
-        std::vector<ltac::PseudoFloatRegister> float_uses;
-
-        std::vector<ltac::Register> hard_uses;
-        std::vector<ltac::FloatRegister> hard_float_uses;
-    
-        std::vector<ltac::PseudoRegister> kills;
-        std::vector<ltac::PseudoFloatRegister> float_kills;
-
-        std::vector<ltac::Register> hard_kills;
-        std::vector<ltac::FloatRegister> hard_float_kills;
+        interned_string label;                  //Only if jump
+        eddic::Function* target_function = nullptr;  //Only if a call
 
         //Instructions no param
         Instruction(Operator op, tac::Size = tac::Size::DEFAULT);
@@ -83,6 +94,26 @@ struct Instruction {
             return _uid;
         }
 
+        /*!
+         * Return the implicit registers of this instruction. 
+         * \return The registers used and killed by the instruction, empty if there are none.
+         */
+        const RegisterUsage& usage() const;
+
+        /*!
+         * Return the implicit registers of this instruction for modification, allocating them if necessary.
+         * \return The registers used and killed by the instruction.
+         */
+        RegisterUsage& edit_usage();
+
+        /*!
+         * Indicates if the implicit registers of this instruction have been allocated.
+         * \return true if the instruction holds a RegisterUsage, false otherwise.
+         */
+        bool has_usage() const {
+            return static_cast<bool>(_usage);
+        }
+
         bool is_jump() const;
         bool is_label() const;
 };
@@ -10,9 +10,9 @@
 
 #include <memory>
 #include <ostream>
-#include <unordered_set>
 
 #include <boost/utility.hpp>
+#include <boost/dynamic_bitset.hpp>
 
 #define STATIC_CONSTANT(type,name,value) BOOST_STATIC_CONSTANT(type, name = value)
 
@@ -28,10 +28,83 @@ namespace eddic {
 
 namespace ltac {
 
+/*!
+ * \brief A set of registers stored as a bit vector indexed by the register number.
+ *
+ * The bit vectors grow as needed when registers are inserted, the missing bits
+ * are considered as not set.
+ */
+class register_set {
+    public:
+        void insert(std::size_t reg){
+            if(reg >= bits.size()){
+                bits.resize(reg + 1);
+            }
+
+            bits.set(reg);
+        }
+
+        void erase(std::size_t reg){
+            if(reg < bits.size()){
+                bits.reset(reg);
+            }
+        }
+
+        bool contains(std::size_t reg) const {
+            return reg < bits.size() && bits.test(reg);
+        }
+
+        std::size_t size() const {
+            return bits.count();
+        }
+
+        template<typename Functor>
+        void for_each(Functor functor) const {
+            for(auto i = bits.find_first(); i != boost::dynamic_bitset<>::npos; i = bits.find_next(i)){
+                functor(i);
+            }
+        }
+
+        register_set& operator|=(const register_set& rhs){
+            if(bits.size() < rhs.bits.size()){
+                bits.resize(rhs.bits.size());
+            }
+
+            if(bits.size() == rhs.bits.size()){
+                bits |= rhs.bits;
+            } else {
+                rhs.for_each([this](std::size_t reg){ bits.set(reg); });
+            }
+
+            return *this;
+        }
+
+        bool operator==(const register_set& rhs) const {
+            if(bits.size() == rhs.bits.size()){
+                return bits == rhs.bits;
+            }
+
+            if(size() != rhs.size()){
+                return false;
+            }
+
+            bool equal = true;
+            for_each([&rhs, &equal](std::size_t reg){ equal = equal && rhs.contains(reg); });
+            return equal;
+        }
+
+        bool operator!=(const register_set& rhs) const {
+            return !(*this == rhs);
+        }
+
+    private:
+        boost::dynamic_bitset<> bits;
+};
+
 template<typename Reg, typename FloatReg>
 struct LiveRegisterValues {
-    std::unordered_set<Reg> registers;
-    std::unordered_set<FloatReg> float_registers;
+    register_set registers;
+    register_set float_registers;
 
     auto inserter() {
         return [this](auto & reg) { this->insert(reg); };
@@ -42,39 +115,61 @@ struct LiveRegisterValues {
     }
 
     void insert(const Reg& reg){
-        registers.insert(reg);
+        registers.insert(reg.reg);
     }
 
     void insert(const FloatReg& reg){
-        float_registers.insert(reg);
+        float_registers.insert(reg.reg);
     }
 
-    auto find(const Reg& reg) -> decltype(registers.find(reg)) {
-        return registers.find(reg);
-    }
-    
-    auto find(const FloatReg& reg) -> decltype(float_registers.find(reg)) {
-        return float_registers.find(reg);
-    }
-    
-    auto end() -> decltype(registers.end()) {
-        return registers.end();
+    bool contains(const Reg& reg) const {
+        return registers.contains(reg.reg);
     }
-    
-    auto fend() -> decltype(float_registers.end()) {
-        return float_registers.end();
+
+    bool contains(const FloatReg& reg) const {
+        return float_registers.contains(reg.reg);
     }
-    
+
     void erase(const Reg& reg){
-        registers.erase(reg);
+        registers.erase(reg.reg);
     }
 
     void erase(const FloatReg& reg){
-        float_registers.erase(reg);
+        float_registers.erase(reg.reg);
+    }
+
+    /*!
+     * \brief Call the functor on each live register.
+     */
+    template<typename Functor>
+    void for_each_register(Functor functor) const {
+        registers.for_each([&functor](std::size_t reg){ functor(Reg(reg)); });
+    }
+
+    /*!
+     * \brief Call the functor on each live float register.
+     */
+    template<typename Functor>
+    void for_each_float_register(Functor functor) const {
+        float_registers.for_each([&functor](std::size_t reg){ functor(FloatReg(reg)); });
+    }
+
+    std::size_t size() const {
+        return registers.size() + float_registers.size();
+    }
+
+    LiveRegisterValues& operator|=(const LiveRegisterValues& rhs){
+        registers |= rhs.registers;
+        float_registers |= rhs.float_registers;
+        return *this;
+    }
+
+    bool operator==(const LiveRegisterValues& rhs) const {
+        return registers == rhs.registers && float_registers == rhs.float_registers;
     }
 
-    std::size_t size(){
-        return (static_cast<std::size_t>(std::numeric_limits<unsigned short>::max()) + 1) * registers.size() + float_registers.size();
+    bool operator!=(const LiveRegisterValues& rhs) const {
+        return !(*this == rhs);
     }
 };
 
@@ -85,14 +180,14 @@ struct LiveRegistersProblem {
     typedef mtac::Domain<LiveRegisterValues<ltac::Register, ltac::FloatRegister>> ProblemDomain;
 
     //The direction
-    STATIC_CONSTANT(mtac::DataFlowType, Type, mtac::DataFlowType::Backward);
+    STATIC_CONSTANT(mtac::DataFlowType, Type, mtac::DataFlowType::Fast_Backward);
     STATIC_CONSTANT(bool, Low, true);
 
     ProblemDomain Boundary(mtac::Function& function);
     ProblemDomain Init(mtac::Function& function);
    
     void meet(ProblemDomain& in, const ProblemDomain& out);
-    ProblemDomain transfer(const mtac::basic_block_p & basic_block, ltac::Instruction& statement, ProblemDomain& in);
+    void transfer(const mtac::basic_block_p & basic_block, ltac::Instruction& statement, ProblemDomain& in);
 
     ProblemDomain top_element(){
         return ProblemDomain();
@@ -110,14 +205,14 @@ struct LivePseudoRegistersProblem {
     typedef mtac::Domain<LiveRegisterValues<ltac::PseudoRegister, ltac::PseudoFloatRegister>> ProblemDomain;
 
     //The direction
-    STATIC_CONSTANT(mtac::DataFlowType, Type, mtac::DataFlowType::Backward);
+    STATIC_CONSTANT(mtac::DataFlowType, Type, mtac::DataFlowType::Fast_Backward);
     STATIC_CONSTANT(bool, Low, true);
 
     ProblemDomain Boundary(mtac::Function& function);
     ProblemDomain Init(mtac::Function& function);
    
     void meet(ProblemDomain& in, const ProblemDomain& out);
-    ProblemDomain transfer(const mtac::basic_block_p & basic_block, ltac::Instruction& statement, ProblemDomain& in);
+    void transfer(const mtac::basic_block_p & basic_block, ltac::Instruction& statement, ProblemDomain& in);
 
     ProblemDomain top_element(){
         return ProblemDomain();
@@ -128,21 +223,46 @@ struct LivePseudoRegistersProblem {
     }
 };
 
+template<typename Reg, typename FloatReg>
+bool operator==(const mtac::Domain<LiveRegisterValues<Reg, FloatReg>>& lhs, const mtac::Domain<LiveRegisterValues<Reg, FloatReg>>& rhs){
+    if(lhs.top() || rhs.top()){
+        return lhs.top() == rhs.top();
+    }
+
+    return lhs.values() == rhs.values();
+}
+
+template<typename Reg, typename FloatReg>
+bool operator!=(const mtac::Domain<LiveRegisterValues<Reg, FloatReg>>& lhs, const mtac::Domain<LiveRegisterValues<Reg, FloatReg>>& rhs){
+    return !(lhs == rhs);
+}
+
 template<typename Reg, typename FloatReg>
 std::ostream& operator<<(std::ostream& stream, const LiveRegisterValues<Reg, FloatReg>& value){
     stream << "set{";
 
-    for(auto& v : value.registers){
-        stream << v << ", ";
-    }
-    
-    for(auto& v : value.float_registers){
-        stream << v << ", ";
-    }
+    value.for_each_register([&stream](const Reg& v){ stream << v << ", "; });
+    value.for_each_float_register([&stream](const FloatReg& v){ stream << v << ", "; });
 
     return stream << "}";
 }
 
+} //end of ltac
+
+namespace mtac {
+
+template<>
+struct bit_vector_traits<ltac::LiveRegistersProblem> {
+    STATIC_CONSTANT(bool, enabled, true);
+    STATIC_CONSTANT(BitVectorMeet, meet, BitVectorMeet::Union);
+};
+
+template<>
+struct bit_vector_traits<ltac::LivePseudoRegistersProblem> {
+    STATIC_CONSTANT(bool, enabled, true);
+    STATIC_CONSTANT(BitVectorMeet, meet, BitVectorMeet::Union);
+};
+
 } //end of mtac
 
 } //end of eddic
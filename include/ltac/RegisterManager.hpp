@@ -41,7 +41,7 @@ class RegisterManager {
 
         mtac::escaped_variables_ptr pointer_escaped;
 
-        mtac::basic_block_p bb;
+        mtac::basic_block_p bb = nullptr;
 
         RegisterManager(FloatPool& float_pool);
 
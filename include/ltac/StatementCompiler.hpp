@@ -42,7 +42,7 @@ class StatementCompiler {
 
         ltac::RegisterManager manager;
 
-        mtac::basic_block_p bb;
+        mtac::basic_block_p bb = nullptr;
 
     private:
         const Platform platform;
@@ -42,12 +42,12 @@ inline bool is_float_reg(T value){
 
 template<typename Variant>
 bool is_variable(Variant& variant){
-    return boost::get<std::shared_ptr<Variable>>(&variant);
+    return boost::get<variable_ref>(&variant);
 }
 
 template<typename Variant>
 std::shared_ptr<Variable> get_variable(Variant& variant){
-    return boost::get<std::shared_ptr<Variable>>(variant);
+    return boost::get<variable_ref>(variant);
 }
 
 ltac::PseudoRegister to_register(std::shared_ptr<Variable> var, ltac::RegisterManager& manager);
@@ -34,6 +34,16 @@ class bit_matrix {
         void clear(std::size_t i, std::size_t j);
         bool is_set(std::size_t i, std::size_t j);
 
+        /*!
+         * \brief Return the first column set in the given row, or the size of the matrix if there is none.
+         */
+        std::size_t find_first(std::size_t i) const;
+
+        /*!
+         * \brief Return the first column set in the given row after the column j, or the size of the matrix if there is none.
+         */
+        std::size_t find_next(std::size_t i, std::size_t j) const;
+
         sub_bit_matrix operator[](std::size_t i);
         
     private:
@@ -8,9 +8,12 @@
 #ifndef LTAC_INTERFERENCE_GRAPH_H
 #define LTAC_INTERFERENCE_GRAPH_H
 
+#include <algorithm>
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "logging.hpp"
 
@@ -22,6 +25,15 @@ namespace ltac {
 
 typedef std::size_t reg;
 
+/*!
+ * \class interference_graph
+ * \brief The interference graph of the pseudo registers of a function.
+ *
+ * Small graphs store their edges in a bit matrix. Above dense_limit nodes, the
+ * edges are stored in a hash set to avoid the quadratic memory of the matrix.
+ * Once build_adjacency_vectors() has been called, the neighbors of each node
+ * are available in increasing order and nodes can be merged together.
+ */
 template<typename Pseudo>
 class interference_graph {
     public:
@@ -31,9 +43,22 @@ class interference_graph {
         void gather(const Pseudo& reg);
 
         void add_edge(reg i, reg j);
-        void remove_node(reg i);
         bool connected(reg i, reg j);
 
+        /*!
+         * \brief Merge the node i into the node j.
+         *
+         * The neighbors of i become neighbors of j and i is left without neighbors.
+         */
+        void merge(reg i, reg j);
+
+        /*!
+         * \brief Return the node the given node has been merged into, the node itself if it has not been merged.
+         */
+        reg alias(reg i);
+
+        bool merged(reg i);
+
         std::size_t degree(reg i);
         std::size_t& spill_cost(reg i);
         std::vector<reg>& neighbors(reg i);
@@ -44,15 +69,24 @@ class interference_graph {
 
         std::vector<Pseudo>& pseudos();
 
+        //Number of nodes above which the edges are not stored in a bit matrix, can be lowered to test the sparse representation
+        static inline std::size_t dense_limit = 4096;
+
     private:
+        std::uint64_t edge_key(reg i, reg j) const {
+            return static_cast<std::uint64_t>(std::min(i, j)) * m_size + std::max(i, j);
+        }
+
         std::size_t m_size = 0;
 
         std::unique_ptr<bit_matrix> matrix;
+        std::unordered_set<std::uint64_t> edges;
         
         //For each pseudo reg
         std::vector<std::vector<reg>> adjacency_vectors;
         std::vector<std::size_t> degrees;
         std::vector<std::size_t> spill_costs;
+        std::vector<reg> aliases;
         std::vector<Pseudo> index_to_pseudo; //Maps indices to pseudo regs
 
         std::unordered_map<Pseudo, std::size_t> pseudo_to_index; //Maps pseudo regs to indices
@@ -94,32 +128,85 @@ void ltac::interference_graph<Pseudo>::build_graph(){
     degrees.resize(size());
     spill_costs.resize(size());
 
-    matrix = std::make_unique<ltac::bit_matrix>(size());
+    if(size() <= dense_limit){
+        matrix = std::make_unique<ltac::bit_matrix>(size());
+    }
 }
 
 template<typename Pseudo>
 void ltac::interference_graph<Pseudo>::add_edge(std::size_t i, std::size_t j){
-    matrix->set(i, j);
-    matrix->set(j, i);
+    //A node never interferes with itself, in both representations
+    if(i == j){
+        return;
+    }
+
+    if(matrix){
+        matrix->set(i, j);
+        matrix->set(j, i);
+    } else {
+        edges.insert(edge_key(i, j));
+    }
 }
 
 template<typename Pseudo>
 bool ltac::interference_graph<Pseudo>::connected(reg i, reg j){
-    return matrix->is_set(i, j);
+    if(matrix){
+        return matrix->is_set(i, j);
+    }
+
+    return edges.count(edge_key(i, j));
 }
 
 template<typename Pseudo>
-void ltac::interference_graph<Pseudo>::remove_node(std::size_t i){
-    auto& matrix = *this->matrix;
+void ltac::interference_graph<Pseudo>::merge(reg i, reg j){
+    auto remove = [](std::vector<reg>& neighbors, reg n){
+        neighbors.erase(std::lower_bound(neighbors.begin(), neighbors.end(), n));
+    };
+
+    auto insert = [](std::vector<reg>& neighbors, reg n){
+        neighbors.insert(std::lower_bound(neighbors.begin(), neighbors.end(), n), n);
+    };
+
+    for(auto n : adjacency_vectors[i]){
+        remove(adjacency_vectors[n], i);
+
+        if(matrix){
+            matrix->clear(i, n);
+            matrix->clear(n, i);
+        } else {
+            edges.erase(edge_key(i, n));
+        }
+
+        if(connected(n, j)){
+            --degrees[n];
+        } else {
+            add_edge(n, j);
 
-    for(auto j : adjacency_vectors[i]){
-        matrix.clear(i, j);
-        matrix.clear(j, i);
+            insert(adjacency_vectors[n], j);
+            insert(adjacency_vectors[j], n);
 
-        --degrees[j];
+            ++degrees[j];
+        }
     }
 
+    adjacency_vectors[i].clear();
     degrees[i] = 0;
+
+    aliases[i] = j;
+}
+
+template<typename Pseudo>
+ltac::reg ltac::interference_graph<Pseudo>::alias(reg i){
+    while(aliases[i] != i){
+        i = aliases[i];
+    }
+
+    return i;
+}
+
+template<typename Pseudo>
+bool ltac::interference_graph<Pseudo>::merged(reg i){
+    return aliases[i] != i;
 }
 
 template<typename Pseudo>
@@ -141,18 +228,35 @@ template<typename Pseudo>
 void ltac::interference_graph<Pseudo>::build_adjacency_vectors(){
     adjacency_vectors.resize(size());
 
-    auto& matrix = *this->matrix;
-
-    for(std::size_t i = 0; i < size(); ++i){
-        adjacency_vectors[i].clear();
+    for(auto& neighbors : adjacency_vectors){
+        neighbors.clear();
+    }
 
-        for(std::size_t j = 0; j < size(); ++j){
-            if(i != j && matrix[i][j]){
+    if(matrix){
+        for(std::size_t i = 0; i < size(); ++i){
+            for(auto j = matrix->find_first(i); j < size(); j = matrix->find_next(i, j)){
                 adjacency_vectors[i].push_back(j);
             }
         }
-        
+    } else {
+        for(auto key : edges){
+            auto i = static_cast<std::size_t>(key / m_size);
+            auto j = static_cast<std::size_t>(key % m_size);
+
+            adjacency_vectors[i].push_back(j);
+            adjacency_vectors[j].push_back(i);
+        }
+
+        for(auto& neighbors : adjacency_vectors){
+            std::sort(neighbors.begin(), neighbors.end());
+        }
+    }
+
+    aliases.resize(size());
+
+    for(std::size_t i = 0; i < size(); ++i){
         degrees[i] = adjacency_vectors[i].size();
+        aliases[i] = i;
     }
 }
 
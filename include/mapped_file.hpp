@@ -0,0 +1,67 @@
+//=======================================================================
+// Copyright Baptiste Wicht 2011-2016.
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <string_view>
+
+namespace eddic {
+
+/*!
+ * \class mapped_file
+ * \brief A read-only memory mapping of a whole file.
+ *
+ * The contents are never copied, the pointers into the mapping stay valid as long as the
+ * mapped_file exists. An empty file has no mapping, its begin and end pointers are equal.
+ */
+class mapped_file {
+    public:
+        /*!
+         * \brief Map the given file.
+         * \param path The path to the file.
+         */
+        explicit mapped_file(const std::string& path);
+
+        ~mapped_file();
+
+        mapped_file(const mapped_file& rhs) = delete;
+        mapped_file& operator=(const mapped_file& rhs) = delete;
+
+        /*!
+         * \brief Indicates if the file has been opened and mapped.
+         */
+        bool valid() const {
+            return m_valid;
+        }
+
+        const char* begin() const {
+            return m_data;
+        }
+
+        const char* end() const {
+            return m_data + m_size;
+        }
+
+        std::size_t size() const {
+            return m_size;
+        }
+
+        std::string_view contents() const {
+            return {m_data, m_size};
+        }
+
+    private:
+        const char* m_data = nullptr;
+        std::size_t m_size = 0;
+        bool m_valid = false;
+};
+
+} //end of eddic
+
+#endif
@@ -12,6 +12,8 @@
 #include <string>
 
 #include "variant.hpp"
+#include "interned_string.hpp"
+#include "variable_ref.hpp"
 
 namespace eddic {
 
@@ -19,7 +21,9 @@ class Variable;
 
 namespace mtac {
 
-typedef boost::variant<std::shared_ptr<eddic::Variable>, double, int, std::string> Argument;
+//The variables are referenced by id and the labels and the string constants are interned to keep
+//the arguments small and cheap to copy
+typedef boost::variant<variable_ref, double, int, interned_string> Argument;
 
 } //end of mtac
 
@@ -41,8 +45,16 @@ inline bool operator==(const mtac::Argument& a, double b){
     return false;
 }
 
+inline bool operator==(const mtac::Argument& a, variable_ref b){
+    if(auto* ptr = boost::get<variable_ref>(&a)){
+        return *ptr == b;
+    }
+
+    return false;
+}
+
 inline bool operator==(const mtac::Argument& a, const std::shared_ptr<Variable>& b){
-    if(auto* ptr = boost::get<std::shared_ptr<Variable>>(&a)){
+    if(auto* ptr = boost::get<variable_ref>(&a)){
         return *ptr == b;
     }
 
@@ -50,7 +62,7 @@ inline bool operator==(const mtac::Argument& a, const std::shared_ptr<Variable>&
 }
 
 inline bool operator==(const mtac::Argument& a, const std::string& b){
-    if(auto* ptr = boost::get<std::string>(&a)){
+    if(auto* ptr = boost::get<interned_string>(&a)){
         return *ptr == b;
     }
 
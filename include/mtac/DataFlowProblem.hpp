@@ -10,26 +10,36 @@
 
 #include <memory>
 
+#include <boost/utility.hpp>
+
+#define STATIC_CONSTANT(type,name,value) BOOST_STATIC_CONSTANT(type, name = value)
+
 #include "mtac/forward.hpp"
+#include "mtac/block_map.hpp"
 #include "mtac/DataFlowDomain.hpp"
 
 namespace eddic {
 
 namespace mtac {
 
+/*!
+ * \brief The results of a data-flow problem.
+ *
+ * Only the values at the boundaries of the basic blocks are stored, the values of
+ * the statements can be computed with a data_flow_cursor.
+ */
 template<typename Domain>
 struct DataFlowResults {
-    std::unordered_map<mtac::basic_block_p, Domain> OUT;
-    std::unordered_map<mtac::basic_block_p, Domain> IN;
-    
-    std::unordered_map<std::size_t, Domain> OUT_S;
-    std::unordered_map<std::size_t, Domain> IN_S;
+    /*!
+     * \param blocks The number of ids given to the basic blocks of the function.
+     */
+    explicit DataFlowResults(std::size_t blocks) : OUT(blocks), IN(blocks) {}
+
+    mtac::block_map<Domain> OUT;
+    mtac::block_map<Domain> IN;
 };
 
 enum class DataFlowType : unsigned int {
-    Forward,                //Common forward data-flow problem
-    Backward,               //Common backward data-flow problem
-
     Fast_Forward,           //Fast forward data-flow on statements
     Fast_Forward_Block,     //Fast forward data-flow on block
 
@@ -37,6 +47,23 @@ enum class DataFlowType : unsigned int {
     Fast_Backward_Block     //Fast forward data-flow on blocks
 };
 
+enum class BitVectorMeet : unsigned int {
+    Union,
+    Intersection
+};
+
+/*!
+ * \brief Traits of the problems working on a dense bit-vector domain.
+ *
+ * A problem opts into it by specializing this trait. Its values must then support
+ * the word-at-a-time |= and &= operators and the solver computes the meet directly
+ * with them instead of calling the meet function of the problem.
+ */
+template<typename Problem>
+struct bit_vector_traits {
+    STATIC_CONSTANT(bool, enabled, false);
+};
+
 template<typename ProblemDomain>
 void intersection_meet(ProblemDomain& in, const ProblemDomain& out){
     //eddic_assert(!in.top() || !out.top(), "At least one lattice should not be a top element");
@@ -60,15 +87,11 @@ void intersection_meet(ProblemDomain& in, const ProblemDomain& out){
         while(it != end){
             auto var = it->first;
 
+            //A value is only kept if it is the same on both sides
             auto out_it = out.find(var);
-            if(out_it != out.end()){
-                auto value_in = it->second;
-                auto value_out = out_it->second;
-
-                if(!(value_in == value_out)){
-                    it = in.erase(it);
-                    continue;
-                }
+            if(out_it == out.end() || !(it->second == out_it->second)){
+                it = in.erase(it);
+                continue;
             }
 
             ++it;
@@ -11,6 +11,8 @@
 #include <unordered_set>
 #include <memory>
 
+#include "variable_ref.hpp"
+
 #include "mtac/forward.hpp"
 
 namespace eddic {
@@ -19,8 +21,8 @@ class Variable;
 
 namespace mtac {
 
-typedef std::unordered_set<std::shared_ptr<Variable>> escaped_variables;
-typedef std::unique_ptr<std::unordered_set<std::shared_ptr<Variable>>> escaped_variables_ptr;
+typedef std::unordered_set<variable_ref> escaped_variables;
+typedef std::unique_ptr<std::unordered_set<variable_ref>> escaped_variables_ptr;
 
 escaped_variables_ptr escape_analysis(mtac::Function& function);
 
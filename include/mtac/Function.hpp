@@ -8,6 +8,7 @@
 #ifndef MTAC_FUNCTION_H
 #define MTAC_FUNCTION_H
 
+#include <deque>
 #include <memory>
 #include <vector>
 #include <utility>
@@ -92,6 +93,16 @@ class Function : public std::enable_shared_from_this<Function> {
         basic_block_p entry_bb();
         basic_block_p exit_bb();
 
+        /*!
+         * \brief Return the number of ids given to the basic blocks of the function.
+         *
+         * The ids of the blocks are dense and smaller than this number, the per-block data
+         * can be stored in a vector of this size (see mtac::block_map).
+         */
+        std::size_t bb_ids() const {
+            return arena.size();
+        }
+
         /*!
          * \brief Return an iterator to the beginning of the doubly-linked list of basic blocks. 
          * \return iterator to the beginning of the doubly-linked list of basic blocks. 
@@ -202,6 +213,18 @@ class Function : public std::enable_shared_from_this<Function> {
          */
         bool standard() const;
 
+        /*!
+         * \brief Indicate if the frequencies of the basic blocks of the function come from a profile. 
+         * \return true if the function has been profiled, false otherwise. 
+         */
+        bool& profiled();
+
+        /*!
+         * \brief Indicate if the frequencies of the basic blocks of the function come from a profile. 
+         * \return true if the function has been profiled, false otherwise. 
+         */
+        bool profiled() const;
+
         /*!
          * \brief Return the function definition for this MTAC function. 
          * \return the function definition of this function.
@@ -224,7 +247,11 @@ class Function : public std::enable_shared_from_this<Function> {
 
         bool _pure = false;
         bool _standard = false;
+        bool _profiled = false;
         
+        //The storage of the basic blocks, a block is never moved once allocated
+        std::deque<mtac::basic_block> arena;
+
         //There is no basic blocks at the beginning
         std::size_t count = 0;
         std::size_t index = 0;
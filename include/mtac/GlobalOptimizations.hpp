@@ -21,18 +21,30 @@
 
 #include "mtac/Program.hpp"
 #include "mtac/DataFlowProblem.hpp"
+#include "mtac/data_flow_worklist.hpp"
 
 namespace eddic::mtac {
 
-template<typename Left, typename Right>
-inline void assign(Left& old, Right&& value, bool& changes){
-    if(old.top()){
-        changes = !value.top();
-    } else if(old.values().size() != value.values().size()){
-        changes = true;
+/*!
+ * \brief Meet the given values into in.
+ *
+ * The meet of bit-vector problems is computed word-at-a-time, the meet of the other problems is delegated to the problem.
+ */
+template<typename Problem, typename Domain>
+inline void data_flow_meet(Problem& problem, Domain& in, const Domain& out){
+    if constexpr (bit_vector_traits<Problem>::enabled) {
+        if(out.top()){
+            //in does not change
+        } else if(in.top()){
+            in = out;
+        } else if constexpr (bit_vector_traits<Problem>::meet == BitVectorMeet::Union) {
+            in.values() |= out.values();
+        } else {
+            in.values() &= out.values();
+        }
+    } else {
+        problem.meet(in, out);
     }
-
-    old = value;
 }
 
 template <bool Low>
@@ -45,20 +57,17 @@ inline std::enable_if_t<!Low, std::vector<mtac::Quadruple> &> get_statements(mta
     return B->statements;
 }
 
-//Forward
+//Fast forward statements
 
 template<bool Low, typename Problem>
-std::shared_ptr<DataFlowResults<typename Problem::ProblemDomain>> forward_data_flow(mtac::Function& function, Problem& problem){
+std::shared_ptr<DataFlowResults<typename Problem::ProblemDomain>> fast_forward_data_flow(mtac::Function& function, Problem& problem){
     typedef typename Problem::ProblemDomain Domain;
 
-    auto results = std::make_shared<DataFlowResults<Domain>>();
+    auto results = std::make_shared<DataFlowResults<Domain>>(function.bb_ids());
     
     auto& OUT = results->OUT;
     auto& IN = results->IN;
 
-    auto& OUT_S = results->OUT_S;
-    auto& IN_S = results->IN_S;
-
     OUT[function.entry_bb()] = problem.Boundary(function);
     LOG<Dev>("Data-Flow") << "OUT[" << *function.entry_bb() << "] set to " << OUT[function.entry_bb()] << log::endl;
 
@@ -70,189 +79,43 @@ std::shared_ptr<DataFlowResults<typename Problem::ProblemDomain>> forward_data_f
         }
     }
 
-    bool changes = true;
-    while(changes){
-        changes = false;
-
-        for(auto& B : function){
-            //Do not consider ENTRY
-            if(B->index == -1){
-                continue;
-            }
-
-            auto& statements = get_statements<Low>(B);
-
-            for(auto& P : B->predecessors){
-                LOG<Dev>("Data-Flow") << "Meet B = " << *B << " with P = " << *P << log::endl;
-                LOG<Dev>("Data-Flow") << "IN[B] before " << IN[B] << log::endl;
-                LOG<Dev>("Data-Flow") << "OUT[P] before " << OUT[P] << log::endl;
-
-                problem.meet(IN[B], OUT[P]);
-                
-                LOG<Dev>("Data-Flow") << "IN[B] after " << IN[B] << log::endl;
-
-                if(statements.size() > 0){
-                    IN_S[statements.front().uid()] = IN[B];
+    data_flow_worklist worklist(function, true);
 
-                    for(unsigned i = 0; i < statements.size(); ++i){
-                        auto& statement = statements[i];
+    while(!worklist.empty()){
+        auto B = worklist.pop();
 
-                        assign(OUT_S[statement.uid()], problem.transfer(B, statement, IN_S[statement.uid()]), changes);
-
-                        //The entry value of the next statement are the exit values of the current statement
-                        if(i != statements.size() - 1){
-                            IN_S[statements[i+1].uid()] = OUT_S[statement.uid()];
-                        }
-                    }
-
-                    assign(OUT[B], OUT_S[statements.back().uid()], changes);
-                } else {
-                    //If the basic block is empty, the OUT values are the IN values
-                    assign(OUT[B], IN[B], changes);
-                }
-            }
+        //A block without predecessors keeps its initial value
+        if(B->predecessors.empty()){
+            continue;
         }
-    }
-
-    return results;
-}
 
-//Backward
+        for(auto& P : B->predecessors){
+            LOG<Dev>("Data-Flow") << "Meet B = " << *B << " with P = " << *P << log::endl;
+            LOG<Dev>("Data-Flow") << "IN[B] before " << IN[B] << log::endl;
+            LOG<Dev>("Data-Flow") << "OUT[P] before " << OUT[P] << log::endl;
 
-template<bool Low, typename Problem>
-std::shared_ptr<DataFlowResults<typename Problem::ProblemDomain>> backward_data_flow(mtac::Function& function, Problem& problem){
-    typedef typename Problem::ProblemDomain Domain;
+            data_flow_meet(problem, IN[B], OUT[P]);
 
-    auto results = std::make_shared<DataFlowResults<Domain>>();
-    
-    auto& OUT = results->OUT;
-    auto& IN = results->IN;
-    
-    auto& OUT_S = results->OUT_S;
-    auto& IN_S = results->IN_S;
-
-    IN[function.exit_bb()] = problem.Boundary(function);
-    LOG<Dev>("Data-Flow") << "IN[" << *function.exit_bb() << "] set to " << IN[function.exit_bb()] << log::endl;
-    
-    for(auto& block : function){
-        //Init all but EXIT
-        if(block->index != -2){
-            IN[block] = problem.Init(function);
-            LOG<Dev>("Data-Flow") << "IN[" << *block << "] set to " << IN[block] << log::endl;
+            LOG<Dev>("Data-Flow") << "IN[B] after " << IN[B] << log::endl;
         }
-    }
 
-    bool changes = true;
-    while(changes){
-        changes = false;
+        auto in = IN[B];
 
-        for(auto& B : function){
-            //Do not consider EXIT
-            if(B->index == -2){
-                continue;
-            }
+        for(auto& statement : get_statements<Low>(B)){
+            problem.transfer(B, statement, in);
+        }
 
-            auto& statements = get_statements<Low>(B);
+        //Only the successors of a modified block need to be recomputed
+        if(OUT[B] != in){
+            OUT[B] = std::move(in);
 
             for(auto& S : B->successors){
-                LOG<Dev>("Data-Flow") << "Meet B = " << *B << " with S = " << *S << log::endl;
-                LOG<Dev>("Data-Flow") << "OUT[B] before " << OUT[B] << log::endl;
-                LOG<Dev>("Data-Flow") << "IN[S]  before " << IN[S] << log::endl;
-
-                problem.meet(OUT[B], IN[S]);
-                
-                LOG<Dev>("Data-Flow") << "OUT[B]  after " << OUT[B] << log::endl;
-
-                if(statements.size() > 0){
-                    LOG<Dev>("Data-Flow") << "OUT_S[" << (statements.size() - 1) << "] before transfer " << OUT_S[statements[statements.size() - 1].uid()] << log::endl;
-                    assign(OUT_S[statements.back().uid()], OUT[B], changes);
-                    LOG<Dev>("Data-Flow") << "OUT_S[" << (statements.size() - 1) << "] after  transfer " << OUT_S[statements[statements.size() - 1].uid()] << log::endl;
-
-                    for(unsigned i = statements.size() - 1; i > 0; --i){
-                        auto& statement = statements[i];
-
-                        LOG<Dev>("Data-Flow") << "IN_S[" << i << "] before transfer " << IN_S[statement.uid()] << log::endl;
-                        assign(IN_S[statement.uid()], problem.transfer(B, statement, OUT_S[statement.uid()]), changes);
-                        LOG<Dev>("Data-Flow") << "IN_S[" << i << "] after  transfer " << IN_S[statement.uid()] << log::endl;
-
-                        LOG<Dev>("Data-Flow") << "OUT_S[" << (i - 1) << "] before transfer " << OUT_S[statements[i - 1].uid()] << log::endl;
-                        OUT_S[statements[i-1].uid()] = IN_S[statement.uid()];
-                        LOG<Dev>("Data-Flow") << "OUT_S[" << (i - 1) << "] after  transfer " << OUT_S[statements[i - 1].uid()] << log::endl;
-                    }
-
-                    LOG<Dev>("Data-Flow") << "IN_S[" << 0 << "] before transfer " << IN_S[statements[0].uid()] << log::endl;
-                    assign(IN_S[statements[0].uid()], problem.transfer(B, statements[0], OUT_S[statements[0].uid()]), changes);
-                    LOG<Dev>("Data-Flow") << "IN_S[" << 0 << "] after  transfer " << IN_S[statements[0].uid()] << log::endl;
-
-                    assign(IN[B], IN_S[statements.front().uid()], changes);
-                } else {
-                    //If the basic block is empty, the IN values are the OUT values
-                    assign(IN[B], OUT[B], changes);
-                }
-                
-                LOG<Dev>("Data-Flow") << "IN[B]   after " << IN[B] << log::endl;
+                worklist.push(S);
             }
         }
     }
 
-    return results;
-}
-
-//Fast forward statements
-
-template<bool Low, typename Problem>
-std::shared_ptr<DataFlowResults<typename Problem::ProblemDomain>> fast_forward_data_flow(mtac::Function& function, Problem& problem){
-    typedef typename Problem::ProblemDomain Domain;
-
-    auto results = std::make_shared<DataFlowResults<Domain>>();
-    
-    auto& OUT = results->OUT;
-    auto& IN = results->IN;
-
-    OUT[function.entry_bb()] = problem.Boundary(function);
-    LOG<Dev>("Data-Flow") << "OUT[" << *function.entry_bb() << "] set to " << OUT[function.entry_bb()] << log::endl;
-
-    for(auto& block : function){
-        //Initialize all but ENTRY
-        if(block->index != -1){
-            OUT[block] = problem.Init(function);
-            LOG<Dev>("Data-Flow") << "OUT[" << *block << "] set to " << OUT[block] << log::endl;
-        }
-    }
-
-    bool changes = true;
-    while(changes){
-        changes = false;
-
-        for(auto& B : function){
-            //Do not consider ENTRY
-            if(B->index == -1){
-                continue;
-            }
-
-            for(auto& P : B->predecessors){
-                LOG<Dev>("Data-Flow") << "Meet B = " << *B << " with P = " << *P << log::endl;
-                LOG<Dev>("Data-Flow") << "IN[B] before " << IN[B] << log::endl;
-                LOG<Dev>("Data-Flow") << "OUT[P] before " << OUT[P] << log::endl;
-
-                problem.meet(IN[B], OUT[P]);
-                
-                LOG<Dev>("Data-Flow") << "IN[B] after " << IN[B] << log::endl;
-
-                auto in = IN[B];
-
-                for(auto& statement : get_statements<Low>(B)){
-                    problem.transfer(B, statement, in);
-                }
-
-                if(!changes && OUT[B] != in){
-                    changes = true;
-                }
-
-                OUT[B] = std::move(in);
-            }
-        }
-    }
+    worklist.report(function);
 
     return results;
 }
@@ -263,7 +126,7 @@ template<typename Problem>
 std::shared_ptr<DataFlowResults<typename Problem::ProblemDomain>> fast_forward_data_flow_block(mtac::Function& function, Problem& problem){
     typedef typename Problem::ProblemDomain Domain;
 
-    auto results = std::make_shared<DataFlowResults<Domain>>();
+    auto results = std::make_shared<DataFlowResults<Domain>>(function.bb_ids());
     
     auto& OUT = results->OUT;
     auto& IN = results->IN;
@@ -279,38 +142,42 @@ std::shared_ptr<DataFlowResults<typename Problem::ProblemDomain>> fast_forward_d
         }
     }
 
-    bool changes = true;
-    while(changes){
-        changes = false;
+    data_flow_worklist worklist(function, true);
 
-        for(auto& B : function){
-            //Do not consider ENTRY
-            if(B->index == -1){
-                continue;
-            }
+    while(!worklist.empty()){
+        auto B = worklist.pop();
 
-            for(auto& P : B->predecessors){
-                LOG<Dev>("Data-Flow") << "Meet B = " << *B << " with P = " << *P << log::endl;
-                LOG<Dev>("Data-Flow") << "IN[B] before " << IN[B] << log::endl;
-                LOG<Dev>("Data-Flow") << "OUT[P] before " << OUT[P] << log::endl;
+        //A block without predecessors keeps its initial value
+        if(B->predecessors.empty()){
+            continue;
+        }
 
-                problem.meet(IN[B], OUT[P]);
-                
-                LOG<Dev>("Data-Flow") << "IN[B] after " << IN[B] << log::endl;
+        for(auto& P : B->predecessors){
+            LOG<Dev>("Data-Flow") << "Meet B = " << *B << " with P = " << *P << log::endl;
+            LOG<Dev>("Data-Flow") << "IN[B] before " << IN[B] << log::endl;
+            LOG<Dev>("Data-Flow") << "OUT[P] before " << OUT[P] << log::endl;
+
+            data_flow_meet(problem, IN[B], OUT[P]);
+
+            LOG<Dev>("Data-Flow") << "IN[B] after " << IN[B] << log::endl;
+        }
 
-                auto in = IN[B];
+        auto in = IN[B];
 
-                problem.transfer(B, in);
+        problem.transfer(B, in);
 
-                if(!changes && OUT[B] != in){
-                    changes = true;
-                }
+        //Only the successors of a modified block need to be recomputed
+        if(OUT[B] != in){
+            OUT[B] = std::move(in);
 
-                OUT[B] = std::move(in);
+            for(auto& S : B->successors){
+                worklist.push(S);
             }
         }
     }
 
+    worklist.report(function);
+
     return results;
 }
 
@@ -320,7 +187,7 @@ template<bool Low, typename Problem>
 std::shared_ptr<DataFlowResults<typename Problem::ProblemDomain>> fast_backward_data_flow(mtac::Function& function, Problem& problem){
     typedef typename Problem::ProblemDomain Domain;
 
-    auto results = std::make_shared<DataFlowResults<Domain>>();
+    auto results = std::make_shared<DataFlowResults<Domain>>(function.bb_ids());
     
     auto& OUT = results->OUT;
     auto& IN = results->IN;
@@ -336,42 +203,44 @@ std::shared_ptr<DataFlowResults<typename Problem::ProblemDomain>> fast_backward_
         }
     }
 
-    bool changes = true;
-    while(changes){
-        changes = false;
+    data_flow_worklist worklist(function, false);
 
-        for(auto& B : function){
-            //Do not consider EXIT
-            if(B->index == -2){
-                continue;
-            }
+    while(!worklist.empty()){
+        auto B = worklist.pop();
 
-            auto& statements = get_statements<Low>(B);
+        //A block without successors keeps its initial value
+        if(B->successors.empty()){
+            continue;
+        }
 
-            for(auto& S : B->successors){
-                LOG<Dev>("Data-Flow") << "Meet B = " << *B << " with S = " << *S << log::endl;
-                LOG<Dev>("Data-Flow") << "OUT[B] before " << OUT[B] << log::endl;
-                LOG<Dev>("Data-Flow") << "IN[S]  before " << IN[S] << log::endl;
+        for(auto& S : B->successors){
+            LOG<Dev>("Data-Flow") << "Meet B = " << *B << " with S = " << *S << log::endl;
+            LOG<Dev>("Data-Flow") << "OUT[B] before " << OUT[B] << log::endl;
+            LOG<Dev>("Data-Flow") << "IN[S]  before " << IN[S] << log::endl;
+
+            data_flow_meet(problem, OUT[B], IN[S]);
 
-                problem.meet(OUT[B], IN[S]);
-                
-                LOG<Dev>("Data-Flow") << "OUT[B]  after " << OUT[B] << log::endl;
+            LOG<Dev>("Data-Flow") << "OUT[B]  after " << OUT[B] << log::endl;
+        }
 
-                auto out = OUT[B];
+        auto out = OUT[B];
 
-                for(auto& statement : boost::adaptors::reverse(get_statements<Low>(B))){
-                    problem.transfer(B, statement, out);
-                }
+        for(auto& statement : boost::adaptors::reverse(get_statements<Low>(B))){
+            problem.transfer(B, statement, out);
+        }
 
-                if(!changes && IN[B] != out){
-                    changes = true;
-                }
+        //Only the predecessors of a modified block need to be recomputed
+        if(IN[B] != out){
+            IN[B] = std::move(out);
 
-                IN[B] = std::move(out);
+            for(auto& P : B->predecessors){
+                worklist.push(P);
             }
         }
     }
 
+    worklist.report(function);
+
     return results;
 }
 
@@ -381,7 +250,7 @@ template<typename Problem>
 std::shared_ptr<DataFlowResults<typename Problem::ProblemDomain>> fast_backward_data_flow_block(mtac::Function& function, Problem& problem){
     typedef typename Problem::ProblemDomain Domain;
 
-    auto results = std::make_shared<DataFlowResults<Domain>>();
+    auto results = std::make_shared<DataFlowResults<Domain>>(function.bb_ids());
     
     auto& OUT = results->OUT;
     auto& IN = results->IN;
@@ -397,48 +266,48 @@ std::shared_ptr<DataFlowResults<typename Problem::ProblemDomain>> fast_backward_
         }
     }
 
-    bool changes = true;
-    while(changes){
-        changes = false;
+    data_flow_worklist worklist(function, false);
 
-        for(auto& B : function){
-            //Do not consider EXIT
-            if(B->index == -2){
-                continue;
-            }
+    while(!worklist.empty()){
+        auto B = worklist.pop();
 
-            for(auto& S : B->successors){
-                LOG<Dev>("Data-Flow") << "Meet B = " << *B << " with S = " << *S << log::endl;
-                LOG<Dev>("Data-Flow") << "OUT[B] before " << OUT[B] << log::endl;
-                LOG<Dev>("Data-Flow") << "IN[S]  before " << IN[S] << log::endl;
+        //A block without successors keeps its initial value
+        if(B->successors.empty()){
+            continue;
+        }
+
+        for(auto& S : B->successors){
+            LOG<Dev>("Data-Flow") << "Meet B = " << *B << " with S = " << *S << log::endl;
+            LOG<Dev>("Data-Flow") << "OUT[B] before " << OUT[B] << log::endl;
+            LOG<Dev>("Data-Flow") << "IN[S]  before " << IN[S] << log::endl;
+
+            data_flow_meet(problem, OUT[B], IN[S]);
 
-                problem.meet(OUT[B], IN[S]);
-                
-                LOG<Dev>("Data-Flow") << "OUT[B]  after " << OUT[B] << log::endl;
+            LOG<Dev>("Data-Flow") << "OUT[B]  after " << OUT[B] << log::endl;
+        }
 
-                auto out = OUT[B];
+        auto out = OUT[B];
 
-                problem.transfer(B, out);
+        problem.transfer(B, out);
 
-                if(!changes && IN[B] != out){
-                    changes = true;
-                }
+        //Only the predecessors of a modified block need to be recomputed
+        if(IN[B] != out){
+            IN[B] = std::move(out);
 
-                IN[B] = std::move(out);
+            for(auto& P : B->predecessors){
+                worklist.push(P);
             }
         }
     }
 
+    worklist.report(function);
+
     return results;
 }
 
 template <typename Problem>
 typename std::shared_ptr<DataFlowResults<typename Problem::ProblemDomain>> data_flow(mtac::Function & function, Problem & problem) {
-    if constexpr (Problem::Type == DataFlowType::Forward) {
-        return forward_data_flow<Problem::Low>(function, problem);
-    } else if constexpr (Problem::Type == DataFlowType::Backward) {
-        return backward_data_flow<Problem::Low>(function, problem);
-    } else if constexpr (Problem::Type == DataFlowType::Fast_Forward) {
+    if constexpr (Problem::Type == DataFlowType::Fast_Forward) {
         return fast_forward_data_flow<Problem::Low>(function, problem);
     } else if constexpr (Problem::Type == DataFlowType::Fast_Forward_Block) {
         return fast_forward_data_flow_block(function, problem);
@@ -8,13 +8,14 @@
 #ifndef MTAC_LIVE_VARIABLE_ANALYSIS_PROBLEM_H
 #define MTAC_LIVE_VARIABLE_ANALYSIS_PROBLEM_H
 
-#include <unordered_set>
 #include <memory>
 
 #include "mtac/DataFlowProblem.hpp"
 #include "mtac/EscapeAnalysis.hpp"
+#include "mtac/variable_numbering.hpp"
 
 #include <boost/utility.hpp>
+#include <boost/dynamic_bitset.hpp>
 
 #define STATIC_CONSTANT(type,name,value) BOOST_STATIC_CONSTANT(type, name = value)
 
@@ -24,7 +25,8 @@ class Variable;
 
 namespace mtac {
     
-typedef std::set<std::shared_ptr<Variable>> Values;
+//Set of live variables, indexed by the variable numbering of the function
+typedef boost::dynamic_bitset<> Values;
 
 struct LiveVariableAnalysisProblem {
     //The type of data managed
@@ -35,6 +37,7 @@ struct LiveVariableAnalysisProblem {
     STATIC_CONSTANT(bool, Low, false);
 
     mtac::escaped_variables_ptr pointer_escaped;
+    mtac::variable_numbering numbering;
     
     ProblemDomain Boundary(mtac::Function& function);
     ProblemDomain Init(mtac::Function& function);
@@ -43,9 +46,20 @@ struct LiveVariableAnalysisProblem {
     
     void transfer(const mtac::basic_block_p & basic_block, ProblemDomain& in);
     void transfer(const mtac::basic_block_p & basic_block, mtac::Quadruple& statement, ProblemDomain& in);
+
+    /*!
+     * \brief Indicates if the variable is live in the given values.
+     */
+    bool live(const ProblemDomain& values, variable_ref variable) const;
     
-    std::unordered_map<mtac::basic_block_p, std::set<std::shared_ptr<Variable>>> def;
-    std::unordered_map<mtac::basic_block_p, std::set<std::shared_ptr<Variable>>> use;
+    mtac::block_map<Values> def;
+    mtac::block_map<Values> use;
+};
+
+template<>
+struct bit_vector_traits<LiveVariableAnalysisProblem> {
+    STATIC_CONSTANT(bool, enabled, true);
+    STATIC_CONSTANT(BitVectorMeet, meet, BitVectorMeet::Union);
 };
 
 bool operator==(const mtac::Domain<Values>& lhs, const mtac::Domain<Values>& rhs);
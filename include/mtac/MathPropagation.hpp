@@ -31,8 +31,8 @@ class MathPropagation {
         void operator()(mtac::Quadruple& quadruple);
 
     private:
-        std::unordered_map<std::shared_ptr<Variable>, std::reference_wrapper<mtac::Quadruple>> assigns;
-        std::unordered_map<std::shared_ptr<Variable>, int> usage;
+        std::unordered_map<variable_ref, std::reference_wrapper<mtac::Quadruple>> assigns;
+        std::unordered_map<variable_ref, int> usage;
 };
 
 template<>
@@ -29,8 +29,8 @@ class PointerPropagation {
         void operator()(mtac::Quadruple& quadruple);
 
     private:
-        std::unordered_map<std::shared_ptr<Variable>, std::shared_ptr<Variable>> aliases;
-        std::unordered_map<std::shared_ptr<Variable>, std::shared_ptr<Variable>> pointer_copies;
+        std::unordered_map<variable_ref, variable_ref> aliases;
+        std::unordered_map<variable_ref, variable_ref> pointer_copies;
 };
 
 template<>
@@ -10,6 +10,7 @@
 
 #include <memory>
 #include <iostream>
+#include <string>
 
 #include "mtac/Function.hpp"
 #include "mtac/call_graph.hpp"
@@ -48,6 +49,8 @@ struct Program {
 
     mtac::call_graph cg;
 
+    std::string profile_file;   /*!< The file the instrumented program writes its counters to at exit, empty if not instrumented */
+
     /*!
      * Create a new Program
      */
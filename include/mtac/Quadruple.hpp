@@ -12,6 +12,9 @@
 #include <ostream>
 #include <boost/optional.hpp>
 
+#include "interned_string.hpp"
+#include "variable_ref.hpp"
+
 #include "tac/Size.hpp"
 
 #include "mtac/forward.hpp"
@@ -25,27 +28,25 @@ class Variable;
 
 namespace mtac {
 
-//TODO Quadruple should be made smaller to allow faster removal
-
 struct Quadruple {
     private:
         std::size_t _uid;
 
     public:
-        std::shared_ptr<Variable> result;
+        variable_ref result;
         boost::optional<mtac::Argument> arg1;
         boost::optional<mtac::Argument> arg2;
         mtac::Operator op;
         tac::Size size;
 
-        std::shared_ptr<Variable> secondary; //For CALL
+        variable_ref secondary; //For CALL
 
         eddic::Function* m_function = nullptr; //For PARAM
 
-        std::string m_param; //For LABEL, GOTO, PARAM
+        interned_string m_param; //For LABEL, GOTO, PARAM
 
         //Filled only in later phase replacing the label
-        mtac::basic_block_p block;
+        mtac::basic_block_p block = nullptr;
 
         //Copy constructors
         Quadruple(const Quadruple& rhs);
@@ -61,10 +62,10 @@ struct Quadruple {
         explicit Quadruple(mtac::Operator op, tac::Size = tac::Size::DEFAULT);
 
         //Quadruple for unary operators
-        explicit Quadruple(std::shared_ptr<Variable> result, mtac::Argument arg1, mtac::Operator op, tac::Size = tac::Size::DEFAULT);
+        explicit Quadruple(variable_ref result, mtac::Argument arg1, mtac::Operator op, tac::Size = tac::Size::DEFAULT);
 
         //Quadruple for binary operators
-        explicit Quadruple(std::shared_ptr<Variable> result, mtac::Argument arg1, mtac::Operator op, mtac::Argument arg2, tac::Size = tac::Size::DEFAULT);
+        explicit Quadruple(variable_ref result, mtac::Argument arg1, mtac::Operator op, mtac::Argument arg2, tac::Size = tac::Size::DEFAULT);
 
         //Quadruples without assign to result
         explicit Quadruple(mtac::Operator op, mtac::Argument arg1, tac::Size = tac::Size::DEFAULT);
@@ -76,20 +77,20 @@ struct Quadruple {
         explicit Quadruple(std::string param, mtac::Operator op, tac::Size = tac::Size::DEFAULT);
 
         //Quadruples for params
-        explicit Quadruple(mtac::Operator op, mtac::Argument arg, std::shared_ptr<Variable> param, eddic::Function& function, tac::Size = tac::Size::DEFAULT);
+        explicit Quadruple(mtac::Operator op, mtac::Argument arg, variable_ref param, eddic::Function& function, tac::Size = tac::Size::DEFAULT);
         explicit Quadruple(mtac::Operator op, mtac::Argument arg, std::string param, eddic::Function& function, tac::Size = tac::Size::DEFAULT);
 
         explicit Quadruple(mtac::Operator op, mtac::Argument arg, std::string label, tac::Size = tac::Size::DEFAULT);
 
         //Quadruple for calls
-        explicit Quadruple(mtac::Operator op, eddic::Function& function, std::shared_ptr<Variable> return1 = nullptr, std::shared_ptr<Variable> return2 = nullptr, tac::Size = tac::Size::DEFAULT);
+        explicit Quadruple(mtac::Operator op, eddic::Function& function, variable_ref return1 = nullptr, variable_ref return2 = nullptr, tac::Size = tac::Size::DEFAULT);
 
         const std::string& label() const;
         const std::string& std_param() const;
 
-        const std::shared_ptr<Variable>& param() const;
-        const std::shared_ptr<Variable>& return1() const;
-        const std::shared_ptr<Variable>& return2() const;
+        variable_ref param() const;
+        variable_ref return1() const;
+        variable_ref return2() const;
 
         eddic::Function& function();
         const eddic::Function& function() const;
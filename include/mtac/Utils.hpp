@@ -56,7 +56,7 @@ inline bool isFloat(T& variant){
 
 template<typename T>
 inline bool isVariable(T& variant){
-    return boost::get<std::shared_ptr<Variable>>(&variant);
+    return boost::get<variable_ref>(&variant);
 }
 
 template<typename T>
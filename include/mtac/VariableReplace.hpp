@@ -22,7 +22,7 @@ class Variable;
 
 namespace mtac {
 
-typedef std::unordered_map<std::shared_ptr<Variable>, mtac::Argument> VariableClones;
+typedef std::unordered_map<variable_ref, mtac::Argument> VariableClones;
 
 struct VariableReplace {
     VariableClones& clones;
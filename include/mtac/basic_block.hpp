@@ -10,6 +10,8 @@
 
 #include <vector>
 
+#include <boost/container/small_vector.hpp>
+
 #include "variant.hpp"
 
 #include "mtac/forward.hpp"
@@ -29,11 +31,13 @@ namespace mtac {
  * \class basic_block
  * \brief A basic block in the MTAC representation. 
  * The basic blocks of a function are maintained in a doubly linked list. 
+ * They are allocated in the arena of the function and stay valid as long as the function exists.
  */
 class basic_block {
     public:
         using iterator         = std::vector<mtac::Quadruple>::iterator;
         using reverse_iterator = std::vector<mtac::Quadruple>::reverse_iterator;
+        using edges            = boost::container::small_vector<basic_block_p, 2>;
 
         /*!
          * Create a new basic block with the given index. 
@@ -124,7 +128,9 @@ class basic_block {
         std::size_t size_no_nop() const ;
 
         const int index;    /*!< The index of the block */
+        std::size_t id = 0; /*!< The dense id of the block in the arena of its function, used to index the per-block data */
         unsigned int depth = 0;
+        std::size_t frequency = 0;  /*!< The number of executions of the block in the profile, only valid in profiled functions */
         std::string label;  /*!< The label of the block */
         FunctionContext * context = nullptr;     /*!< The context of the enclosing function. */
 
@@ -134,16 +140,16 @@ class basic_block {
 
         /* Doubly-linked list  */
 
-        std::shared_ptr<basic_block> next = nullptr;     /*!< The next basic block in the doubly-linked list. */
-        std::shared_ptr<basic_block> prev = nullptr;     /*!< The previous basic block in the doubly-linked list. */
+        basic_block_p next = nullptr;     /*!< The next basic block in the doubly-linked list. */
+        basic_block_p prev = nullptr;     /*!< The previous basic block in the doubly-linked list. */
 
         /* Control Flow Graph */
-        std::vector<std::shared_ptr<basic_block>> successors;   //!< The basic block's predecessors in the CFG
-        std::vector<std::shared_ptr<basic_block>> predecessors; //!< The basic block's successors in the CFG
+        edges successors;   //!< The basic block's predecessors in the CFG
+        edges predecessors; //!< The basic block's successors in the CFG
 
         /* Dominance tree */
         
-        std::shared_ptr<basic_block> dominator = nullptr;     /*!< The immediate dominator of this basic block. */
+        basic_block_p dominator = nullptr;     /*!< The immediate dominator of this basic block. */
 };
 
 std::ostream& operator<<(std::ostream& stream, const basic_block& basic_block);
@@ -154,7 +160,7 @@ mtac::basic_block::iterator end(mtac::basic_block_p function);
 
 mtac::basic_block_p clone(mtac::Function& function, mtac::basic_block_p basic_block);
 
-void pretty_print(std::shared_ptr<const mtac::basic_block> block, std::ostream& stream);
+void pretty_print(mtac::basic_block_cp block, std::ostream& stream);
 
 } //end of mtac
 
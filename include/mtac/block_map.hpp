@@ -0,0 +1,72 @@
+//=======================================================================
+// Copyright Baptiste Wicht 2011-2016.
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#ifndef MTAC_BLOCK_MAP_H
+#define MTAC_BLOCK_MAP_H
+
+#include <vector>
+
+#include "mtac/basic_block.hpp"
+
+namespace eddic::mtac {
+
+/*!
+ * \class block_map
+ * \brief Values associated to the basic blocks of a single function.
+ *
+ * The values are stored in a vector indexed by the id of the blocks in the arena of their
+ * function instead of a hash map of the blocks. All the blocks must belong to the same function.
+ */
+template<typename T>
+class block_map {
+    public:
+        block_map() = default;
+
+        /*!
+         * Create a map able to hold the values of the given number of blocks without growing.
+         * \param size The number of ids given to the blocks of the function.
+         */
+        explicit block_map(std::size_t size){
+            values.reserve(size);
+            present.reserve(size);
+        }
+
+        /*!
+         * \brief Return the value of the block, creating a default value if necessary.
+         */
+        T& operator[](mtac::basic_block_cp block){
+            auto id = block->id;
+
+            if(id >= values.size()){
+                values.resize(id + 1);
+                present.resize(id + 1, false);
+            }
+
+            present[id] = true;
+            return values[id];
+        }
+
+        /*!
+         * \brief Return a pointer to the value of the block or nullptr if the block has no value.
+         */
+        const T* find(mtac::basic_block_cp block) const {
+            auto id = block->id;
+            return id < values.size() && present[id] ? &values[id] : nullptr;
+        }
+
+        bool contains(mtac::basic_block_cp block) const {
+            return find(block);
+        }
+
+    private:
+        std::vector<T> values;
+        std::vector<char> present;
+};
+
+} // namespace eddic::mtac
+
+#endif
@@ -45,8 +45,9 @@ struct call_graph_edge {
     call_graph_node_p source;
     call_graph_node_p target;
     std::size_t count;
+    std::size_t frequency;  //The number of executions of the calls in the profile
 
-    call_graph_edge(call_graph_node_p source, call_graph_node_p target) : source(source), target(target), count(0){
+    call_graph_edge(call_graph_node_p source, call_graph_node_p target) : source(source), target(target), count(0), frequency(0){
         //Nothing to init
     }
 };
@@ -71,8 +72,14 @@ class call_graph {
 
         call_graph_node_p node(eddic::Function& function);
 
-        void add_edge(eddic::Function& source, eddic::Function& target);
-        call_graph_edge_p edge(eddic::Function& source, eddic::Function& target);
+        call_graph_edge_p add_edge(eddic::Function& source, eddic::Function& target);
+
+        /*!
+         * Return the edge from source to target or nullptr if there is no such edge. Unlike node(), this never
+         * modifies the graph, so it can be used by the functions optimized in parallel. Both functions must
+         * already be nodes of the graph.
+         */
+        call_graph_edge_p edge(eddic::Function& source, eddic::Function& target) const;
 
         void compute_reachable();
         void release_reachable();
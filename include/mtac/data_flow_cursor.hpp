@@ -0,0 +1,108 @@
+//=======================================================================
+// Copyright Baptiste Wicht 2011-2016.
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#ifndef MTAC_DATA_FLOW_CURSOR_H
+#define MTAC_DATA_FLOW_CURSOR_H
+
+#include <memory>
+#include <vector>
+
+#include "mtac/GlobalOptimizations.hpp"
+
+namespace eddic::mtac {
+
+/*!
+ * \class data_flow_cursor
+ * \brief Give access to the data-flow values of the statements of a function.
+ *
+ * The solvers only store the values at the boundaries of the basic blocks. The values
+ * of the statements are computed on demand by replaying the transfer function of the
+ * problem inside the block. The values of the last replayed block are cached, so the
+ * statements of a block should be queried together. The values are indexed by the
+ * position of the statements at the time the block is replayed.
+ */
+template<typename Problem>
+class data_flow_cursor {
+    public:
+        typedef typename Problem::ProblemDomain Domain;
+
+        data_flow_cursor(Problem& problem, std::shared_ptr<DataFlowResults<Domain>> results) : problem(problem), results(std::move(results)) {}
+
+        /*!
+         * \brief Return the value before the ith statement of the given block.
+         */
+        const Domain& in(const mtac::basic_block_p& block, std::size_t i){
+            replay(block);
+
+            return points[i];
+        }
+
+        /*!
+         * \brief Return the value after the ith statement of the given block.
+         */
+        const Domain& out(const mtac::basic_block_p& block, std::size_t i){
+            replay(block);
+
+            return points[i + 1];
+        }
+
+    private:
+        static const Domain& boundary(const mtac::block_map<Domain>& values, const mtac::basic_block_p& block){
+            static const Domain top;
+
+            auto value = values.find(block);
+            return value ? *value : top;
+        }
+
+        void replay(const mtac::basic_block_p& block){
+            if(block == current){
+                return;
+            }
+
+            current = block;
+
+            auto& statements = get_statements<Problem::Low>(current);
+
+            points.clear();
+
+            //points[i] is the value before the ith statement and points[i + 1] the value after it
+            if constexpr (Problem::Type == DataFlowType::Fast_Forward) {
+                points.push_back(boundary(results->IN, block));
+
+                for(auto& statement : statements){
+                    points.push_back(points.back());
+
+                    if(!points.back().top()){
+                        problem.transfer(current, statement, points.back());
+                    }
+                }
+            } else {
+                static_assert(Problem::Type == DataFlowType::Fast_Backward, "Only the statement problems can be replayed");
+
+                points.resize(statements.size() + 1);
+                points.back() = boundary(results->OUT, block);
+
+                for(std::size_t i = statements.size(); i > 0; --i){
+                    points[i - 1] = points[i];
+
+                    if(!points[i - 1].top()){
+                        problem.transfer(current, statements[i - 1], points[i - 1]);
+                    }
+                }
+            }
+        }
+
+        Problem& problem;
+        std::shared_ptr<DataFlowResults<Domain>> results;
+
+        mtac::basic_block_p current = nullptr;
+        std::vector<Domain> points;
+};
+
+} // namespace eddic::mtac
+
+#endif
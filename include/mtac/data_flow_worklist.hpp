@@ -0,0 +1,69 @@
+//=======================================================================
+// Copyright Baptiste Wicht 2011-2016.
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#ifndef MTAC_DATA_FLOW_WORKLIST_H
+#define MTAC_DATA_FLOW_WORKLIST_H
+
+#include <functional>
+#include <queue>
+#include <vector>
+
+#include "mtac/forward.hpp"
+#include "mtac/block_map.hpp"
+
+namespace eddic::mtac {
+
+/*!
+ * \brief Compute the post-order of the CFG of the function, starting from ENTRY.
+ *
+ * Only the blocks reachable from ENTRY are part of the post-order.
+ * \param function The function to order.
+ * \return The reachable basic blocks in post-order.
+ */
+std::vector<mtac::basic_block_p> post_order(mtac::Function & function);
+
+/*!
+ * \class data_flow_worklist
+ * \brief The worklist of the basic blocks still to be processed by a data-flow solver.
+ *
+ * The blocks are always popped in the visit order of the problem: reverse
+ * post-order for forward problems and post-order for backward problems. The
+ * blocks not reachable from ENTRY are visited last, in layout order. A block is
+ * never twice in the worklist.
+ */
+class data_flow_worklist {
+    public:
+        /*!
+         * Create a worklist containing all the blocks of the function, except the boundary block
+         * (ENTRY for forward problems, EXIT for backward problems).
+         * \param function The function on which the data-flow problem is solved.
+         * \param forward Indicates if the problem is a forward problem.
+         */
+        data_flow_worklist(mtac::Function & function, bool forward);
+
+        bool empty() const;
+
+        mtac::basic_block_p pop();
+        void push(const mtac::basic_block_p & block);
+
+        /*!
+         * \brief Report the number of blocks that have been processed in the statistics.
+         * \param function The function on which the data-flow problem has been solved.
+         */
+        void report(mtac::Function & function) const;
+
+    private:
+        std::vector<mtac::basic_block_p> order;
+        mtac::block_map<std::size_t> position;
+        std::vector<char> queued;
+        std::priority_queue<std::size_t, std::vector<std::size_t>, std::greater<>> queue;
+        std::size_t iterations = 0;
+};
+
+} // namespace eddic::mtac
+
+#endif
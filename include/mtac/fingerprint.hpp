@@ -0,0 +1,69 @@
+//=======================================================================
+// Copyright Baptiste Wicht 2011-2016.
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#ifndef MTAC_FINGERPRINT_H
+#define MTAC_FINGERPRINT_H
+
+#include <unordered_map>
+#include <vector>
+
+#include "mtac/forward.hpp"
+#include "mtac/Argument.hpp"
+
+namespace eddic {
+
+class Function;
+
+namespace mtac {
+
+/*!
+ * \brief The purity of the functions of a program, indexed by their definition.
+ */
+typedef std::unordered_map<const eddic::Function*, bool> purity_summary;
+
+/*!
+ * \brief Compute the purity summary of all the functions of the program.
+ * \param program The program.
+ * \return The purity of each function of the program.
+ */
+purity_summary summarize_purity(mtac::Program& program);
+
+/*!
+ * \struct function_fingerprint
+ * \brief A structural snapshot of a function.
+ *
+ * The snapshot keeps the structure of the function and the arguments of its statements, two
+ * fingerprints are only equal if the functions are identical, the hash only speeds up the
+ * comparison of different functions.
+ */
+struct function_fingerprint {
+    std::size_t hash = 0;
+    std::vector<std::size_t> structure;
+    std::vector<mtac::Argument> arguments;
+
+    bool operator==(const function_fingerprint& rhs) const;
+};
+
+/*!
+ * \brief Compute a fingerprint of the given function.
+ *
+ * The fingerprint covers the statements and the CFG of the function, the position types of the
+ * variables it uses (a global becoming const changes it) as well as the purity of the functions it
+ * calls. If the fingerprint of a function did not change, the optimizations will find the same
+ * things in it.
+ *
+ * \param function The function to fingerprint.
+ * \param purity The purity of the functions of the program.
+ * \return The fingerprint of the function.
+ */
+function_fingerprint fingerprint(mtac::Function& function, const purity_summary& purity);
+
+} //end of mtac
+
+} //end of eddic
+
+#endif
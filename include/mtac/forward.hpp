@@ -17,9 +17,10 @@ namespace eddic::mtac {
 struct Program;
 class Function;
 
+//The basic blocks are owned by the arena of their function
 class basic_block;
-using basic_block_p  = std::shared_ptr<mtac::basic_block>;
-using basic_block_cp = std::shared_ptr<const mtac::basic_block>;
+using basic_block_p  = mtac::basic_block *;
+using basic_block_cp = const mtac::basic_block *;
 
 struct Quadruple;
 
@@ -12,6 +12,8 @@
 #include <memory>
 
 #include "variant.hpp"
+#include "interned_string.hpp"
+#include "variable_ref.hpp"
 
 #include "mtac/pass_traits.hpp"
 #include "mtac/DataFlowProblem.hpp"
@@ -23,7 +25,7 @@ class Variable;
 
 namespace mtac {
 
-typedef boost::variant<std::string, double, int, std::shared_ptr<Variable>> ConstantValue;
+typedef boost::variant<interned_string, double, int, variable_ref> ConstantValue;
 
 class ConstantPropagationLattice {
     public:
@@ -68,7 +70,7 @@ class ConstantPropagationLattice {
         boost::optional<ConstantValue> m_value;
 };
 
-typedef std::unordered_map<std::shared_ptr<Variable>, ConstantPropagationLattice> ConstantPropagationValues;
+typedef std::unordered_map<variable_ref, ConstantPropagationLattice> ConstantPropagationValues;
 
 class ConstantPropagationProblem {
     public:
@@ -49,8 +49,8 @@ class global_cse {
         std::unordered_set<std::size_t> optimized;
         mtac::Function* function;
 
-        std::unordered_map<mtac::basic_block_p, std::set<mtac::expression>> Eval;
-        std::unordered_map<mtac::basic_block_p, std::set<mtac::expression>> Kill;
+        mtac::block_map<std::set<mtac::expression>> Eval;
+        mtac::block_map<std::set<mtac::expression>> Kill;
 };
 
 template<>
@@ -18,6 +18,7 @@
 
 #include "variant.hpp"
 #include "Platform.hpp"
+#include "variable_ref.hpp"
 
 #include "mtac/pass_traits.hpp"
 #include "mtac/DataFlowProblem.hpp"
@@ -30,7 +31,7 @@ struct StringPool;
 
 namespace mtac {
 
-typedef boost::variant<std::string, double, int, std::shared_ptr<Variable>> OffsetConstantValue;
+typedef boost::variant<std::string, double, int, variable_ref> OffsetConstantValue;
 typedef std::unordered_map<Offset, OffsetConstantValue, mtac::OffsetHash> OffsetConstantPropagationValues;
 
 class OffsetConstantPropagationProblem {
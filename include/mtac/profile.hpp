@@ -0,0 +1,52 @@
+//=======================================================================
+// Copyright Baptiste Wicht 2011-2016.
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#ifndef MTAC_PROFILE_H
+#define MTAC_PROFILE_H
+
+#include <string>
+
+#include "mtac/forward.hpp"
+
+namespace eddic::mtac {
+
+/*!
+ * \brief Instrument the program to count the executions of each of its basic blocks. 
+ *
+ * A counter increment is added at the beginning of each basic block and in a new block executed once
+ * per invocation of each function. The counters are written to the given file when the program exits.
+ * Must be called right after the extraction of the basic blocks. 
+ * \param program The program to instrument. 
+ * \param file The file the instrumented program writes its counters to. 
+ */
+void instrument_program(mtac::Program& program, const std::string& file);
+
+/*!
+ * \brief Load the frequencies of the basic blocks from a profile written by an instrumented program. 
+ *
+ * The basic blocks are numbered in the same order as by instrument_program, so the source must not have 
+ * changed since the profile was generated. Must be called right after the extraction of the basic blocks. 
+ * \param program The program to annotate. 
+ * \param file The profile file. 
+ * \return true if the profile has been loaded, false if it does not match the program. 
+ */
+bool annotate_program(mtac::Program& program, const std::string& file);
+
+/*!
+ * \brief Return the estimated number of executions of the basic block for one invocation of its function. 
+ *
+ * The estimation comes from the profile if the function has been profiled, otherwise each loop level 
+ * is considered to multiply the executions by ten. 
+ * \param function The function containing the basic block. 
+ * \param bb The basic block. 
+ * \return The estimated number of executions, at least one. 
+ */
+std::size_t block_weight(mtac::Function& function, mtac::basic_block_cp bb);
+
+} // namespace eddic::mtac
+
+#endif
@@ -0,0 +1,84 @@
+//=======================================================================
+// Copyright Baptiste Wicht 2011-2016.
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#ifndef MTAC_VARIABLE_NUMBERING_H
+#define MTAC_VARIABLE_NUMBERING_H
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "variable_ref.hpp"
+
+#include "mtac/forward.hpp"
+
+namespace eddic {
+
+class Variable;
+
+namespace mtac {
+
+/*!
+ * \class variable_numbering
+ * \brief A dense numbering of the variables of a function.
+ *
+ * Each variable used in the function is given an index in [0, size()). This
+ * numbering can be used to represent sets of variables as bit vectors.
+ */
+class variable_numbering {
+    public:
+        variable_numbering() = default;
+
+        /*!
+         * Number all the variables used by the statements of the function.
+         * \param function The function to number.
+         */
+        explicit variable_numbering(mtac::Function& function);
+
+        /*!
+         * \brief Return the index of the variable, numbering it if necessary.
+         * \param variable The variable to number.
+         * \return The index of the variable.
+         */
+        std::size_t add(variable_ref variable);
+
+        /*!
+         * \brief Return the index of an already numbered variable.
+         * \n\n \b Complexity : O(1)
+         * \param variable The variable to search for.
+         * \return The index of the variable.
+         */
+        std::size_t index(variable_ref variable) const;
+
+        bool contains(variable_ref variable) const;
+
+        const std::shared_ptr<Variable>& variable(std::size_t index) const;
+
+        /*!
+         * \brief Return the number of variables numbered.
+         * \return The number of variables.
+         */
+        std::size_t size() const;
+
+        /*!
+         * \brief Create a bit vector that can hold a set of the numbered variables.
+         * \return An empty bit vector.
+         */
+        boost::dynamic_bitset<> empty_set() const;
+
+    private:
+        std::unordered_map<variable_ref, std::size_t> indices;
+        std::vector<variable_ref> variables;
+};
+
+} //end of mtac
+
+} //end of eddic
+
+#endif
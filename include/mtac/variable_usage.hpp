@@ -11,6 +11,8 @@
 #include <unordered_map>
 
 #include "mtac/pass_traits.hpp"
+#include "variable_ref.hpp"
+
 #include "mtac/forward.hpp"
 #include "mtac/loop.hpp"
 
@@ -18,7 +20,7 @@ namespace eddic {
 
 namespace mtac {
 
-typedef std::unordered_map<std::shared_ptr<Variable>, unsigned int> VariableUsage;
+typedef std::unordered_map<variable_ref, unsigned int> VariableUsage;
 
 struct Usage {
     VariableUsage written;
@@ -0,0 +1,40 @@
+//=======================================================================
+// Copyright Baptiste Wicht 2011-2016.
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <functional>
+
+namespace eddic {
+
+/*!
+ * \brief Return the number of worker threads that can be used by the compiler.
+ * \return The number of hardware threads, at least 1.
+ */
+std::size_t hardware_threads();
+
+/*!
+ * \brief Execute task(i) for each i in [0, n) using at most threads workers.
+ *
+ * The tasks are distributed in per-worker deques. A worker takes its tasks from
+ * the back of its own deque and steals from the front of the other deques once
+ * its own is empty. The call returns only once every task has been executed, it
+ * can therefore be used as a barrier.
+ *
+ * With a single worker (or a single task), the tasks are executed in order on
+ * the calling thread.
+ *
+ * \param n The number of tasks.
+ * \param threads The maximum number of workers.
+ * \param task The function to execute for each task index.
+ */
+void parallel_for(std::size_t n, std::size_t threads, const std::function<void(std::size_t)>& task);
+
+} //end of eddic
+
+#endif
@@ -25,6 +25,12 @@ namespace parser_x3 {
  * using a Boost Spirit parser and a set of grammars describing the EDDI language.
  */
 struct SpiritParser {
+    /*!
+     * \brief Construct a SpiritParser.
+     * \param header_cache Indicates if the standard headers can be loaded from the on-disk AST cache.
+     */
+    explicit SpiritParser(bool header_cache = false);
+
     /*!
      * \brief Parse the given source file and fills the given Abstract Syntax Tree.
      * \param file The path to the file to parse.
@@ -32,6 +38,24 @@ struct SpiritParser {
      * \return true if the file was valid, false otherwise
      */
     bool parse(const std::string& file, ast::SourceFile& program, GlobalContext & context);
+
+    /*!
+     * \brief Parse the given source file and fills the given Abstract Syntax Tree, without printing anything.
+     *
+     * This function can be called concurrently by several threads on the same context. If the header
+     * cache is enabled, the standard headers are loaded from the cache when they did not change and
+     * stored in the cache otherwise.
+     *
+     * \param file The path to the file to parse.
+     * \param program The Abstract Syntax Tree root to fill.
+     * \param header Indicates if the file is a standard header.
+     * \param errors The stream where the syntax errors are written.
+     * \return true if the file was valid, false otherwise
+     */
+    bool parse(const std::string& file, ast::SourceFile& program, GlobalContext & context, bool header, std::ostream& errors);
+
+private:
+    bool header_cache;
 };
 
 }
@@ -0,0 +1,57 @@
+//=======================================================================
+// Copyright Baptiste Wicht 2011-2016.
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#ifndef PARSER_X3_AST_CACHE_H
+#define PARSER_X3_AST_CACHE_H
+
+#include <string>
+#include <string_view>
+
+#include "ast/SourceFile.hpp"
+
+namespace eddic {
+
+struct GlobalContext;
+
+namespace parser_x3 {
+
+/*!
+ * \brief Load the AST of a source file from the on-disk cache.
+ *
+ * The cache entries are keyed by the content of the file and by the build id of the compiler. The
+ * content of the file must already be registered in the error handler of the context, the
+ * positions of the AST are tagged again in it.
+ *
+ * \param file The path to the source file.
+ * \param id_file The index of the file in the error handler.
+ * \param contents The content of the source file.
+ * \param program The Abstract Syntax Tree root to fill.
+ * \param context The global context.
+ * \return true if the AST was in the cache, false otherwise.
+ */
+bool load_cached_ast(const std::string& file, int id_file, std::string_view contents, ast::SourceFile& program, GlobalContext& context);
+
+/*!
+ * \brief Store the freshly parsed AST of a source file in the on-disk cache.
+ *
+ * The AST must not have been modified since parsing. Failing to write the cache is not an error.
+ * The other entries of the same file stem written by the same build of the compiler are removed, the
+ * entries are never evicted otherwise.
+ *
+ * \param file The path to the source file.
+ * \param id_file The index of the file in the error handler.
+ * \param contents The content of the source file.
+ * \param program The Abstract Syntax Tree root.
+ * \param context The global context.
+ */
+void store_cached_ast(const std::string& file, int id_file, std::string_view contents, const ast::SourceFile& program, GlobalContext& context);
+
+} //end of parser_x3
+
+} //end of eddic
+
+#endif
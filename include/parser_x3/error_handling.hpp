@@ -10,6 +10,7 @@
 
 #include <string>
 #include <memory>
+#include <mutex>
 #include <iostream> //Temporary
 
 #include "boost_cfg.hpp"
@@ -45,37 +46,71 @@ namespace x3_grammar {
     template <typename Iterator>
     using error_handler = boost::spirit::x3::error_handler<Iterator>;
 
-    typedef std::string::const_iterator iterator_type;
+    typedef const char* iterator_type;
     typedef boost::spirit::x3::phrase_parse_context<boost::spirit::x3::ascii::space_type>::type phrase_context_type;
     typedef error_handler<iterator_type> error_handler_type;
 
+    /*!
+     * \brief The error handlers of all the source files of the program.
+     *
+     * The files can be registered concurrently by several parsers. Each file is
+     * then parsed through its own file_error_handler.
+     */
     struct global_error_handler {
-        void register_handler(iterator_type it, iterator_type end, std::string file){
-            error_handlers.emplace_back(it, end, std::cerr, std::move(file));
-        }
+        /*!
+         * \brief Register a new source file.
+         * \return The index of the file, used as id_file by its AST nodes.
+         */
+        int register_handler(iterator_type it, iterator_type end, std::string file);
+
+        /*!
+         * \brief Return the error handler of the given file.
+         */
+        error_handler_type& handler(int file);
+
+        /*!
+         * \brief Return the offsets of the positions tagged in the given file.
+         */
+        std::vector<std::size_t> positions(int file);
+
+        /*!
+         * \brief Tag again the given offsets in the given file, in the same order.
+         *
+         * This gives back the same position ids than when the file was parsed.
+         */
+        void restore_positions(int file, const std::vector<std::size_t>& offsets);
 
-        error_handler_type& current(){
-            return error_handlers.back();
-        }
+        void operator()(const boost::spirit::x3::file_position_tagged& t, const std::string& message);
+
+        std::string to_string(const boost::spirit::x3::file_position_tagged& t, const std::string& message = "");
+
+        void semantical_exception(const std::string& message, const boost::spirit::x3::file_position_tagged& t);
+
+    private:
+        std::mutex mutex;
+        std::vector<std::unique_ptr<error_handler_type>> error_handlers;
+    };
+
+    /*!
+     * \brief The error handler used by the grammar while parsing a single file.
+     *
+     * The syntax errors are written to the given stream so that the errors of the
+     * files parsed concurrently can be printed in a deterministic order.
+     */
+    struct file_error_handler {
+        error_handler_type& handler;
+        int file;
+        std::ostream& errors;
 
         template<typename AST>
         void tag(AST& t, iterator_type it, iterator_type end){
             if constexpr (std::is_base_of_v<boost::spirit::x3::file_position_tagged, AST>) {
-                t.id_file = error_handlers.size() - 1;
-                error_handlers[t.id_file].tag(t, it, end);
+                t.id_file = file;
+                handler.tag(t, it, end);
             }
         }
 
         void operator()(iterator_type err_pos, const std::string& message);
-        void operator()(iterator_type err_pos, iterator_type err_last, const std::string& message);
-        void operator()(const boost::spirit::x3::file_position_tagged& t, const std::string& message);
-
-        std::string to_string(const boost::spirit::x3::file_position_tagged& t, const std::string& message = "");
-
-        void semantical_exception(const std::string& message, const boost::spirit::x3::file_position_tagged& t);
-
-    private:
-        std::vector<error_handler_type> error_handlers;
     };
 
     // tag used to get our error handler from the context
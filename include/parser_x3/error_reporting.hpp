@@ -106,6 +106,14 @@ struct error_handler {
         return pos_cache.position_of(pos);
     }
 
+    std::vector<Iterator> const& positions() const {
+        return pos_cache.get_positions();
+    }
+
+    Iterator first() const {
+        return pos_cache.first();
+    }
+
 private:
 
     void print_file_line(std::ostream& stream, std::size_t line) const {
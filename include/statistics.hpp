@@ -10,15 +10,23 @@
 
 #include <unordered_map>
 #include <string>
+#include <mutex>
 
 namespace eddic {
 
+/*!
+ * \class statistics
+ * \brief Named counters of the compiler.
+ *
+ * The counters can be incremented concurrently by the optimization workers.
+ */
 class statistics {
     public:
         using Counters = std::unordered_map<std::string, std::size_t>;
         using iterator = Counters::const_iterator;
 
         void inc_counter(const std::string& a);
+        void inc_counter(const std::string& a, std::size_t value);
         std::size_t counter(const std::string& a) const;
         std::size_t counter_safe(const std::string& a) const;
 
@@ -27,6 +35,7 @@ class statistics {
 
     private:
         Counters counters;
+        mutable std::mutex mutex;
 };
 
 } //end of eddic
@@ -9,31 +9,112 @@
 #define TIMING_H
 
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include "Options.hpp"
 #include "StopWatch.hpp"
 
 namespace eddic {
 
+class statistics;
+
+/*!
+ * \struct trace_event
+ * \brief A timed event of the trace, in microseconds since the creation of the timing system.
+ */
+struct trace_event {
+    std::string name;
+    std::string detail;     //The function or the iteration the event is about, can be empty
+    std::size_t thread;
+    double start;
+    double duration;
+};
+
+/*!
+ * \class timing_system
+ * \brief Accumulate the time spent in each named phase of the compiler.
+ *
+ * Timings can be registered concurrently by the optimization workers, in which
+ * case the time of a phase is the sum of the time spent by each worker.
+ *
+ * When the trace is enabled, each timer is also recorded as an event, with its
+ * nesting, its thread and its detail, to be exported in the Chrome trace format.
+ */
 class timing_system {
     public:
+        using Timings = std::unordered_map<std::string, double>;
+        using iterator = Timings::const_iterator;
+
+        timing_system();
+
         void register_timing(std::string name, double time);
         void display();
 
+        iterator begin() const;
+        iterator end() const;
+
+        void enable_trace();
+        bool tracing() const;
+
+        void register_event(std::string name, std::string detail, Clock::time_point start, Clock::time_point end);
+
+        /*!
+         * \brief Write the events and the given counters to a JSON file in the Chrome trace format. 
+         * \param file The path to the file. 
+         * \param stats The counters to include in the trace. 
+         */
+        void write_trace(const std::string& file, const statistics& stats);
+
     private:
-        std::unordered_map<std::string, double> timings;
+        Timings timings;
+        std::mutex mutex;
+
+        bool trace = false;
+        Clock::time_point epoch;
+        std::vector<trace_event> events;
+        std::unordered_map<std::thread::id, std::size_t> threads;
 };
 
+/*!
+ * \class timing_timer
+ * \brief Time a phase of the compiler until the end of its scope. 
+ *
+ * The detail (for instance the function a pass is run on) is only used by the trace, the timings are accumulated by name.
+ */
 class timing_timer {
     public:
         timing_timer(timing_system& system, const std::string& name);
+        timing_timer(timing_system& system, const std::string& name, const std::string& detail);
         ~timing_timer();
 
     private:
         timing_system& system;
         std::string name;
-        StopWatch timer;
+        std::string detail;
+        Clock::time_point start;
+};
+
+/*!
+ * \class trace_timer
+ * \brief Record an event in the trace until the end of its scope, without accumulating its time. 
+ *
+ * This is used for the events that group other timers, like the iterations of a fixpoint loop.
+ * Nothing is recorded if the trace is not enabled.
+ */
+class trace_timer {
+    public:
+        trace_timer(timing_system& system, const std::string& name, const std::string& detail);
+        ~trace_timer();
+
+    private:
+        timing_system& system;
+        std::string name;
+        std::string detail;
+        Clock::time_point start;
 };
 
 } //end of eddic
@@ -0,0 +1,208 @@
+//=======================================================================
+// Copyright Baptiste Wicht 2011-2016.
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#ifndef VARIABLE_REF_H
+#define VARIABLE_REF_H
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+
+namespace eddic {
+
+class Variable;
+
+/*!
+ * \class variable_table
+ * \brief The table of all the variables of a compilation, indexed by a 32-bit id.
+ *
+ * The table owns the variables, they stay alive until the end of the compilation even if they
+ * are removed from their context. The ids are given at creation of the variables and are never
+ * reused. Adding a variable is thread-safe and the variables can be looked up concurrently
+ * without locking: the storage is made of chunks of growing size that are never moved.
+ *
+ * This is a memory trade-off: the quadruples are smaller and cheaper to copy, but the variables
+ * removed by the optimizer (inlined parameters, temporaries of dead code, ...) are no longer freed
+ * before the end of the compilation.
+ *
+ * The global context owns the table of a compilation. The variable_ref are resolved in the current
+ * table, which is set for the duration of a compilation with a variable_table::scope. The current
+ * table is shared by all the threads, the compilations cannot run concurrently.
+ */
+class variable_table {
+    public:
+        variable_table();
+        ~variable_table();
+
+        variable_table(const variable_table& rhs) = delete;
+        variable_table& operator=(const variable_table& rhs) = delete;
+
+        /*!
+         * Add the variable to the table and give it its id.
+         * \param variable The variable to add.
+         * \return The id of the variable.
+         */
+        uint32_t add(const std::shared_ptr<Variable>& variable);
+
+        const std::shared_ptr<Variable>& operator[](uint32_t id) const {
+            //The chunk k holds the ids in [base * (2^k - 1), base * (2^(k+1) - 1))
+            auto n = static_cast<uint64_t>(id) + base;
+            auto chunk = std::bit_width(n) - base_bits - 1;
+            return chunks[chunk][n - (base << chunk)];
+        }
+
+        /*!
+         * Return the number of ids given, including the null id.
+         */
+        std::size_t size() const;
+
+        /*!
+         * Return the table of the current compilation.
+         */
+        static variable_table& current(){
+            return *current_table;
+        }
+
+        /*!
+         * \class scope
+         * \brief Make a table the current one for the lifetime of the scope.
+         *
+         * The previous current table is restored at the end of the scope, the scopes must be nested.
+         */
+        class scope {
+            public:
+                explicit scope(variable_table& table);
+                ~scope();
+
+                scope(const scope& rhs) = delete;
+                scope& operator=(const scope& rhs) = delete;
+
+            private:
+                variable_table& table;
+                variable_table* previous;
+        };
+
+    private:
+        static constexpr uint32_t base_bits = 8;
+        static constexpr uint32_t base = 1U << base_bits;
+
+        //The chunks cover all the 32-bit ids
+        std::array<std::unique_ptr<std::shared_ptr<Variable>[]>, 33 - base_bits> chunks;
+
+        uint32_t next = 0;
+        mutable std::mutex mutex;
+
+        static variable_table* current_table;
+};
+
+/*!
+ * \class variable_ref
+ * \brief A reference to a variable by its id in the variable table.
+ *
+ * This is used by the intermediate representation instead of std::shared_ptr<Variable>. A
+ * reference is only 32 bits, copying and comparing it does not touch any reference count and it
+ * can be hashed directly. The id 0 is the null reference.
+ */
+class variable_ref {
+    public:
+        variable_ref() = default;
+        variable_ref(std::nullptr_t) {}
+        variable_ref(const std::shared_ptr<Variable>& variable);
+
+        uint32_t id() const {
+            return _id;
+        }
+
+        const std::shared_ptr<Variable>& shared() const {
+            return variable_table::current()[_id];
+        }
+
+        operator const std::shared_ptr<Variable>&() const {
+            return shared();
+        }
+
+        Variable* get() const {
+            return shared().get();
+        }
+
+        Variable* operator->() const {
+            return get();
+        }
+
+        Variable& operator*() const {
+            return *get();
+        }
+
+        explicit operator bool() const {
+            return _id != 0;
+        }
+
+        friend bool operator==(variable_ref lhs, variable_ref rhs){
+            return lhs._id == rhs._id;
+        }
+
+        friend bool operator!=(variable_ref lhs, variable_ref rhs){
+            return lhs._id != rhs._id;
+        }
+
+        friend bool operator==(variable_ref lhs, const std::shared_ptr<Variable>& rhs){
+            return lhs.get() == rhs.get();
+        }
+
+        friend bool operator==(const std::shared_ptr<Variable>& lhs, variable_ref rhs){
+            return lhs.get() == rhs.get();
+        }
+
+        friend bool operator!=(variable_ref lhs, const std::shared_ptr<Variable>& rhs){
+            return lhs.get() != rhs.get();
+        }
+
+        friend bool operator!=(const std::shared_ptr<Variable>& lhs, variable_ref rhs){
+            return lhs.get() != rhs.get();
+        }
+
+        friend bool operator==(variable_ref lhs, std::nullptr_t){
+            return lhs._id == 0;
+        }
+
+        friend bool operator!=(variable_ref lhs, std::nullptr_t){
+            return lhs._id != 0;
+        }
+
+        friend bool operator<(variable_ref lhs, variable_ref rhs){
+            return lhs._id < rhs._id;
+        }
+
+        friend std::size_t hash_value(variable_ref variable){
+            return variable._id;
+        }
+
+    private:
+        uint32_t _id = 0;
+};
+
+std::ostream& operator<<(std::ostream& stream, variable_ref variable);
+
+} //end of eddic
+
+namespace std {
+
+template<>
+struct hash<eddic::variable_ref> {
+    std::size_t operator()(eddic::variable_ref variable) const {
+        return variable.id();
+    }
+};
+
+} //end of std
+
+#endif
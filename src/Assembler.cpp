@@ -12,6 +12,9 @@
 #include "Utils.hpp"
 #include "SemanticalException.hpp"
 
+#include "asm/Encoder.hpp"
+#include "asm/ElfWriter.hpp"
+
 using namespace eddic;
 
 namespace {
@@ -70,6 +73,25 @@ void eddic::assemble(Platform platform, const std::string& s, const std::string&
    }
 }
 
+void eddic::assemble_integrated(Platform platform, std::string_view assembly, const std::string& output, bool verbose){
+    PerfsTimer timer("Integrated assembler");
+
+    if(verbose){
+        std::cout << "eddic : assemble into " << output << std::endl;
+    }
+
+    as::ObjectCode object;
+    std::string error;
+
+    if(!as::encode(platform, assembly, object, error)){
+        throw SemanticalException("Error: Unable to assemble: " + error);
+    }
+
+    if(!as::write_elf(platform, object, output, error)){
+        throw SemanticalException("Error: Unable to link " + output + ": " + error);
+    }
+}
+
 void eddic::verify_dependencies(){
     if(system("nasm -v >> /dev/null") != 0){
         throw SemanticalException("Error: Unable to use nasm");
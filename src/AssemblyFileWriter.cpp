@@ -5,24 +5,37 @@
 //  http://opensource.org/licenses/MIT)
 //=======================================================================
 
+#include <fstream>
+
 #include "AssemblyFileWriter.hpp"
 
 #include "SemanticalException.hpp"
 
 using namespace eddic;
 
-AssemblyFileWriter::AssemblyFileWriter(const std::string& path) {
-    m_stream.open(path.c_str());
-
-    if (!m_stream) {
-        throw SemanticalException("Unable to open the output file");
-    }
+AssemblyFileWriter::AssemblyFileWriter() {
+    //Most programs fit in this size, the larger ones grow the buffer geometrically
+    m_buffer.reserve(64 * 1024);
 }
 
-AssemblyFileWriter::~AssemblyFileWriter() {
+AssemblyFileWriter& AssemblyFileWriter::operator<<(double value) {
+    //Large enough for the fixed notation of any double
+    char buffer[328];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, 6);
+    m_buffer.append(buffer, result.ptr);
+    return *this;
 }
 
-std::ostream& AssemblyFileWriter::stream() {
-    return m_stream;
+std::string_view AssemblyFileWriter::buffer() const {
+    return m_buffer;
 }
 
+void AssemblyFileWriter::write(const std::string& path) const {
+    std::ofstream stream(path.c_str(), std::ios::binary);
+
+    if (!stream) {
+        throw SemanticalException("Unable to open the output file");
+    }
+
+    stream.write(m_buffer.data(), m_buffer.size());
+}
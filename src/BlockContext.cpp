@@ -36,7 +36,7 @@ std::shared_ptr<Variable> BlockContext::addVariable(const std::string& variable,
 
     auto val = visit(ast::GetConstantValue(), value);
 
-    return variables[variable] = std::make_shared<Variable>(variable, type, position, val);
+    return variables[variable] = make_variable(variable, type, position, val);
 }
 
 std::shared_ptr<Variable> BlockContext::new_temporary(std::shared_ptr<const Type> type){
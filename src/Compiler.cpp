@@ -27,6 +27,7 @@
 //Medium-level Three Address Code
 #include "mtac/Program.hpp"
 #include "mtac/BasicBlockExtractor.hpp"
+#include "mtac/profile.hpp"
 #include "mtac/Optimizer.hpp"
 #include "mtac/RegisterAllocation.hpp"
 #include "mtac/reference_resolver.hpp"
@@ -34,6 +35,27 @@
 
 using namespace eddic;
 
+namespace {
+
+//Measure the memory used by the quadruples of the MTAC program
+void collect_ir_statistics(mtac::Program& program){
+    std::size_t quadruples = 0;
+
+    for(auto& function : program.functions){
+        for(auto& block : function){
+            quadruples += block->statements.size();
+        }
+    }
+
+    auto& stats = program.context.stats();
+
+    stats.inc_counter("mtac_quadruples", quadruples);
+    stats.inc_counter("mtac_quadruple_bytes", quadruples * sizeof(mtac::Quadruple));
+    stats.inc_counter("mtac_quadruple_size", sizeof(mtac::Quadruple));
+}
+
+} //end of anonymous namespace
+
 int Compiler::compile(const std::string& file, const std::shared_ptr<Configuration> & configuration) {
     if(!configuration->option_defined("quiet")){
         std::cout << "Compile " << file << '\n';
@@ -73,12 +95,22 @@ void Compiler::setup_context(Platform platform) {
     context = std::make_unique<GlobalContext>(platform);
 }
 
+GlobalContext& Compiler::global_context() {
+    return *context;
+}
+
 int Compiler::compile_only(const std::string& file, Platform platform, const std::shared_ptr<Configuration> & configuration) {
     int code = 0;
 
+    setup_context(platform);
+
+    variable_table::scope variables(context->variables_table());
+
     std::unique_ptr<mtac::Program> program;
 
-    setup_context(platform);
+    if(configuration->option_defined("time-trace")){
+        context->timing().enable_trace();
+    }
 
     try {
         //Make sure that the file exists
@@ -126,10 +158,17 @@ int Compiler::compile_only(const std::string& file, Platform platform, const std
         program->context.timing().display();
     }
 
+    //The trace is also written when the compilation fails, to find where the time was spent
+    if(configuration->option_defined("time-trace")){
+        context->timing().write_trace(configuration->option_value("time-trace"), context->stats());
+    }
+
     return code;
 }
 
 std::unique_ptr<mtac::Program> Compiler::compile_mtac(const std::string& file, Platform platform, const std::shared_ptr<Configuration> & configuration, FrontEnd& front_end){
+    variable_table::scope variables(context->variables_table());
+
     front_end.set_configuration(configuration);
 
     auto program = front_end.compile(file, platform, *context);
@@ -141,6 +180,17 @@ std::unique_ptr<mtac::Program> Compiler::compile_mtac(const std::string& file, P
         //Separate into basic blocks
         mtac::extract_basic_blocks(*program);
 
+        //The basic blocks are profiled before any optimization, in the order they are extracted
+        if(configuration->option_defined("fprofile-generate")){
+            mtac::instrument_program(*program, configuration->option_value("fprofile-generate"));
+        } else if(configuration->option_defined("fprofile-use")){
+            mtac::annotate_program(*program, configuration->option_value("fprofile-use"));
+        }
+
+        if(configuration->option_defined("stats")){
+            collect_ir_statistics(*program);
+        }
+
         //If asked by the user, print the Three Address code representation before optimization
         if(configuration->option_defined("mtac-opt")){
             std::cout << *program << '\n';
@@ -168,6 +218,8 @@ std::unique_ptr<mtac::Program> Compiler::compile_mtac(const std::string& file, P
 }
 
 void Compiler::compile_ltac(mtac::Program& program, Platform platform, const std::shared_ptr<Configuration> & configuration, FrontEnd& front_end){
+    variable_table::scope variables(context->variables_table());
+
     //Compute the definitive reachable flag for functions
     program.cg.compute_reachable();
 
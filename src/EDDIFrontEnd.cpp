@@ -5,6 +5,8 @@
 //  http://opensource.org/licenses/MIT)
 //=======================================================================
 
+#include <iostream>
+
 #include "EDDIFrontEnd.hpp"
 #include "SemanticalException.hpp"
 #include "Options.hpp"
@@ -12,6 +14,7 @@
 #include "Type.hpp"
 #include "GlobalContext.hpp"
 #include "PerfsTimer.hpp"
+#include "parallel.hpp"
 
 #include "parser_x3/SpiritParser.hpp"
 
@@ -33,7 +36,7 @@ std::unique_ptr<mtac::Program> EDDIFrontEnd::compile(const std::string& file, Pl
     ast::SourceFile source(context);
 
     //Parse the file into the program
-    parser_x3::SpiritParser parser;
+    parser_x3::SpiritParser parser(!configuration->option_defined("no-header-cache"));
     bool parsing = parser.parse(file, source, context);
 
     //If the parsing was successfully
@@ -41,7 +44,8 @@ std::unique_ptr<mtac::Program> EDDIFrontEnd::compile(const std::string& file, Pl
         set_string_pool(std::make_shared<StringPool>());
 
         //Read dependencies
-        resolveDependencies(source, parser);
+        std::size_t threads = configuration->option_defined("single-threaded") ? 1 : hardware_threads();
+        resolveDependencies(source, parser, threads);
 
         //If the user asked for it, print the Abstract Syntax Tree coming from the parser
         if(configuration->option_defined("ast-raw")){
@@ -52,6 +56,11 @@ std::unique_ptr<mtac::Program> EDDIFrontEnd::compile(const std::string& file, Pl
         //AST Passes
         generate_program(source, configuration, platform, pool);
 
+        //If the user asked for it, print the layout of the structures
+        if(configuration->option_defined("struct-layouts")){
+            context.print_struct_layouts(std::cout);
+        }
+
         //If the user asked for it, print the Abstract Syntax Tree
         if(configuration->option_defined("ast") || configuration->option_defined("ast-only")){
             ast::Printer printer;
@@ -55,12 +55,12 @@ std::shared_ptr<Variable> FunctionContext::newParameter(const std::string& varia
 
     currentParameter += type->size();
 
-    return std::make_shared<Variable>(variable, type, position);
+    return make_variable(variable, type, position);
 }
 
 std::shared_ptr<Variable> FunctionContext::newVariable(const std::string& variable,
                                                        const std::shared_ptr<const Type>& type) {
-    auto var = std::make_shared<Variable>(variable, type, Position(PositionType::VARIABLE));
+    auto var = make_variable(variable, type, Position(PositionType::VARIABLE));
 
     storage.push_back(var);
 
@@ -81,7 +81,7 @@ std::shared_ptr<Variable> FunctionContext::newVariable(const std::shared_ptr<Var
     if(source->position().is_temporary()){
         const Position position(PositionType::TEMPORARY);
 
-        auto var = std::make_shared<Variable>(name, source->type(), position);
+        auto var = make_variable(name, source->type(), position);
         storage.push_back(var);
         return variables[name] = var;
     }
@@ -95,7 +95,7 @@ std::shared_ptr<Variable> FunctionContext::addVariable(const std::string& variab
 
     auto val = visit(ast::GetConstantValue(), value);
 
-    auto var = std::make_shared<Variable>(variable, type, position, val);
+    auto var = make_variable(variable, type, position, val);
     return variables[variable] = var;
 }
 
@@ -115,7 +115,7 @@ std::shared_ptr<Variable> FunctionContext::new_temporary(std::shared_ptr<const T
     const Position position(PositionType::TEMPORARY);
 
     const std::string name = "t_" + toString(temporary++);
-    auto var = std::make_shared<Variable>(name, type, position);
+    auto var = make_variable(name, type, position);
     storage.push_back(var);
     return variables[name] = var;
 }
@@ -123,7 +123,7 @@ std::shared_ptr<Variable> FunctionContext::new_temporary(std::shared_ptr<const T
 std::shared_ptr<Variable> FunctionContext::new_reference(const std::shared_ptr<const Type>& type,
                                                          const std::shared_ptr<Variable>& var, const Offset& offset) {
     const std::string name = "t_" + toString(temporary++);
-    auto variable = std::make_shared<Variable>(name, type, var, offset);
+    auto variable = make_variable(name, type, var, offset);
     storage.push_back(variable);
     return variables[name] = variable;
 }
@@ -5,6 +5,9 @@
 //  http://opensource.org/licenses/MIT)
 //=======================================================================
 
+#include <algorithm>
+#include <ostream>
+
 #include "cpp_utils/assert.hpp"
 
 #include "GlobalContext.hpp"
@@ -20,14 +23,30 @@
 using namespace eddic;
         
 GlobalContext::GlobalContext(Platform platform) : Context(nullptr, *this), platform(platform) {
+    //The global variables are added to the table of this context
+    variable_table::scope scope(m_variables);
+
     Val zero = 0;
 
-    variables["_mem_start"] = std::make_shared<Variable>("_mem_start", INT, Position(PositionType::GLOBAL, "_mem_start"), zero);
-    variables["_mem_last"] = std::make_shared<Variable>("_mem_last", INT, Position(PositionType::GLOBAL, "_mem_last"), zero);
+    //State of the runtime allocator: bump pointer and end of the current chunk, free list of the large blocks
+    variables["_mem_top"] = make_variable("_mem_top", INT, Position(PositionType::GLOBAL, "_mem_top"), zero);
+    variables["_mem_end"] = make_variable("_mem_end", INT, Position(PositionType::GLOBAL, "_mem_end"), zero);
+    variables["_mem_large"] = make_variable("_mem_large", INT, Position(PositionType::GLOBAL, "_mem_large"), zero);
+
+    //Free lists of the small size classes
+    variables["_mem_bins"] = make_variable("_mem_bins", new_array_type(INT, 65), Position(PositionType::GLOBAL, "_mem_bins"));
+    
+    //Output buffer of the print functions (4096 bytes)
+    variables["_out_size"] = make_variable("_out_size", INT, Position(PositionType::GLOBAL, "_out_size"), zero);
+    variables["_out_buffer"] = make_variable("_out_buffer", new_array_type(INT, platform == Platform::INTEL_X86_64 ? 512 : 1024), Position(PositionType::GLOBAL, "_out_buffer"));
     
     //In order to not display a warning
-    variables["_mem_start"]->add_reference();
-    variables["_mem_last"]->add_reference();      
+    variables["_mem_top"]->add_reference();
+    variables["_mem_end"]->add_reference();      
+    variables["_mem_large"]->add_reference();
+    variables["_mem_bins"]->add_reference();
+    variables["_out_size"]->add_reference();
+    variables["_out_buffer"]->add_reference();
 
     defineStandardFunctions();
 }
@@ -42,7 +61,7 @@ std::shared_ptr<Variable> GlobalContext::addVariable(const std::string& variable
 
     Position position(PositionType::GLOBAL, variable);
     
-    return variables[variable] = std::make_shared<Variable>(variable, type, position);
+    return variables[variable] = make_variable(variable, type, position);
 }
 
 std::shared_ptr<Variable> GlobalContext::generate_variable(const std::string&, std::shared_ptr<const Type>){
@@ -54,11 +73,11 @@ std::shared_ptr<Variable> GlobalContext::addVariable(const std::string& variable
      
     if(type->is_const()){
         Position position(PositionType::CONST);
-        return variables[variable] = std::make_shared<Variable>(variable, type, position, val);
+        return variables[variable] = make_variable(variable, type, position, val);
     }
 
     Position position(PositionType::GLOBAL, variable);
-    return variables[variable] = std::make_shared<Variable>(variable, type, position, val);
+    return variables[variable] = make_variable(variable, type, position, val);
 }
 
 Function& GlobalContext::add_function(std::shared_ptr<const Type> ret, const std::string& name, const std::string& mangled_name){
@@ -131,55 +150,149 @@ std::shared_ptr<Struct> GlobalContext::get_struct(std::shared_ptr<const Type> ty
     return get_struct(struct_name);
 }
 
-int GlobalContext::member_offset(std::shared_ptr<const Struct> struct_, const std::string& member) const {
+namespace {
+
+int align(int offset, int alignment){
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+} //end of anonymous namespace
+
+const StructLayout& GlobalContext::layout(std::shared_ptr<const Struct> struct_) const {
+    //The layouts are computed when the structures are collected, the lookups do not lock
+    auto it = layouts.find(struct_.get());
+
+    if(it != layouts.end() && it->second.members == struct_->members.size()){
+        return it->second;
+    }
+
+    //Computing the layout here would race with the optimization workers reading the layouts
+    cpp_assert(false, "The layout of the structure has not been computed after its collection");
+
+    return compute_layout(struct_);
+}
+
+const StructLayout& GlobalContext::compute_layout(std::shared_ptr<const Struct> struct_) const {
+    std::lock_guard<std::recursive_mutex> lock(layouts_mutex);
+
+    auto& layout = layouts[struct_.get()];
+
+    //A layout being computed is only reached by an invalidly nested structure
+    if(layout.members == struct_->members.size() || layout.members == static_cast<std::size_t>(-1)){
+        return layout;
+    }
+
+    layout = StructLayout();
+    layout.members = static_cast<std::size_t>(-1);
+    layout.alignment = INT->size();
+
+    int alignment = 1;
     int offset = 0;
 
     for(const auto& m : struct_->members){
-        if(m.name == member){
-            return offset;
-        }
+        auto member_alignment = m.type->is_structure() ? compute_layout(get_struct(m.type)).alignment : alignment_of(m.type);
+
+        offset = align(offset, member_alignment);
+        alignment = std::max(alignment, member_alignment);
+
+        layout.offsets[m.name] = offset;
+        layout.by_offset.emplace_back(offset, m.type);
 
         offset += m.type->size();
     }
 
-    cpp_unreachable("The member is not part of the struct");
+    int parent_size = 0;
+
+    if(struct_->parent_type){
+        auto& parent_layout = compute_layout(get_struct(struct_->parent_type));
+
+        alignment = std::max(alignment, parent_layout.alignment);
+        parent_size = parent_layout.total_size;
+    }
+
+    std::sort(layout.by_offset.begin(), layout.by_offset.end(), [](auto& lhs, auto& rhs){ return lhs.first < rhs.first; });
+
+    layout.self_size = align(offset, alignment);
+    layout.total_size = align(layout.self_size + parent_size, alignment);
+    layout.alignment = alignment;
+    layout.members = struct_->members.size();
+
+    return layout;
 }
 
-std::shared_ptr<const Type> GlobalContext::member_type(std::shared_ptr<const Struct> struct_, int offset) const {
-    int current_offset = 0;
+int GlobalContext::alignment_of(std::shared_ptr<const Type> type) const {
+    int int_size = INT->size();
 
-    for(const auto& m : struct_->members){
-        if(offset <= current_offset){
-            return m.type;
+    if(type->is_pointer() || type->is_array() || type == STRING){
+        return int_size;
+    } else if(type->is_structure()){
+        return layout(get_struct(type)).alignment;
+    }
+
+    return std::max(1, std::min(static_cast<int>(type->size()), int_size));
+}
+
+void GlobalContext::print_struct_layouts(std::ostream& out) const {
+    std::vector<std::string> names;
+
+    for(auto& [name, struct_] : m_structs){
+        names.push_back(name);
+    }
+
+    std::sort(names.begin(), names.end());
+
+    for(auto& name : names){
+        auto struct_ = m_structs.at(name);
+
+        if(struct_->members.empty()){
+            continue;
+        }
+
+        auto& struct_layout = layout(struct_);
+
+        out << "struct " << name << " (size " << struct_layout.total_size << ", align " << struct_layout.alignment << ")" << std::endl;
+
+        for(auto& m : struct_->members){
+            out << "\t" << struct_layout.offsets.at(m.name) << "\t" << m.type->size() << "\t" << m.name << std::endl;
+        }
+
+        if(struct_->parent_type){
+            out << "\t" << struct_layout.self_size << "\t" << (struct_layout.total_size - struct_layout.self_size) << "\t<parent " << struct_->parent_type->mangle() << ">" << std::endl;
         }
-        
-        current_offset += m.type->size();
     }
+}
 
-    return struct_->members.back().type;
+int GlobalContext::member_offset(std::shared_ptr<const Struct> struct_, const std::string& member) const {
+    auto& offsets = layout(struct_).offsets;
+    auto it = offsets.find(member);
+
+    if(it == offsets.end()){
+        cpp_unreachable("The member is not part of the struct");
+    }
+
+    return it->second;
 }
 
-int GlobalContext::self_size_of_struct(std::shared_ptr<const Struct> struct_) const {
-    int struct_size = 0;
+std::shared_ptr<const Type> GlobalContext::member_type(std::shared_ptr<const Struct> struct_, int offset) const {
+    auto& by_offset = layout(struct_).by_offset;
 
-    for(const auto& m : struct_->members){
-        struct_size += m.type->size();
+    auto it = std::lower_bound(by_offset.begin(), by_offset.end(), offset, [](auto& member, int offset){ return member.first < offset; });
+
+    if(it == by_offset.end()){
+        return by_offset.back().second;
     }
 
-    cpp_assert(struct_->members.size(), "self_size_of_struct");
-    
-    return struct_size;
+    return it->second;
 }
 
-int GlobalContext::total_size_of_struct(std::shared_ptr<const Struct> struct_) const {
-   int total = self_size_of_struct(struct_);
+int GlobalContext::self_size_of_struct(std::shared_ptr<const Struct> struct_) const {
+    cpp_assert(struct_->members.size(), "self_size_of_struct");
 
-   while(struct_->parent_type){
-       struct_ = get_struct(struct_->parent_type);
-       total += self_size_of_struct(struct_);
-   }
+    return layout(struct_).self_size;
+}
 
-   return total;
+int GlobalContext::total_size_of_struct(std::shared_ptr<const Struct> struct_) const {
+    return layout(struct_).total_size;
 }
 
 bool GlobalContext::is_recursively_nested(std::shared_ptr<const Struct> struct_, unsigned int left) const {
@@ -258,19 +371,29 @@ timing_system& GlobalContext::timing(){
     return m_timing;
 }
 
+variable_table& GlobalContext::variables_table(){
+    return m_variables;
+}
+
 std::size_t GlobalContext::new_file(const std::string& file_name){
-    int index = file_contents.size();
+    std::lock_guard<std::mutex> lock(files_mutex);
+
+    std::size_t index = file_contents.size();
 
     file_names.push_back(file_name);
-    file_contents.emplace_back("");
+    file_contents.emplace_back(file_name);
 
     return index;
 }
 
-std::string& GlobalContext::get_file_content(std::size_t file){
+const mapped_file& GlobalContext::get_file_content(std::size_t file){
+    std::lock_guard<std::mutex> lock(files_mutex);
+
     return file_contents[file];
 }
 
 const std::string& GlobalContext::get_file_name(std::size_t file){
+    std::lock_guard<std::mutex> lock(files_mutex);
+
     return file_names[file];
 }
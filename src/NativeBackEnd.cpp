@@ -29,6 +29,34 @@
 
 using namespace eddic;
 
+namespace {
+
+void collect_ltac_statistics(mtac::Program& program){
+    std::size_t instructions = 0;
+    std::size_t usages = 0;
+
+    for(auto& function : program.functions){
+        for(auto& block : function){
+            instructions += block->l_statements.size();
+
+            for(auto& instruction : block->l_statements){
+                if(instruction.has_usage()){
+                    ++usages;
+                }
+            }
+        }
+    }
+
+    auto& stats = program.context.stats();
+
+    stats.inc_counter("ltac_instructions", instructions);
+    stats.inc_counter("ltac_instruction_bytes", instructions * sizeof(ltac::Instruction));
+    stats.inc_counter("ltac_instruction_size", sizeof(ltac::Instruction));
+    stats.inc_counter("ltac_register_usages", usages);
+}
+
+} //end of anonymous namespace
+
 void NativeBackEnd::generate(mtac::Program& program, Platform platform){
     std::string output = configuration->option_value("output");
 
@@ -45,6 +73,10 @@ void NativeBackEnd::generate(mtac::Program& program, Platform platform){
     //Switch to LTAC Mode
     program.mode = mtac::Mode::LTAC;
 
+    if(configuration->option_defined("stats")){
+        collect_ltac_statistics(program);
+    }
+
     //Clean the code generated by the LTAC Compiler to ease the register allocation
     ltac::pre_alloc_cleanup(program);
     
@@ -87,35 +119,45 @@ void NativeBackEnd::generate(mtac::Program& program, Platform platform){
         auto asm_file_name = input_file_name + ".s";
         auto object_file_name = input_file_name + ".o";
 
+        //The assembly file is only written when it is requested or when nasm is used
+        //The integrated assembler does not generate debugging symbols
+        bool external = configuration->option_defined("external-assembler") || configuration->option_defined("debug");
+        bool write = external || configuration->option_defined("assembly") || configuration->option_defined("keep");
+
+        AssemblyFileWriter writer;
+
         {
             timing_timer timer(program.context.timing(), "assembly_generation");
 
-            //Generate assembly from TAC
-            AssemblyFileWriter writer(asm_file_name);
-
             as::CodeGeneratorFactory factory;
-            auto generator = factory.get(platform, writer, program, program.context);
+            auto generator = factory.get(platform, writer, program, program.context, configuration);
 
             //Generate the code from the LTAC Program
             generator->generate(*get_string_pool(), float_pool);
 
-            //writer's destructor flushes the file
+            if(write){
+                writer.write(asm_file_name);
+            }
         }
 
         //If it's necessary, assemble and link the assembly
         if(!configuration->option_defined("assembly")){
             timing_timer timer(program.context.timing(), "assemble");
 
-            verify_dependencies();
+            if(external){
+                verify_dependencies();
 
-            assemble(platform, asm_file_name, object_file_name, output, configuration->option_defined("debug"), configuration->option_defined("verbose"));
+                assemble(platform, asm_file_name, object_file_name, output, configuration->option_defined("debug"), configuration->option_defined("verbose"));
 
-            //Remove temporary files
-            if(!configuration->option_defined("keep")){
-                remove(asm_file_name.c_str());
-            }
+                //Remove temporary files
+                if(!configuration->option_defined("keep")){
+                    remove(asm_file_name.c_str());
+                }
 
-            remove(object_file_name.c_str());
+                remove(object_file_name.c_str());
+            } else {
+                assemble_integrated(platform, writer.buffer(), output, configuration->option_defined("verbose"));
+            }
         }
     }
 }
@@ -28,6 +28,9 @@ void init_options(cxxopts::Options& options){
         ("version", "Print the version of eddic")
         ("o,output", "Set the name of the executable", cxxopts::value<std::string>()->default_value("a.out"))
         ("g,debug", "Add debugging symbols")
+        ("no-header-cache", "Always parse the standard headers instead of loading them from the cache (stored in $EDDIC_CACHE_DIR or ~/.cache/eddic)")
+        ("unbuffered-output", "Write the output of the print functions immediately instead of buffering it until exit or input")
+        ("external-assembler", "Assemble and link with nasm and ld instead of the integrated assembler (always used with debugging symbols)")
         ("template-depth", "Define the maximum template depth", cxxopts::value<std::string>()->default_value("100"))
         ("32", "Force the compilation for 32 bits platform")
         ("64", "Force the compilation for 64 bits platform")
@@ -49,6 +52,7 @@ void init_options(cxxopts::Options& options){
         ("ltac-alloc", "Print the low-level Three Address Code representation of the source before optimization")
         ("ltac", "Print the final low-level Three Address Code representation of the source")
         ("ltac-only", "Only print the low-level Three Address Code representation of the source (do not continue compilation after printing)")
+        ("struct-layouts", "Print the memory layout of the structures")
         ;
 
     options.add_options("Optimization")
@@ -65,14 +69,18 @@ void init_options(cxxopts::Options& options){
         ("fno-inline-functions", "Disable inlining")
         ("funroll-loops", "Enable Loop Unrolling")
         ("fcomplete-peel-loops", "Enable Complete Loop Peeling")
+        ("freorder-members", "Reorder the members of the structures by decreasing alignment to minimize the padding")
+        ("fprofile-generate", "Instrument the program to write the execution counts of its basic blocks to the given file at exit", cxxopts::value<std::string>()->implicit_value("eddic.profile"))
+        ("fprofile-use", "Use the execution counts of the given profile to guide the optimizations", cxxopts::value<std::string>()->implicit_value("eddic.profile"))
         ;
 
     options.add_options("Backend")
         ("log", "Define the logging", cxxopts::value<std::string>()->default_value("0"))
         ("q,quiet", "Do not print anything")
         ("v,verbose", "Make the compiler verbose")
-        ("single-threaded", "Disable the multi-threaded optimization")
+        ("single-threaded", "Disable the multi-threaded parsing and optimization")
         ("time", "Activate the timing system")
+        ("time-trace", "Write the timings of the phases, passes and functions with the statistics to the given file in the Chrome trace format (chrome://tracing, Perfetto)", cxxopts::value<std::string>()->implicit_value("eddic-trace.json"))
         ("stats", "Activate the statistics system")
         ("input", "Input file", cxxopts::value<std::string>())
         ;
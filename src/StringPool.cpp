@@ -18,7 +18,7 @@ StringPool::StringPool() : currentString(0) {
 }
 
 std::string StringPool::label(const std::string& value) {
-//    std::lock_guard<std::mutex> lock(mutex);
+    std::lock_guard<std::mutex> lock(mutex);
 
     if (pool.find(value) == pool.end()) {
         std::stringstream ss;
@@ -31,7 +31,7 @@ std::string StringPool::label(const std::string& value) {
 }
 
 std::string StringPool::value(const std::string& label) const {
-//    std::lock_guard<std::mutex> lock(mutex);
+    std::lock_guard<std::mutex> lock(mutex);
 
     for (auto it : pool){
         if(it.second == label){
@@ -44,5 +44,7 @@ std::string StringPool::value(const std::string& label) const {
 }
 
 std::unordered_map<std::string, std::string> StringPool::getPool() const {
+    std::lock_guard<std::mutex> lock(mutex);
+
     return pool;
 }
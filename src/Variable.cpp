@@ -20,6 +20,14 @@ Variable::Variable(std::string name, std::shared_ptr<const Type> type, Position
 Variable::Variable(std::string name, std::shared_ptr<const Type> type, std::shared_ptr<Variable> reference, Offset offset)
     : m_name(std::move(name)), m_type(std::move(type)), m_position(PositionType::TEMPORARY), m_reference(std::move(reference)), m_offset(std::move(offset)) {}
 
+uint32_t Variable::id() const {
+    return m_id;
+}
+
+void Variable::set_id(uint32_t id){
+    m_id = id;
+}
+
 std::string Variable::name() const  {
     return m_name;
 }
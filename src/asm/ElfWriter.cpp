@@ -0,0 +1,177 @@
+//=======================================================================
+// Copyright Baptiste Wicht 2011-2016.
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#include <fstream>
+
+#include <sys/stat.h>
+
+#include "asm/ElfWriter.hpp"
+#include "asm/Encoder.hpp"
+
+using namespace eddic;
+
+namespace {
+
+const uint64_t page_size = 0x1000;
+
+//Segment flags
+const uint32_t PF_X = 1;
+const uint32_t PF_W = 2;
+const uint32_t PF_R = 4;
+
+uint64_t align(uint64_t value, uint64_t alignment){
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+struct Buffer {
+    std::vector<char> bytes;
+
+    void put(uint64_t value, unsigned int size){
+        for(unsigned int i = 0; i < size; ++i){
+            bytes.push_back(static_cast<char>(value >> (8 * i)));
+        }
+    }
+};
+
+struct Segment {
+    uint64_t offset;
+    uint64_t address;
+    uint64_t size;
+    uint32_t flags;
+};
+
+void write_program_header(Buffer& buffer, bool x86_64, const Segment& segment){
+    const uint32_t PT_LOAD = 1;
+
+    if(x86_64){
+        buffer.put(PT_LOAD, 4);
+        buffer.put(segment.flags, 4);
+        buffer.put(segment.offset, 8);
+        buffer.put(segment.address, 8);
+        buffer.put(segment.address, 8);
+        buffer.put(segment.size, 8);
+        buffer.put(segment.size, 8);
+        buffer.put(page_size, 8);
+    } else {
+        buffer.put(PT_LOAD, 4);
+        buffer.put(segment.offset, 4);
+        buffer.put(segment.address, 4);
+        buffer.put(segment.address, 4);
+        buffer.put(segment.size, 4);
+        buffer.put(segment.size, 4);
+        buffer.put(segment.flags, 4);
+        buffer.put(page_size, 4);
+    }
+}
+
+} //end of anonymous namespace
+
+bool as::write_elf(Platform platform, ObjectCode& object, const std::string& path, std::string& error){
+    bool x86_64 = platform == Platform::INTEL_X86_64;
+
+    uint64_t base = x86_64 ? 0x400000 : 0x8048000;
+    uint64_t header_size = x86_64 ? 64 + 2 * 56 : 52 + 2 * 32;
+
+    //The headers and the text are loaded together, the data on the following pages
+    uint64_t text_offset = header_size;
+    uint64_t text_address = base + text_offset;
+
+    uint64_t data_offset = align(text_offset + object.text.size(), 16);
+    uint64_t data_address = align(base + text_offset + object.text.size(), page_size) + data_offset % page_size;
+
+    auto address = [&](const Symbol& symbol){
+        return (symbol.section == Section::TEXT ? text_address : data_address) + symbol.offset;
+    };
+
+    auto entry = object.symbols.find("_start");
+    if(entry == object.symbols.end()){
+        error = "The entry point _start is not defined";
+        return false;
+    }
+
+    for(auto& fixup : object.fixups){
+        auto symbol = object.symbols.find(fixup.symbol);
+
+        if(symbol == object.symbols.end()){
+            error = "The symbol " + fixup.symbol + " is not defined";
+            return false;
+        }
+
+        auto& bytes = fixup.section == Section::TEXT ? object.text : object.data;
+        auto target = address(symbol->second) + fixup.addend;
+
+        uint64_t value = target;
+        unsigned int size = 4;
+
+        if(fixup.kind == FixupKind::ABSOLUTE_64){
+            size = 8;
+        } else if(fixup.kind == FixupKind::RELATIVE_32){
+            auto next = address({fixup.section, fixup.offset}) + 4;
+            value = target - next;
+        } else if(target > 0x7FFFFFFF){
+            //The absolute 32-bit fields are sign-extended in 64 bits
+            error = "The address of " + fixup.symbol + " does not fit in 32 bits";
+            return false;
+        }
+
+        for(unsigned int i = 0; i < size; ++i){
+            bytes[fixup.offset + i] = static_cast<uint8_t>(value >> (8 * i));
+        }
+    }
+
+    Segment text{0, base, text_offset + object.text.size(), PF_R | PF_X};
+    Segment data{data_offset, data_address, object.data.size(), PF_R | PF_W};
+
+    Buffer buffer;
+
+    //ELF identification
+    buffer.bytes = {0x7F, 'E', 'L', 'F', static_cast<char>(x86_64 ? 2 : 1), 1, 1, 0};
+    buffer.put(0, 8);
+
+    buffer.put(2, 2);                               //ET_EXEC
+    buffer.put(x86_64 ? 62 : 3, 2);                 //EM_X86_64 or EM_386
+    buffer.put(1, 4);                               //EV_CURRENT
+
+    unsigned int word = x86_64 ? 8 : 4;
+
+    buffer.put(address(entry->second), word);       //Entry point
+    buffer.put(x86_64 ? 64 : 52, word);             //Program headers offset
+    buffer.put(0, word);                            //No section headers
+    buffer.put(0, 4);                               //Flags
+    buffer.put(x86_64 ? 64 : 52, 2);                //Size of the ELF header
+    buffer.put(x86_64 ? 56 : 32, 2);                //Size of a program header
+    buffer.put(2, 2);                               //Number of program headers
+    buffer.put(x86_64 ? 64 : 40, 2);                //Size of a section header
+    buffer.put(0, 2);                               //Number of section headers
+    buffer.put(0, 2);                               //Index of the section names
+
+    write_program_header(buffer, x86_64, text);
+    write_program_header(buffer, x86_64, data);
+
+    buffer.bytes.insert(buffer.bytes.end(), object.text.begin(), object.text.end());
+    buffer.bytes.resize(data_offset, 0);
+    buffer.bytes.insert(buffer.bytes.end(), object.data.begin(), object.data.end());
+
+    std::ofstream stream(path.c_str(), std::ios::binary | std::ios::trunc);
+
+    if(!stream){
+        error = "Unable to open the output file " + path;
+        return false;
+    }
+
+    stream.write(buffer.bytes.data(), buffer.bytes.size());
+    stream.close();
+
+    if(!stream){
+        error = "Unable to write the output file " + path;
+        return false;
+    }
+
+    chmod(path.c_str(), 0755);
+
+    return true;
+}
@@ -0,0 +1,1351 @@
+//=======================================================================
+// Copyright Baptiste Wicht 2011-2016.
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+
+#include "asm/Encoder.hpp"
+
+using namespace eddic;
+
+namespace {
+
+enum class OperandType : unsigned int {
+    NONE,
+    REGISTER,
+    FLOAT_REGISTER,
+    IMMEDIATE,
+    MEMORY
+};
+
+struct Operand {
+    OperandType type = OperandType::NONE;
+    unsigned int size = 0;  //Size in bytes, 0 if not specified
+    int reg = -1;           //Register number
+    int base = -1;          //Base register of the address
+    int index = -1;         //Scaled register of the address
+    int scale = 0;          //log2 of the scale of the address
+    int64_t value = 0;      //Value of the immediate or displacement of the address
+    std::string symbol;     //Symbol of the immediate or of the displacement
+};
+
+struct RegisterInfo {
+    int number;
+    unsigned int size;
+};
+
+const std::unordered_map<std::string, RegisterInfo> registers = {
+    {"rax", {0, 8}}, {"rcx", {1, 8}}, {"rdx", {2, 8}}, {"rbx", {3, 8}},
+    {"rsp", {4, 8}}, {"rbp", {5, 8}}, {"rsi", {6, 8}}, {"rdi", {7, 8}},
+    {"r8", {8, 8}}, {"r9", {9, 8}}, {"r10", {10, 8}}, {"r11", {11, 8}},
+    {"r12", {12, 8}}, {"r13", {13, 8}}, {"r14", {14, 8}}, {"r15", {15, 8}},
+
+    {"eax", {0, 4}}, {"ecx", {1, 4}}, {"edx", {2, 4}}, {"ebx", {3, 4}},
+    {"esp", {4, 4}}, {"ebp", {5, 4}}, {"esi", {6, 4}}, {"edi", {7, 4}},
+    {"r8d", {8, 4}}, {"r9d", {9, 4}}, {"r10d", {10, 4}}, {"r11d", {11, 4}},
+    {"r12d", {12, 4}}, {"r13d", {13, 4}}, {"r14d", {14, 4}}, {"r15d", {15, 4}},
+
+    {"ax", {0, 2}}, {"cx", {1, 2}}, {"dx", {2, 2}}, {"bx", {3, 2}},
+    {"sp", {4, 2}}, {"bp", {5, 2}}, {"si", {6, 2}}, {"di", {7, 2}},
+    {"r8w", {8, 2}}, {"r9w", {9, 2}}, {"r10w", {10, 2}}, {"r11w", {11, 2}},
+    {"r12w", {12, 2}}, {"r13w", {13, 2}}, {"r14w", {14, 2}}, {"r15w", {15, 2}},
+
+    //ah, ch, dh and bh are never generated, so the numbers 4 to 7 are free for the REX registers
+    {"al", {0, 1}}, {"cl", {1, 1}}, {"dl", {2, 1}}, {"bl", {3, 1}},
+    {"r8b", {8, 1}}, {"r9b", {9, 1}}, {"r10b", {10, 1}}, {"r11b", {11, 1}},
+    {"r12b", {12, 1}}, {"r13b", {13, 1}}, {"r14b", {14, 1}}, {"r15b", {15, 1}},
+};
+
+const std::unordered_map<std::string, int> conditions = {
+    {"o", 0}, {"no", 1}, {"b", 2}, {"c", 2}, {"nae", 2}, {"ae", 3}, {"nb", 3}, {"nc", 3},
+    {"e", 4}, {"z", 4}, {"ne", 5}, {"nz", 5}, {"be", 6}, {"na", 6}, {"a", 7}, {"nbe", 7},
+    {"s", 8}, {"ns", 9}, {"p", 10}, {"pe", 10}, {"np", 11}, {"po", 11},
+    {"l", 12}, {"nge", 12}, {"ge", 13}, {"nl", 13}, {"le", 14}, {"ng", 14}, {"g", 15}, {"nle", 15}
+};
+
+//The extension of the opcode of the instructions of the arithmetic group
+const std::unordered_map<std::string, int> arithmetic = {
+    {"add", 0}, {"or", 1}, {"adc", 2}, {"sbb", 3}, {"and", 4}, {"sub", 5}, {"xor", 6}, {"cmp", 7}
+};
+
+//The extension of the opcode of the unary instructions (F6/F7 opcodes)
+const std::unordered_map<std::string, int> unary = {
+    {"not", 2}, {"neg", 3}, {"mul", 4}, {"div", 6}, {"idiv", 7}
+};
+
+//The extension of the opcode of the shift instructions
+const std::unordered_map<std::string, int> shifts = {
+    {"rol", 0}, {"ror", 1}, {"shl", 4}, {"sal", 4}, {"shr", 5}, {"sar", 7}
+};
+
+//The extension of the opcode of the bit test instructions
+const std::unordered_map<std::string, int> bit_tests = {
+    {"bt", 4}, {"bts", 5}, {"btr", 6}, {"btc", 7}
+};
+
+struct SSEInfo {
+    uint8_t prefix; //The mandatory prefix, 0 if none
+    uint8_t load;   //The opcode of xmm, xmm/m
+    uint8_t store;  //The opcode of m, xmm, 0 if none
+};
+
+const std::unordered_map<std::string, SSEInfo> sse = {
+    {"movss", {0xF3, 0x10, 0x11}}, {"movsd", {0xF2, 0x10, 0x11}},
+    {"addss", {0xF3, 0x58, 0}}, {"addsd", {0xF2, 0x58, 0}},
+    {"subss", {0xF3, 0x5C, 0}}, {"subsd", {0xF2, 0x5C, 0}},
+    {"mulss", {0xF3, 0x59, 0}}, {"mulsd", {0xF2, 0x59, 0}},
+    {"divss", {0xF3, 0x5E, 0}}, {"divsd", {0xF2, 0x5E, 0}},
+    {"ucomiss", {0, 0x2E, 0}}, {"ucomisd", {0x66, 0x2E, 0}},
+    {"xorps", {0, 0x57, 0}}, {"movdqu", {0xF3, 0x6F, 0x7F}}
+};
+
+//The instructions without operands
+const std::unordered_map<std::string, std::vector<uint8_t>> simple = {
+    {"ret", {0xC3}}, {"leave", {0xC9}}, {"nop", {0x90}}, {"cdq", {0x99}},
+    {"syscall", {0x0F, 0x05}}, {"cpuid", {0x0F, 0xA2}}, {"rdtsc", {0x0F, 0x31}},
+    {"scasb", {0xAE}}, {"movsb", {0xA4}}
+};
+
+std::string trim(const std::string& value){
+    auto first = value.find_first_not_of(" \t\r");
+
+    if(first == std::string::npos){
+        return "";
+    }
+
+    auto last = value.find_last_not_of(" \t\r");
+    return value.substr(first, last - first + 1);
+}
+
+//Split the first word of the line from the rest of the line
+std::pair<std::string, std::string> split_word(const std::string& line){
+    auto end = line.find_first_of(" \t");
+
+    if(end == std::string::npos){
+        return {line, ""};
+    }
+
+    return {line.substr(0, end), trim(line.substr(end))};
+}
+
+bool is_symbol(const std::string& value){
+    if(value.empty() || !(std::isalpha(value[0]) || value[0] == '_' || value[0] == '.')){
+        return false;
+    }
+
+    for(char c : value){
+        if(!(std::isalnum(c) || c == '_' || c == '.' || c == '$')){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool parse_number(const std::string& value, int64_t& result){
+    if(value.empty()){
+        return false;
+    }
+
+    std::size_t i = 0;
+    bool negative = false;
+
+    if(value[0] == '-' || value[0] == '+'){
+        negative = value[0] == '-';
+        i = 1;
+    }
+
+    auto digits = value.substr(i);
+    int radix = 10;
+
+    if(digits.size() > 2 && digits[0] == '0' && (digits[1] == 'x' || digits[1] == 'X')){
+        digits = digits.substr(2);
+        radix = 16;
+    } else if(digits.size() > 1 && (digits.back() == 'h' || digits.back() == 'H')){
+        digits.pop_back();
+        radix = 16;
+    }
+
+    if(digits.empty() || !std::isdigit(digits[0])){
+        return false;
+    }
+
+    char* end = nullptr;
+    auto parsed = std::strtoull(digits.c_str(), &end, radix);
+
+    if(*end != '\0'){
+        return false;
+    }
+
+    result = negative ? -static_cast<int64_t>(parsed) : static_cast<int64_t>(parsed);
+    return true;
+}
+
+//Parse the __float32__(x) and __float64__(x) special functions
+bool parse_float(const std::string& value, int64_t& result, unsigned int& size){
+    if(value.compare(0, 12, "__float32__(") == 0){
+        size = 4;
+    } else if(value.compare(0, 12, "__float64__(") == 0){
+        size = 8;
+    } else {
+        return false;
+    }
+
+    if(value.back() != ')'){
+        return false;
+    }
+
+    auto content = value.substr(12, value.size() - 13);
+
+    char* end = nullptr;
+    double parsed = std::strtod(content.c_str(), &end);
+
+    if(*end != '\0'){
+        return false;
+    }
+
+    if(size == 4){
+        float single = parsed;
+        uint32_t bits;
+        std::memcpy(&bits, &single, sizeof(bits));
+        result = bits;
+    } else {
+        uint64_t bits;
+        std::memcpy(&bits, &parsed, sizeof(bits));
+        result = static_cast<int64_t>(bits);
+    }
+
+    return true;
+}
+
+bool fits_8(int64_t value){
+    return value >= -128 && value <= 127;
+}
+
+bool fits_32(int64_t value){
+    return value >= INT32_MIN && value <= INT32_MAX;
+}
+
+//Indicates if the value can be written in the given number of bytes, either signed or unsigned
+bool fits(int64_t value, unsigned int size){
+    if(size >= 8){
+        return true;
+    }
+
+    auto bits = size * 8;
+    return value >= -(int64_t(1) << (bits - 1)) && value < (int64_t(1) << bits);
+}
+
+struct Encoder {
+    Encoder(Platform platform, as::ObjectCode& object, std::string& error) :
+            x86_64(platform == Platform::INTEL_X86_64), object(object), error(error) {}
+
+    bool x86_64;
+    as::ObjectCode& object;
+    std::string& error;
+
+    as::Section section = as::Section::TEXT;
+    std::string scope;
+
+    int repetitions = -1;
+    std::vector<std::string> repeated;
+
+    bool fail(const std::string& message){
+        error = message;
+        return false;
+    }
+
+    std::vector<uint8_t>& bytes(){
+        return section == as::Section::TEXT ? object.text : object.data;
+    }
+
+    unsigned int address_size() const {
+        return x86_64 ? 8 : 4;
+    }
+
+    void emit_byte(uint8_t value){
+        bytes().push_back(value);
+    }
+
+    void emit_value(uint64_t value, unsigned int size){
+        for(unsigned int i = 0; i < size; ++i){
+            bytes().push_back(static_cast<uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    void emit_fixup(const std::string& symbol, int64_t addend, as::FixupKind kind){
+        object.fixups.push_back({section, bytes().size(), symbol, addend, kind});
+
+        emit_value(0, kind == as::FixupKind::ABSOLUTE_64 ? 8 : 4);
+    }
+
+    //Local labels (starting with a dot) are attached to the last non-local label
+    std::string qualify(const std::string& label) const {
+        if(label[0] == '.'){
+            return scope + label;
+        }
+
+        return label;
+    }
+
+    bool define(const std::string& label){
+        if(label[0] != '.'){
+            scope = label;
+        }
+
+        auto name = qualify(label);
+
+        if(object.symbols.count(name)){
+            return fail("The symbol " + name + " is defined twice");
+        }
+
+        object.symbols[name] = {section, bytes().size()};
+
+        return true;
+    }
+
+    bool parse_address(const std::string& address, Operand& operand){
+        operand.type = OperandType::MEMORY;
+
+        std::size_t i = 0;
+        int sign = 1;
+
+        while(i < address.size()){
+            char c = address[i];
+
+            if(c == ' ' || c == '\t'){
+                ++i;
+            } else if(c == '+'){
+                ++i;
+            } else if(c == '-'){
+                sign = -sign;
+                ++i;
+            } else {
+                auto end = address.find_first_of("+-", i);
+                auto term = trim(address.substr(i, end == std::string::npos ? std::string::npos : end - i));
+                i = end == std::string::npos ? address.size() : end;
+
+                if(!parse_term(term, sign, operand)){
+                    return false;
+                }
+
+                sign = 1;
+            }
+        }
+
+        if(operand.index == 4){
+            return fail("The stack pointer cannot be scaled");
+        }
+
+        return true;
+    }
+
+    bool parse_term(const std::string& term, int sign, Operand& operand){
+        auto star = term.find('*');
+
+        if(star != std::string::npos){
+            auto reg = registers.find(trim(term.substr(0, star)));
+            int64_t scale = 0;
+
+            if(reg == registers.end() || !parse_number(trim(term.substr(star + 1)), scale) || sign < 0 || operand.index >= 0){
+                return fail("Invalid scaled register " + term);
+            }
+
+            switch(scale){
+                case 1: operand.scale = 0; break;
+                case 2: operand.scale = 1; break;
+                case 4: operand.scale = 2; break;
+                case 8: operand.scale = 3; break;
+                default: return fail("Invalid scale " + term);
+            }
+
+            operand.index = reg->second.number;
+            return check_address_register(reg->second);
+        }
+
+        auto reg = registers.find(term);
+
+        if(reg != registers.end()){
+            if(sign < 0){
+                return fail("A register cannot be subtracted from an address");
+            }
+
+            if(operand.base < 0){
+                operand.base = reg->second.number;
+            } else if(operand.index < 0){
+                operand.index = reg->second.number;
+            } else {
+                return fail("Too many registers in the address");
+            }
+
+            return check_address_register(reg->second);
+        }
+
+        int64_t value = 0;
+        if(parse_number(term, value)){
+            operand.value += sign * value;
+            return true;
+        }
+
+        if(is_symbol(term) && operand.symbol.empty() && sign > 0){
+            operand.symbol = qualify(term);
+            return true;
+        }
+
+        return fail("Invalid address term " + term);
+    }
+
+    bool check_address_register(const RegisterInfo& reg){
+        if(reg.size != address_size()){
+            return fail("Invalid address register size");
+        }
+
+        return true;
+    }
+
+    bool parse_operand(const std::string& text, Operand& operand){
+        auto value = trim(text);
+
+        static const std::pair<const char*, unsigned int> keywords[] = {{"byte", 1}, {"word", 2}, {"dword", 4}, {"qword", 8}};
+
+        for(auto& keyword : keywords){
+            auto length = std::strlen(keyword.first);
+
+            if(value.size() > length && value.compare(0, length, keyword.first) == 0 && (value[length] == ' ' || value[length] == '[')){
+                operand.size = keyword.second;
+                value = trim(value.substr(length));
+                break;
+            }
+        }
+
+        if(value.empty()){
+            return fail("Missing operand");
+        }
+
+        if(value.front() == '['){
+            if(value.back() != ']'){
+                return fail("Invalid address " + value);
+            }
+
+            return parse_address(value.substr(1, value.size() - 2), operand);
+        }
+
+        auto reg = registers.find(value);
+
+        if(reg != registers.end()){
+            if(!x86_64 && (reg->second.size == 8 || reg->second.number >= 8)){
+                return fail("The register " + value + " does not exist in 32 bits");
+            }
+
+            operand.type = OperandType::REGISTER;
+            operand.reg = reg->second.number;
+            operand.size = reg->second.size;
+            return true;
+        }
+
+        if(value.size() == 4 && value.compare(0, 3, "xmm") == 0 && value[3] >= '0' && value[3] <= '7'){
+            operand.type = OperandType::FLOAT_REGISTER;
+            operand.reg = value[3] - '0';
+            return true;
+        }
+
+        operand.type = OperandType::IMMEDIATE;
+
+        unsigned int float_size = 0;
+        if(parse_number(value, operand.value) || parse_float(value, operand.value, float_size)){
+            return true;
+        }
+
+        if(is_symbol(value)){
+            operand.symbol = qualify(value);
+            return true;
+        }
+
+        return fail("Invalid operand " + value);
+    }
+
+    void emit_immediate(const Operand& operand, unsigned int size){
+        if(!operand.symbol.empty()){
+            emit_fixup(operand.symbol, operand.value, size == 8 ? as::FixupKind::ABSOLUTE_64 : as::FixupKind::ABSOLUTE_32);
+        } else {
+            emit_value(operand.value, size);
+        }
+    }
+
+    bool emit_rex(bool rex_w, int reg, int index, int base){
+        uint8_t rex = 0x40;
+
+        if(rex_w){
+            rex |= 0x08;
+        }
+
+        if(reg >= 8){
+            rex |= 0x04;
+        }
+
+        if(index >= 8){
+            rex |= 0x02;
+        }
+
+        if(base >= 8){
+            rex |= 0x01;
+        }
+
+        if(rex != 0x40){
+            if(!x86_64){
+                return fail("64-bit operands are not available in 32 bits");
+            }
+
+            emit_byte(rex);
+        }
+
+        return true;
+    }
+
+    //Emit an instruction with a register encoded in the opcode
+    bool emit_opcode_register(uint8_t prefix, bool rex_w, uint8_t opcode, int reg){
+        if(prefix){
+            emit_byte(prefix);
+        }
+
+        if(!emit_rex(rex_w, 0, 0, reg)){
+            return false;
+        }
+
+        emit_byte(opcode + (reg & 7));
+
+        return true;
+    }
+
+    //Emit an instruction with a ModRM byte, the immediate must be emitted by the caller
+    bool emit_modrm(uint8_t prefix, bool rex_w, std::initializer_list<uint8_t> opcode, int reg, const Operand& rm){
+        if(prefix){
+            emit_byte(prefix);
+        }
+
+        if(rm.type == OperandType::REGISTER || rm.type == OperandType::FLOAT_REGISTER){
+            if(!emit_rex(rex_w, reg, 0, rm.reg)){
+                return false;
+            }
+
+            for(auto byte : opcode){
+                emit_byte(byte);
+            }
+
+            emit_byte(0xC0 | ((reg & 7) << 3) | (rm.reg & 7));
+
+            return true;
+        }
+
+        if(rm.type != OperandType::MEMORY){
+            return fail("Invalid operand type");
+        }
+
+        if(!emit_rex(rex_w, reg, rm.index, rm.base)){
+            return false;
+        }
+
+        for(auto byte : opcode){
+            emit_byte(byte);
+        }
+
+        if(rm.symbol.empty() && !fits_32(rm.value)){
+            return fail("The displacement does not fit in 32 bits");
+        }
+
+        int index = rm.index < 0 ? 4 : rm.index & 7;
+
+        if(rm.base < 0){
+            //The absolute addresses always use a SIB byte since mod=00 rm=101 is RIP-relative in 64 bits
+            emit_byte(0x04 | ((reg & 7) << 3));
+            emit_byte((rm.scale << 6) | (index << 3) | 5);
+        } else {
+            int mod = 2;
+
+            if(rm.symbol.empty() && rm.value == 0 && (rm.base & 7) != 5){
+                mod = 0;
+            } else if(rm.symbol.empty() && fits_8(rm.value)){
+                mod = 1;
+            }
+
+            if(rm.index >= 0 || (rm.base & 7) == 4){
+                emit_byte((mod << 6) | ((reg & 7) << 3) | 4);
+                emit_byte((rm.scale << 6) | (index << 3) | (rm.base & 7));
+            } else {
+                emit_byte((mod << 6) | ((reg & 7) << 3) | (rm.base & 7));
+            }
+
+            if(mod == 0){
+                return true;
+            } else if(mod == 1){
+                emit_value(rm.value, 1);
+                return true;
+            }
+        }
+
+        if(rm.symbol.empty()){
+            emit_value(rm.value, 4);
+        } else {
+            emit_fixup(rm.symbol, rm.value, as::FixupKind::ABSOLUTE_32);
+        }
+
+        return true;
+    }
+
+    //Find the size of a general purpose operation, from its registers first
+    bool operation_size(const std::vector<Operand>& operands, unsigned int& size){
+        for(auto& operand : operands){
+            if(operand.type == OperandType::REGISTER){
+                size = operand.size;
+                return true;
+            }
+        }
+
+        for(auto& operand : operands){
+            if(operand.type == OperandType::MEMORY && operand.size){
+                size = operand.size;
+                return true;
+            }
+        }
+
+        return fail("The size of the operation is not specified");
+    }
+
+    static uint8_t size_prefix(unsigned int size){
+        return size == 2 ? 0x66 : 0;
+    }
+
+    static bool is_rm(const Operand& operand){
+        return operand.type == OperandType::REGISTER || operand.type == OperandType::MEMORY;
+    }
+
+    bool count(const std::vector<Operand>& operands, std::size_t expected){
+        if(operands.size() != expected){
+            return fail("Invalid number of operands");
+        }
+
+        return true;
+    }
+
+    bool encode_arithmetic(int extension, std::vector<Operand>& operands){
+        unsigned int size = 0;
+        if(!count(operands, 2) || !operation_size(operands, size)){
+            return false;
+        }
+
+        auto& destination = operands[0];
+        auto& source = operands[1];
+
+        auto prefix = size_prefix(size);
+        bool rex_w = size == 8;
+
+        if(source.type == OperandType::IMMEDIATE && is_rm(destination)){
+            if(!fits(source.value, size == 8 ? 4 : size) || (size == 8 && !fits_32(source.value))){
+                return fail("The immediate does not fit in the operand");
+            }
+
+            if(size == 1){
+                if(!emit_modrm(prefix, rex_w, {0x80}, extension, destination)){
+                    return false;
+                }
+
+                emit_immediate(source, 1);
+            } else if(source.symbol.empty() && fits_8(source.value)){
+                if(!emit_modrm(prefix, rex_w, {0x83}, extension, destination)){
+                    return false;
+                }
+
+                emit_immediate(source, 1);
+            } else {
+                if(!emit_modrm(prefix, rex_w, {0x81}, extension, destination)){
+                    return false;
+                }
+
+                emit_immediate(source, size == 2 ? 2 : 4);
+            }
+
+            return true;
+        }
+
+        uint8_t opcode = extension * 8;
+
+        if(source.type == OperandType::REGISTER && is_rm(destination)){
+            return emit_modrm(prefix, rex_w, {static_cast<uint8_t>(opcode + (size == 1 ? 0 : 1))}, source.reg, destination);
+        } else if(destination.type == OperandType::REGISTER && source.type == OperandType::MEMORY){
+            return emit_modrm(prefix, rex_w, {static_cast<uint8_t>(opcode + (size == 1 ? 2 : 3))}, destination.reg, source);
+        }
+
+        return fail("Invalid operands");
+    }
+
+    bool encode_mov(std::vector<Operand>& operands){
+        unsigned int size = 0;
+        if(!count(operands, 2) || !operation_size(operands, size)){
+            return false;
+        }
+
+        auto& destination = operands[0];
+        auto& source = operands[1];
+
+        auto prefix = size_prefix(size);
+        bool rex_w = size == 8;
+
+        if(source.type == OperandType::IMMEDIATE){
+            if(!fits(source.value, size)){
+                return fail("The immediate does not fit in the operand");
+            }
+
+            if(destination.type == OperandType::REGISTER){
+                //A 64-bit register is only loaded with a 64-bit immediate when necessary
+                if(size == 8 && source.symbol.empty() && fits_32(source.value)){
+                    if(!emit_modrm(prefix, rex_w, {0xC7}, 0, destination)){
+                        return false;
+                    }
+
+                    emit_immediate(source, 4);
+                    return true;
+                }
+
+                if(!emit_opcode_register(prefix, rex_w, size == 1 ? 0xB0 : 0xB8, destination.reg)){
+                    return false;
+                }
+
+                emit_immediate(source, size);
+                return true;
+            } else if(destination.type == OperandType::MEMORY){
+                if(size == 8 && !(source.symbol.empty() ? fits_32(source.value) : true)){
+                    return fail("The immediate does not fit in 32 bits");
+                }
+
+                if(!emit_modrm(prefix, rex_w, {static_cast<uint8_t>(size == 1 ? 0xC6 : 0xC7)}, 0, destination)){
+                    return false;
+                }
+
+                emit_immediate(source, size == 8 ? 4 : size);
+                return true;
+            }
+        } else if(source.type == OperandType::REGISTER && is_rm(destination)){
+            return emit_modrm(prefix, rex_w, {static_cast<uint8_t>(size == 1 ? 0x88 : 0x89)}, source.reg, destination);
+        } else if(destination.type == OperandType::REGISTER && source.type == OperandType::MEMORY){
+            return emit_modrm(prefix, rex_w, {static_cast<uint8_t>(size == 1 ? 0x8A : 0x8B)}, destination.reg, source);
+        }
+
+        return fail("Invalid operands");
+    }
+
+    bool encode_movzx(std::vector<Operand>& operands){
+        if(!count(operands, 2)){
+            return false;
+        }
+
+        auto& destination = operands[0];
+        auto& source = operands[1];
+
+        if(destination.type != OperandType::REGISTER || !is_rm(source)){
+            return fail("Invalid operands");
+        }
+
+        //A 32-bit load already zero-extends the 64-bit register
+        if(source.size == 4){
+            return emit_modrm(0, false, {0x8B}, destination.reg, source);
+        }
+
+        if(source.size != 1 && source.size != 2){
+            return fail("The size of the operation is not specified");
+        }
+
+        return emit_modrm(size_prefix(destination.size), destination.size == 8, {0x0F, static_cast<uint8_t>(source.size == 1 ? 0xB6 : 0xB7)}, destination.reg, source);
+    }
+
+    bool encode_push(std::vector<Operand>& operands){
+        if(!count(operands, 1)){
+            return false;
+        }
+
+        auto& operand = operands[0];
+
+        if(operand.type == OperandType::REGISTER){
+            if(operand.size != address_size()){
+                return fail("Invalid register size");
+            }
+
+            return emit_opcode_register(0, false, 0x50, operand.reg);
+        } else if(operand.type == OperandType::MEMORY){
+            return emit_modrm(0, false, {0xFF}, 6, operand);
+        }
+
+        if(!fits_32(operand.value)){
+            return fail("The immediate does not fit in 32 bits");
+        }
+
+        if(operand.symbol.empty() && fits_8(operand.value)){
+            emit_byte(0x6A);
+            emit_immediate(operand, 1);
+        } else {
+            emit_byte(0x68);
+            emit_immediate(operand, 4);
+        }
+
+        return true;
+    }
+
+    bool encode_pop(std::vector<Operand>& operands){
+        if(!count(operands, 1)){
+            return false;
+        }
+
+        auto& operand = operands[0];
+
+        if(operand.type == OperandType::REGISTER){
+            if(operand.size != address_size()){
+                return fail("Invalid register size");
+            }
+
+            return emit_opcode_register(0, false, 0x58, operand.reg);
+        } else if(operand.type == OperandType::MEMORY){
+            return emit_modrm(0, false, {0x8F}, 0, operand);
+        }
+
+        return fail("Invalid operands");
+    }
+
+    bool encode_unary(uint8_t opcode, int extension, std::vector<Operand>& operands){
+        unsigned int size = 0;
+        if(!count(operands, 1) || !operation_size(operands, size)){
+            return false;
+        }
+
+        return emit_modrm(size_prefix(size), size == 8, {static_cast<uint8_t>(size == 1 ? opcode : opcode + 1)}, extension, operands[0]);
+    }
+
+    bool encode_shift(int extension, std::vector<Operand>& operands){
+        unsigned int size = 0;
+        if(!count(operands, 2) || !operation_size({operands[0]}, size)){
+            return false;
+        }
+
+        auto& source = operands[1];
+
+        if(source.type == OperandType::IMMEDIATE && source.symbol.empty()){
+            if(!emit_modrm(size_prefix(size), size == 8, {static_cast<uint8_t>(size == 1 ? 0xC0 : 0xC1)}, extension, operands[0])){
+                return false;
+            }
+
+            emit_value(source.value, 1);
+            return true;
+        } else if(source.type == OperandType::REGISTER && source.reg == 1 && source.size == 1){
+            return emit_modrm(size_prefix(size), size == 8, {static_cast<uint8_t>(size == 1 ? 0xD2 : 0xD3)}, extension, operands[0]);
+        }
+
+        return fail("Invalid shift count");
+    }
+
+    bool encode_bit_test(int extension, std::vector<Operand>& operands){
+        unsigned int size = 0;
+        if(!count(operands, 2) || !operation_size({operands[0]}, size)){
+            return false;
+        }
+
+        if(operands[1].type != OperandType::IMMEDIATE || !operands[1].symbol.empty()){
+            return fail("Invalid bit index");
+        }
+
+        if(!emit_modrm(size_prefix(size), size == 8, {0x0F, 0xBA}, extension, operands[0])){
+            return false;
+        }
+
+        emit_value(operands[1].value, 1);
+        return true;
+    }
+
+    bool encode_imul(std::vector<Operand>& operands){
+        if(operands.size() == 1){
+            return encode_unary(0xF6, 5, operands);
+        }
+
+        //imul r, imm is a shortcut for imul r, r, imm
+        if(operands.size() == 2 && operands[1].type == OperandType::IMMEDIATE){
+            operands.insert(operands.begin() + 1, operands[0]);
+        }
+
+        auto& destination = operands[0];
+        auto& source = operands[1];
+
+        if(destination.type != OperandType::REGISTER || !is_rm(source) || destination.size == 1){
+            return fail("Invalid operands");
+        }
+
+        auto prefix = size_prefix(destination.size);
+        bool rex_w = destination.size == 8;
+
+        if(operands.size() == 2){
+            return emit_modrm(prefix, rex_w, {0x0F, 0xAF}, destination.reg, source);
+        }
+
+        if(!count(operands, 3)){
+            return false;
+        }
+
+        auto& factor = operands[2];
+
+        if(factor.type != OperandType::IMMEDIATE || !fits_32(factor.value)){
+            return fail("Invalid operands");
+        }
+
+        if(factor.symbol.empty() && fits_8(factor.value)){
+            if(!emit_modrm(prefix, rex_w, {0x6B}, destination.reg, source)){
+                return false;
+            }
+
+            emit_immediate(factor, 1);
+        } else {
+            if(!emit_modrm(prefix, rex_w, {0x69}, destination.reg, source)){
+                return false;
+            }
+
+            emit_immediate(factor, destination.size == 2 ? 2 : 4);
+        }
+
+        return true;
+    }
+
+    bool encode_cmov(int condition, std::vector<Operand>& operands){
+        if(!count(operands, 2)){
+            return false;
+        }
+
+        auto& destination = operands[0];
+
+        if(destination.type != OperandType::REGISTER || !is_rm(operands[1])){
+            return fail("Invalid operands");
+        }
+
+        return emit_modrm(size_prefix(destination.size), destination.size == 8, {0x0F, static_cast<uint8_t>(0x40 + condition)}, destination.reg, operands[1]);
+    }
+
+    //Encode the jumps and the calls, always with a 32-bit displacement
+    bool encode_branch(std::initializer_list<uint8_t> opcode, uint8_t indirect, std::vector<Operand>& operands){
+        if(!count(operands, 1)){
+            return false;
+        }
+
+        auto& target = operands[0];
+
+        if(target.type == OperandType::IMMEDIATE && !target.symbol.empty()){
+            for(auto byte : opcode){
+                emit_byte(byte);
+            }
+
+            emit_fixup(target.symbol, target.value, as::FixupKind::RELATIVE_32);
+            return true;
+        } else if(indirect && is_rm(target)){
+            return emit_modrm(0, false, {0xFF}, indirect, target);
+        }
+
+        return fail("Invalid branch target");
+    }
+
+    bool encode_sse(const SSEInfo& info, std::vector<Operand>& operands){
+        if(!count(operands, 2)){
+            return false;
+        }
+
+        auto& destination = operands[0];
+        auto& source = operands[1];
+
+        if(destination.type == OperandType::FLOAT_REGISTER && (source.type == OperandType::FLOAT_REGISTER || source.type == OperandType::MEMORY)){
+            return emit_modrm(info.prefix, false, {0x0F, info.load}, destination.reg, source);
+        } else if(info.store && destination.type == OperandType::MEMORY && source.type == OperandType::FLOAT_REGISTER){
+            return emit_modrm(info.prefix, false, {0x0F, info.store}, source.reg, destination);
+        }
+
+        return fail("Invalid operands");
+    }
+
+    bool encode_int_to_float(uint8_t prefix, std::vector<Operand>& operands){
+        if(!count(operands, 2)){
+            return false;
+        }
+
+        auto& destination = operands[0];
+        auto& source = operands[1];
+
+        if(destination.type != OperandType::FLOAT_REGISTER || !is_rm(source)){
+            return fail("Invalid operands");
+        }
+
+        //Unsized memory operands have the size of the integers
+        auto size = source.size ? source.size : address_size();
+
+        return emit_modrm(prefix, size == 8, {0x0F, 0x2A}, destination.reg, source);
+    }
+
+    bool encode_float_to_int(uint8_t prefix, std::vector<Operand>& operands){
+        if(!count(operands, 2)){
+            return false;
+        }
+
+        auto& destination = operands[0];
+        auto& source = operands[1];
+
+        if(destination.type != OperandType::REGISTER || !(source.type == OperandType::FLOAT_REGISTER || source.type == OperandType::MEMORY)){
+            return fail("Invalid operands");
+        }
+
+        return emit_modrm(prefix, destination.size == 8, {0x0F, 0x2C}, destination.reg, source);
+    }
+
+    bool encode_movd(bool quad, std::vector<Operand>& operands){
+        if(!count(operands, 2)){
+            return false;
+        }
+
+        auto& destination = operands[0];
+        auto& source = operands[1];
+
+        if(destination.type == OperandType::FLOAT_REGISTER && source.type == OperandType::REGISTER){
+            return emit_modrm(0x66, quad, {0x0F, 0x6E}, destination.reg, source);
+        } else if(destination.type == OperandType::REGISTER && source.type == OperandType::FLOAT_REGISTER){
+            return emit_modrm(0x66, quad, {0x0F, 0x7E}, source.reg, destination);
+        } else if(!quad && destination.type == OperandType::FLOAT_REGISTER && source.type == OperandType::MEMORY){
+            return emit_modrm(0x66, false, {0x0F, 0x6E}, destination.reg, source);
+        } else if(!quad && destination.type == OperandType::MEMORY && source.type == OperandType::FLOAT_REGISTER){
+            return emit_modrm(0x66, false, {0x0F, 0x7E}, source.reg, destination);
+        } else if(quad && destination.type == OperandType::FLOAT_REGISTER){
+            return emit_modrm(0xF3, false, {0x0F, 0x7E}, destination.reg, source);
+        } else if(quad && destination.type == OperandType::MEMORY && source.type == OperandType::FLOAT_REGISTER){
+            return emit_modrm(0x66, false, {0x0F, 0xD6}, source.reg, destination);
+        }
+
+        return fail("Invalid operands");
+    }
+
+    bool instruction(const std::string& mnemonic, std::vector<Operand>& operands){
+        if(auto it = simple.find(mnemonic); it != simple.end()){
+            if(!count(operands, 0)){
+                return false;
+            }
+
+            for(auto byte : it->second){
+                emit_byte(byte);
+            }
+
+            return true;
+        }
+
+        if(mnemonic == "mov"){
+            return encode_mov(operands);
+        } else if(mnemonic == "movzx"){
+            return encode_movzx(operands);
+        } else if(mnemonic == "lea"){
+            if(!count(operands, 2) || operands[0].type != OperandType::REGISTER || operands[1].type != OperandType::MEMORY){
+                return fail("Invalid operands");
+            }
+
+            return emit_modrm(size_prefix(operands[0].size), operands[0].size == 8, {0x8D}, operands[0].reg, operands[1]);
+        } else if(mnemonic == "push"){
+            return encode_push(operands);
+        } else if(mnemonic == "pop"){
+            return encode_pop(operands);
+        } else if(mnemonic == "inc"){
+            return encode_unary(0xFE, 0, operands);
+        } else if(mnemonic == "dec"){
+            return encode_unary(0xFE, 1, operands);
+        } else if(mnemonic == "imul"){
+            return encode_imul(operands);
+        } else if(mnemonic == "int"){
+            if(!count(operands, 1) || operands[0].type != OperandType::IMMEDIATE || !operands[0].symbol.empty()){
+                return fail("Invalid interrupt");
+            }
+
+            emit_byte(0xCD);
+            emit_value(operands[0].value, 1);
+            return true;
+        } else if(mnemonic == "call"){
+            return encode_branch({0xE8}, 2, operands);
+        } else if(mnemonic == "jmp"){
+            return encode_branch({0xE9}, 4, operands);
+        } else if(mnemonic == "cvtsi2ss"){
+            return encode_int_to_float(0xF3, operands);
+        } else if(mnemonic == "cvtsi2sd"){
+            return encode_int_to_float(0xF2, operands);
+        } else if(mnemonic == "cvttss2si"){
+            return encode_float_to_int(0xF3, operands);
+        } else if(mnemonic == "cvttsd2si"){
+            return encode_float_to_int(0xF2, operands);
+        } else if(mnemonic == "movd"){
+            return encode_movd(false, operands);
+        } else if(mnemonic == "movq"){
+            return encode_movd(true, operands);
+        }
+
+        if(auto it = arithmetic.find(mnemonic); it != arithmetic.end()){
+            return encode_arithmetic(it->second, operands);
+        } else if(auto it = unary.find(mnemonic); it != unary.end()){
+            return encode_unary(0xF6, it->second, operands);
+        } else if(auto it = shifts.find(mnemonic); it != shifts.end()){
+            return encode_shift(it->second, operands);
+        } else if(auto it = bit_tests.find(mnemonic); it != bit_tests.end()){
+            return encode_bit_test(it->second, operands);
+        } else if(auto it = sse.find(mnemonic); it != sse.end()){
+            return encode_sse(it->second, operands);
+        }
+
+        if(mnemonic.size() > 1 && mnemonic[0] == 'j'){
+            if(auto it = conditions.find(mnemonic.substr(1)); it != conditions.end()){
+                return encode_branch({0x0F, static_cast<uint8_t>(0x80 + it->second)}, 0, operands);
+            }
+        } else if(mnemonic.size() > 4 && mnemonic.compare(0, 4, "cmov") == 0){
+            if(auto it = conditions.find(mnemonic.substr(4)); it != conditions.end()){
+                return encode_cmov(it->second, operands);
+            }
+        }
+
+        return fail("Unsupported instruction " + mnemonic);
+    }
+
+    //Encode the items of a db, dw, dd or dq directive
+    bool data(unsigned int width, const std::string& items){
+        std::size_t i = 0;
+
+        while(i < items.size()){
+            char c = items[i];
+
+            if(c == ' ' || c == '\t' || c == ','){
+                ++i;
+            } else if(c == '"' || c == '\''){
+                auto end = items.find(c, i + 1);
+
+                if(end == std::string::npos){
+                    return fail("Unterminated string");
+                }
+
+                //The strings are not escaped and are padded to a multiple of the width
+                auto length = end - i - 1;
+                for(std::size_t j = i + 1; j < end; ++j){
+                    emit_byte(items[j]);
+                }
+
+                while(length % width){
+                    emit_byte(0);
+                    ++length;
+                }
+
+                i = end + 1;
+            } else {
+                auto end = items.find(',', i);
+                auto item = trim(items.substr(i, end == std::string::npos ? std::string::npos : end - i));
+                i = end == std::string::npos ? items.size() : end;
+
+                int64_t value = 0;
+                unsigned int float_size = 0;
+
+                if(parse_float(item, value, float_size)){
+                    if(float_size != width){
+                        return fail("Invalid float size");
+                    }
+
+                    emit_value(value, width);
+                } else if(parse_number(item, value)){
+                    emit_value(value, width);
+                } else if(is_symbol(item) && (width == 4 || width == 8)){
+                    emit_fixup(qualify(item), 0, width == 8 ? as::FixupKind::ABSOLUTE_64 : as::FixupKind::ABSOLUTE_32);
+                } else {
+                    return fail("Invalid data " + item);
+                }
+            }
+        }
+
+        return true;
+    }
+
+    static unsigned int data_width(const std::string& directive){
+        if(directive == "db"){
+            return 1;
+        } else if(directive == "dw"){
+            return 2;
+        } else if(directive == "dd"){
+            return 4;
+        } else if(directive == "dq"){
+            return 8;
+        }
+
+        return 0;
+    }
+
+    bool line(const std::string& raw){
+        auto text = raw;
+
+        //Remove the comments, outside of the strings
+        char quote = 0;
+        for(std::size_t i = 0; i < text.size(); ++i){
+            if(quote){
+                if(text[i] == quote){
+                    quote = 0;
+                }
+            } else if(text[i] == '"' || text[i] == '\''){
+                quote = text[i];
+            } else if(text[i] == ';'){
+                text.resize(i);
+                break;
+            }
+        }
+
+        text = trim(text);
+
+        if(repetitions >= 0){
+            if(text == "%endrep"){
+                auto lines = std::move(repeated);
+                auto times = repetitions;
+
+                repeated.clear();
+                repetitions = -1;
+
+                for(int i = 0; i < times; ++i){
+                    for(auto& repeated_line : lines){
+                        if(!line(repeated_line)){
+                            return false;
+                        }
+                    }
+                }
+            } else {
+                repeated.push_back(text);
+            }
+
+            return true;
+        }
+
+        if(text.empty()){
+            return true;
+        }
+
+        auto [first, rest] = split_word(text);
+
+        if(first.back() == ':'){
+            first.pop_back();
+
+            if(!is_symbol(first) || !define(first)){
+                return fail("Invalid label " + first);
+            }
+
+            return line(rest);
+        }
+
+        if(first == "section"){
+            if(rest == ".text"){
+                section = as::Section::TEXT;
+            } else if(rest == ".data"){
+                section = as::Section::DATA;
+            } else {
+                return fail("Unsupported section " + rest);
+            }
+
+            return true;
+        } else if(first == "global" || first == "extern"){
+            return true;
+        } else if(first == "%rep"){
+            int64_t times = 0;
+            if(!parse_number(rest, times) || times < 0){
+                return fail("Invalid repetition count");
+            }
+
+            repetitions = times;
+            return true;
+        } else if(first == "times"){
+            auto [count, repeated_line] = split_word(rest);
+
+            int64_t times = 0;
+            if(!parse_number(count, times) || times < 0){
+                return fail("Invalid repetition count");
+            }
+
+            for(int64_t i = 0; i < times; ++i){
+                if(!line(repeated_line)){
+                    return false;
+                }
+            }
+
+            return true;
+        } else if(auto width = data_width(first)){
+            return data(width, rest);
+        }
+
+        //A label can be defined without colon before a data directive
+        auto second = split_word(rest).first;
+        if(data_width(second) || second == "times"){
+            if(!is_symbol(first) || !define(first)){
+                return fail("Invalid label " + first);
+            }
+
+            return line(rest);
+        }
+
+        //repne and rep are prefixes of the string instructions
+        if(first == "repne" || first == "rep"){
+            emit_byte(first == "repne" ? 0xF2 : 0xF3);
+            return line(rest);
+        }
+
+        std::vector<Operand> operands;
+
+        if(!rest.empty()){
+            std::size_t start = 0;
+
+            while(true){
+                auto end = rest.find(',', start);
+
+                operands.emplace_back();
+                if(!parse_operand(rest.substr(start, end == std::string::npos ? std::string::npos : end - start), operands.back())){
+                    return false;
+                }
+
+                if(end == std::string::npos){
+                    break;
+                }
+
+                start = end + 1;
+            }
+        }
+
+        return instruction(first, operands);
+    }
+};
+
+} //end of anonymous namespace
+
+bool as::encode(Platform platform, std::string_view assembly, ObjectCode& object, std::string& error){
+    Encoder encoder(platform, object, error);
+
+    std::size_t number = 0;
+    std::size_t start = 0;
+
+    while(start < assembly.size()){
+        auto end = assembly.find('\n', start);
+
+        if(end == std::string::npos){
+            end = assembly.size();
+        }
+
+        ++number;
+
+        if(!encoder.line(std::string(assembly.substr(start, end - start)))){
+            error = "line " + std::to_string(number) + ": " + error;
+            return false;
+        }
+
+        start = end + 1;
+    }
+
+    if(encoder.repetitions >= 0){
+        error = "Missing %endrep";
+        return false;
+    }
+
+    return true;
+}
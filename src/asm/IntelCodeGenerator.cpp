@@ -5,6 +5,8 @@
 //  http://opensource.org/licenses/MIT)
 //=======================================================================
 
+#include <fstream>
+
 #include "cpp_utils/assert.hpp"
 
 #include "asm/IntelCodeGenerator.hpp"
@@ -18,10 +20,12 @@
 #include "Type.hpp"
 #include "Variable.hpp"
 #include "FloatPool.hpp"
+#include "Options.hpp"
 
 using namespace eddic;
 
-as::IntelCodeGenerator::IntelCodeGenerator(AssemblyFileWriter& w, mtac::Program& program, GlobalContext& context) : CodeGenerator(w, program), context(context) {}
+as::IntelCodeGenerator::IntelCodeGenerator(AssemblyFileWriter& w, mtac::Program& program, GlobalContext& context, std::shared_ptr<Configuration> configuration) : 
+        CodeGenerator(w, program), context(context), configuration(std::move(configuration)) {}
 
 void as::IntelCodeGenerator::generate(StringPool& pool, FloatPool& float_pool){
     resetNumbering();
@@ -80,6 +84,18 @@ void as::IntelCodeGenerator::addGlobalVariables(StringPool& pool, FloatPool& flo
         declareString(it.second, it.first);
     }
 
+    //The name of the profile file is given as a null-terminated string to the system, it is
+    //written as bytes since the path can contain any character
+    if(!program.profile_file.empty()){
+        writer << "V__profile_file db ";
+
+        for(unsigned char c : program.profile_file){
+            writer << static_cast<int>(c) << ", ";
+        }
+
+        writer << "0" << '\n';
+    }
+
     for (const auto& it : float_pool.get_pool()){
         declareFloat(it.second, it.first);
     }
@@ -97,9 +113,24 @@ void as::IntelCodeGenerator::output_function(const std::string& function){
         if (!line.empty() &&
             (line[0] != ';'))
         {
-            writer.stream() << line << '\n';
+            writer << line << '\n';
         }
     }
 
-    writer.stream() << '\n';
+    writer << '\n';
+}
+
+bool as::IntelCodeGenerator::uses_output_buffer() const {
+    return program.cg.is_reachable(context.getFunction("_F5printC"))
+        || program.cg.is_reachable(context.getFunction("_F5printS"))
+        || program.cg.is_reachable(context.getFunction("_F9read_char"));
+}
+
+std::string as::IntelCodeGenerator::print_functions(const std::string& platform) const {
+    //The interactive programs can write their output immediately
+    if(configuration->option_defined("unbuffered-output")){
+        return platform;
+    }
+
+    return platform + "buffered_";
 }
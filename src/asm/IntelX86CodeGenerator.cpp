@@ -5,8 +5,6 @@
 //  http://opensource.org/licenses/MIT)
 //=======================================================================
 
-#include <ostream>
-
 #include "cpp_utils/assert.hpp"
 
 #include "AssemblyFileWriter.hpp"
@@ -23,7 +21,7 @@
 
 using namespace eddic;
 
-as::IntelX86CodeGenerator::IntelX86CodeGenerator(AssemblyFileWriter& w, mtac::Program& program, GlobalContext & context) : IntelCodeGenerator(w, program, context) {}
+as::IntelX86CodeGenerator::IntelX86CodeGenerator(AssemblyFileWriter& w, mtac::Program& program, GlobalContext & context, std::shared_ptr<Configuration> configuration) : IntelCodeGenerator(w, program, context, std::move(configuration)) {}
 
 namespace {
 
@@ -33,45 +31,45 @@ const std::string registers_16[6] = {"ax", "bx", "cx", "dx", "si", "di"};
 
 const std::string float_registers[8] = {"xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7"};
 
-struct X86_32StringConverter : public as::StringConverter, public boost::static_visitor<std::string> {
-    std::string operator()(ltac::Register& reg) const {
+struct X86_32StringConverter : public as::StringConverter, public boost::static_visitor<> {
+    explicit X86_32StringConverter(AssemblyFileWriter& writer) : StringConverter(writer) {}
+
+    void operator()(ltac::Register& reg) const {
         if(static_cast<int>(reg) == 1000){
-            return "esp";
+            writer << "esp";
         } else if(static_cast<int>(reg) == 1001){
-            return "ebp";
+            writer << "ebp";
+        } else {
+            writer << registers[static_cast<int>(reg)];
         }
-
-        return registers[static_cast<int>(reg)];
     }
 
-    std::string operator()(ltac::FloatRegister& reg) const {
-        return float_registers[static_cast<int>(reg)];
+    void operator()(ltac::FloatRegister& reg) const {
+        writer << float_registers[static_cast<int>(reg)];
     }
 
-    std::string operator()(ltac::Address& address) const {
-        return address_to_string(address);
+    void operator()(ltac::Address& address) const {
+        this->address(address);
     }
 
-    std::string operator()(int value) const {
-       return std::to_string(value);
+    void operator()(int value) const {
+       writer << value;
     }
 
-    std::string operator()(const std::string& value) const {
-        return value;
+    void operator()(const std::string& value) const {
+        writer << value;
     }
 
-    std::string operator()(ltac::PseudoRegister&) const {
+    void operator()(ltac::PseudoRegister&) const {
         cpp_unreachable("All the pseudo registers should have been converted into a hard register");
     }
 
-    std::string operator()(ltac::PseudoFloatRegister&) const {
+    void operator()(ltac::PseudoFloatRegister&) const {
         cpp_unreachable("All the pseudo registers should have been converted into a hard register");
     }
 
-    std::string operator()(double value) const {
-        std::stringstream ss;
-        ss << "__float32__(" << std::fixed << value << ")";
-        return ss.str();
+    void operator()(double value) const {
+        writer << "__float32__(" << value << ")";
     }
 };
 
@@ -79,9 +77,10 @@ struct X86_32StringConverter : public as::StringConverter, public boost::static_
 
 namespace x86 {
 
-std::ostream& operator<<(std::ostream& os, eddic::ltac::Argument& arg){
-    X86_32StringConverter converter;
-    return os << visit(converter, arg);
+AssemblyFileWriter& operator<<(AssemblyFileWriter& writer, eddic::ltac::Argument& arg){
+    X86_32StringConverter converter(writer);
+    visit(converter, arg);
+    return writer;
 }
 
 } //end of x86 namespace
@@ -90,14 +89,14 @@ using namespace x86;
 
 namespace {
 
-std::string get_register_8(ltac::Register& reg){
+const std::string& get_register_8(ltac::Register& reg){
     cpp_assert(reg.reg < 6, "SP and BP registers cannot be subclassed");
-    auto sub_reg = registers_8[reg.reg];
+    auto& sub_reg = registers_8[reg.reg];
     cpp_assert(!sub_reg.empty(), "RSI and RDI are not 8-bit allocatable");
     return sub_reg;
 }
 
-std::string get_register_16(ltac::Register& reg){
+const std::string& get_register_16(ltac::Register& reg){
     cpp_assert(reg.reg < 6, "SP and BP registers cannot be subclassed");
     return registers_16[reg.reg];
 }
@@ -105,7 +104,7 @@ std::string get_register_16(ltac::Register& reg){
 void compile_statement(AssemblyFileWriter& writer, ltac::Instruction& instruction){
     switch(instruction.op){
         case ltac::Operator::LABEL:
-            writer.stream() << "." << instruction.label << ":" << '\n';
+            writer << "." << instruction.label << ":" << '\n';
             break;
         case ltac::Operator::MOV:
             if(instruction.size != tac::Size::DEFAULT){
@@ -113,25 +112,25 @@ void compile_statement(AssemblyFileWriter& writer, ltac::Instruction& instructio
                     if(auto* ptr = boost::get<ltac::Register>(&*instruction.arg2)){
                         switch(instruction.size){
                             case tac::Size::BYTE:
-                                writer.stream() << "mov byte " << *instruction.arg1 << ", " << get_register_8(*ptr) << '\n';
+                                writer << "mov byte " << *instruction.arg1 << ", " << get_register_8(*ptr) << '\n';
                                 break;
                             case tac::Size::WORD:
-                                writer.stream() << "mov word " << *instruction.arg1 << ", " << get_register_16(*ptr) << '\n';
+                                writer << "mov word " << *instruction.arg1 << ", " << get_register_16(*ptr) << '\n';
                                 break;
                             default:
-                                writer.stream() << "mov dword " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+                                writer << "mov dword " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
                                 break;
                         }
                     } else {
                         switch(instruction.size){
                             case tac::Size::BYTE:
-                                writer.stream() << "mov byte " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+                                writer << "mov byte " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
                                 break;
                             case tac::Size::WORD:
-                                writer.stream() << "mov word " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+                                writer << "mov word " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
                                 break;
                             default:
-                                writer.stream() << "mov dword " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+                                writer << "mov dword " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
                                 break;
                         }
                     }
@@ -140,13 +139,13 @@ void compile_statement(AssemblyFileWriter& writer, ltac::Instruction& instructio
                     //movzx should be chosen higher
                     switch(instruction.size){
                         case tac::Size::BYTE:
-                            writer.stream() << "movzx " << *instruction.arg1 << ", byte " << *instruction.arg2 << '\n';
+                            writer << "movzx " << *instruction.arg1 << ", byte " << *instruction.arg2 << '\n';
                             break;
                         case tac::Size::WORD:
-                            writer.stream() << "movzx " << *instruction.arg1 << ", word " << *instruction.arg2 << '\n';
+                            writer << "movzx " << *instruction.arg1 << ", word " << *instruction.arg2 << '\n';
                             break;
                         default:
-                            writer.stream() << "mov " << *instruction.arg1 << ", dword " << *instruction.arg2 << '\n';
+                            writer << "mov " << *instruction.arg1 << ", dword " << *instruction.arg2 << '\n';
                             break;
                     }
                 }
@@ -155,201 +154,201 @@ void compile_statement(AssemblyFileWriter& writer, ltac::Instruction& instructio
             }
 
             if(boost::get<ltac::FloatRegister>(&*instruction.arg1) && boost::get<ltac::Register>(&*instruction.arg2)){
-                writer.stream() << "movd " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+                writer << "movd " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             } else if(boost::get<ltac::Register>(&*instruction.arg1) && boost::get<ltac::FloatRegister>(&*instruction.arg2)){
-                writer.stream() << "movd " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+                writer << "movd " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             } else if(boost::get<ltac::Address>(&*instruction.arg1)){
-                writer.stream() << "mov dword " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+                writer << "mov dword " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             } else {
-                writer.stream() << "mov " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+                writer << "mov " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             }
 
             break;
         case ltac::Operator::FMOV:
             if(boost::get<ltac::FloatRegister>(&*instruction.arg1) && boost::get<ltac::Register>(&*instruction.arg2)){
-                writer.stream() << "movd " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+                writer << "movd " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             } else {
-                writer.stream() << "movss " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+                writer << "movss " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             }
 
             break;
         case ltac::Operator::ENTER:
-            writer.stream() << "push ebp" << '\n';
-            writer.stream() << "mov ebp, esp" << '\n';
+            writer << "push ebp" << '\n';
+            writer << "mov ebp, esp" << '\n';
             break;
         case ltac::Operator::LEAVE:
-            writer.stream() << "mov esp, ebp" << '\n';
-            writer.stream() << "pop ebp" << '\n';
+            writer << "mov esp, ebp" << '\n';
+            writer << "pop ebp" << '\n';
             break;
         case ltac::Operator::RET:
-            writer.stream() << "ret" << '\n';
+            writer << "ret" << '\n';
             break;
         case ltac::Operator::CMP_INT:
-            writer.stream() << "cmp " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "cmp " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::CMP_FLOAT:
-            writer.stream() << "ucomiss " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "ucomiss " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::OR:
-            writer.stream() << "or " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "or " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::XOR:
-            writer.stream() << "xor " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "xor " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::PUSH:
             if(boost::get<ltac::Address>(&*instruction.arg1)){
-                writer.stream() << "push dword " << *instruction.arg1 << '\n';
+                writer << "push dword " << *instruction.arg1 << '\n';
             } else {
-                writer.stream() << "push " << *instruction.arg1 << '\n';
+                writer << "push " << *instruction.arg1 << '\n';
             }
 
             break;
         case ltac::Operator::POP:
-            writer.stream() << "pop " << *instruction.arg1 << '\n';
+            writer << "pop " << *instruction.arg1 << '\n';
             break;
         case ltac::Operator::LEA:
-            writer.stream() << "lea " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "lea " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::SHIFT_LEFT:
-            writer.stream() << "sal " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "sal " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::SHIFT_RIGHT:
-            writer.stream() << "sar " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "sar " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::ADD:
-            writer.stream() << "add " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "add " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::SUB:
-            writer.stream() << "sub " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "sub " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::MUL2:
         case ltac::Operator::MUL3:
             if(instruction.arg3){
-                writer.stream() << "imul " << *instruction.arg1 << ", " << *instruction.arg2 << ", " << *instruction.arg3 << '\n';
+                writer << "imul " << *instruction.arg1 << ", " << *instruction.arg2 << ", " << *instruction.arg3 << '\n';
             } else {
-                writer.stream() << "imul " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+                writer << "imul " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             }
 
             break;
         case ltac::Operator::DIV:
-            writer.stream() << "idiv " << *instruction.arg1 << '\n';
+            writer << "idiv " << *instruction.arg1 << '\n';
             break;
         case ltac::Operator::FADD:
-            writer.stream() << "addss " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "addss " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::FSUB:
-            writer.stream() << "subss " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "subss " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::FMUL:
-            writer.stream() << "mulss " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "mulss " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::FDIV:
-            writer.stream() << "divss " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "divss " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::INC:
-            writer.stream() << "inc " << *instruction.arg1 << '\n';
+            writer << "inc " << *instruction.arg1 << '\n';
             break;
         case ltac::Operator::DEC:
-            writer.stream() << "dec " << *instruction.arg1 << '\n';
+            writer << "dec " << *instruction.arg1 << '\n';
             break;
         case ltac::Operator::NEG:
-            writer.stream() << "neg " << *instruction.arg1 << '\n';
+            writer << "neg " << *instruction.arg1 << '\n';
             break;
         case ltac::Operator::NOT:
-            writer.stream() << "not " << *instruction.arg1 << '\n';
+            writer << "not " << *instruction.arg1 << '\n';
             break;
         case ltac::Operator::AND:
-            writer.stream() << "and " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "and " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::I2F:
-            writer.stream() << "cvtsi2ss " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "cvtsi2ss " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::F2I:
-            writer.stream() << "cvttss2si " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "cvttss2si " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::CMOVE:
-            writer.stream() << "cmove " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "cmove " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::CMOVNE:
-            writer.stream() << "cmovne " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "cmovne " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::CMOVA:
-            writer.stream() << "cmova " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "cmova " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::CMOVAE:
-            writer.stream() << "cmovae " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "cmovae " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::CMOVB:
-            writer.stream() << "cmovb " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "cmovb " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::CMOVBE:
-            writer.stream() << "cmovbe " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "cmovbe " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::CMOVG:
-            writer.stream() << "cmovg " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "cmovg " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::CMOVGE:
-            writer.stream() << "cmovge " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "cmovge " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::CMOVL:
-            writer.stream() << "cmovl " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "cmovl " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::CMOVLE:
-            writer.stream() << "cmovle " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "cmovle " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::XORPS:
-            writer.stream() << "xorps " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "xorps " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::MOVDQU:
-            writer.stream() << "movdqu " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "movdqu " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::NOP:
             //Nothing to output for a nop
             break;
         case ltac::Operator::CALL:
-            writer.stream() << "call " << instruction.label << '\n';
+            writer << "call " << instruction.label << '\n';
             break;
         case ltac::Operator::ALWAYS:
-            writer.stream() << "jmp " << "." << instruction.label << '\n';
+            writer << "jmp " << "." << instruction.label << '\n';
             break;
         case ltac::Operator::NE:
-            writer.stream() << "jne " << "." << instruction.label << '\n';
+            writer << "jne " << "." << instruction.label << '\n';
             break;
         case ltac::Operator::E:
-            writer.stream() << "je " << "." << instruction.label << '\n';
+            writer << "je " << "." << instruction.label << '\n';
             break;
         case ltac::Operator::GE:
-            writer.stream() << "jge " << "." << instruction.label << '\n';
+            writer << "jge " << "." << instruction.label << '\n';
             break;
         case ltac::Operator::G:
-            writer.stream() << "jg " << "." << instruction.label << '\n';
+            writer << "jg " << "." << instruction.label << '\n';
             break;
         case ltac::Operator::LE:
-            writer.stream() << "jle " << "." << instruction.label << '\n';
+            writer << "jle " << "." << instruction.label << '\n';
             break;
         case ltac::Operator::L:
-            writer.stream() << "jl " << "." << instruction.label << '\n';
+            writer << "jl " << "." << instruction.label << '\n';
             break;
         case ltac::Operator::AE:
-            writer.stream() << "jae " << "." << instruction.label << '\n';
+            writer << "jae " << "." << instruction.label << '\n';
             break;
         case ltac::Operator::A:
-            writer.stream() << "ja" << "." << instruction.label << '\n';
+            writer << "ja " << "." << instruction.label << '\n';
             break;
         case ltac::Operator::BE:
-            writer.stream() << "jbe " << "." << instruction.label << '\n';
+            writer << "jbe " << "." << instruction.label << '\n';
             break;
         case ltac::Operator::B:
-            writer.stream() << "jb " << "." << instruction.label << '\n';
+            writer << "jb " << "." << instruction.label << '\n';
             break;
         case ltac::Operator::P:
-            writer.stream() << "jp " << "." << instruction.label << '\n';
+            writer << "jp " << "." << instruction.label << '\n';
             break;
         case ltac::Operator::Z:
-            writer.stream() << "jz " << "." << instruction.label << '\n';
+            writer << "jz " << "." << instruction.label << '\n';
             break;
         case ltac::Operator::NZ:
-            writer.stream() << "jnz " << "." << instruction.label << '\n';
+            writer << "jnz " << "." << instruction.label << '\n';
             break;
         default:
             cpp_unreachable("The instruction operator is not supported");
@@ -359,7 +358,7 @@ void compile_statement(AssemblyFileWriter& writer, ltac::Instruction& instructio
 } //end of anonymous namespace
 
 void as::IntelX86CodeGenerator::compile(mtac::Function& function){
-    writer.stream() << '\n' << function.get_name() << ":" << '\n';
+    writer << '\n' << function.get_name() << ":" << '\n';
 
     for(auto& bb : function){
         for(auto& statement : bb->l_statements){
@@ -369,122 +368,132 @@ void as::IntelX86CodeGenerator::compile(mtac::Function& function){
 }
 
 void as::IntelX86CodeGenerator::writeRuntimeSupport(){
-    writer.stream() << "section .text" << '\n' << '\n';
+    writer << "section .text" << '\n' << '\n';
 
-    writer.stream() << "global _start" << '\n' << '\n';
+    writer << "global _start" << '\n' << '\n';
 
-    writer.stream() << "_start:" << '\n';
+    writer << "_start:" << '\n';
 
     //If necessary init memory manager
     if(context.exists("_F4mainAS")
             || program.cg.is_reachable(context.getFunction("_F4freePI"))
             || program.cg.is_reachable(context.getFunction("_F5allocI"))){
-        writer.stream() << "call _F4init" << '\n';
+        writer << "call _F4init" << '\n';
     }
 
     //If the user wants the args, we add support for them
     if(context.exists("_F4mainAS")){
-        writer.stream() << "pop ebx" << '\n';                          //ebx = number of args
+        writer << "pop ebx" << '\n';                          //ebx = number of args
 
-        writer.stream() << "lea ecx, [4 + ebx * 8]" << '\n';           //ecx = size of the array
-        writer.stream() << "call _F5allocI" << '\n';                  //eax = start address of the array
+        writer << "lea ecx, [4 + ebx * 8]" << '\n';           //ecx = size of the array
+        writer << "call _F5allocI" << '\n';                  //eax = start address of the array
 
-        writer.stream() << "mov esi, eax" << '\n';         //esi = last address of the array
-        writer.stream() << "mov edx, esi" << '\n';                     //edx = last address of the array
+        writer << "mov esi, eax" << '\n';         //esi = last address of the array
+        writer << "mov edx, esi" << '\n';                     //edx = last address of the array
 
-        writer.stream() << "mov [esi], ebx" << '\n';                   //Set the length of the array
-        writer.stream() << "add esi, 4" << '\n';                       //Move to the destination address of the first arg
+        writer << "mov [esi], ebx" << '\n';                   //Set the length of the array
+        writer << "add esi, 4" << '\n';                       //Move to the destination address of the first arg
 
-        writer.stream() << ".copy_args:" << '\n';
-        writer.stream() << "pop edi" << '\n';                          //edi = address of current args
-        writer.stream() << "mov [esi], edi" << '\n';                 //set the address of the string
+        writer << ".copy_args:" << '\n';
+        writer << "pop edi" << '\n';                          //edi = address of current args
+        writer << "mov [esi], edi" << '\n';                 //set the address of the string
 
         /* Calculate the length of the string  */
-        writer.stream() << "xor eax, eax" << '\n';
-        writer.stream() << "xor ecx, ecx" << '\n';
-        writer.stream() << "not ecx" << '\n';
-        writer.stream() << "repne scasb" << '\n';
-        writer.stream() << "not ecx" << '\n';
-        writer.stream() << "dec ecx" << '\n';
+        writer << "xor eax, eax" << '\n';
+        writer << "xor ecx, ecx" << '\n';
+        writer << "not ecx" << '\n';
+        writer << "repne scasb" << '\n';
+        writer << "not ecx" << '\n';
+        writer << "dec ecx" << '\n';
         /* End of the calculation */
 
-        writer.stream() << "mov [esi+4], ecx" << '\n';               //set the length of the string
-        writer.stream() << "add esi, 8" << '\n';
-        writer.stream() << "dec ebx" << '\n';
-        writer.stream() << "jnz .copy_args" << '\n';
+        writer << "mov [esi+4], ecx" << '\n';               //set the length of the string
+        writer << "add esi, 8" << '\n';
+        writer << "dec ebx" << '\n';
+        writer << "jnz .copy_args" << '\n';
 
-        writer.stream() << "push edx" << '\n';
+        writer << "push edx" << '\n';
     }
 
     /* Give control to the user main function */
     if(context.exists("_F4mainAS")){
-        writer.stream() << "call _F4mainAS" << '\n';
+        writer << "call _F4mainAS" << '\n';
     } else {
-        writer.stream() << "call _F4main" << '\n';
+        writer << "call _F4main" << '\n';
+    }
+
+    /* Write the buffered output */
+    if(uses_output_buffer()){
+        writer << "call _F5flush" << '\n';
+    }
+
+    /* Write the counters of the instrumented program */
+    if(!program.profile_file.empty()){
+        writer << "call _F12profile_dump" << '\n';
     }
 
     /* Exit the program */
-    writer.stream() << "mov eax, 1" << '\n';
-    writer.stream() << "xor ebx, ebx" << '\n';
-    writer.stream() << "int 80h" << '\n';
+    writer << "mov eax, 1" << '\n';
+    writer << "xor ebx, ebx" << '\n';
+    writer << "int 80h" << '\n';
 }
 
 void as::IntelX86CodeGenerator::defineDataSection(){
-    writer.stream() << '\n' << "section .data" << '\n';
+    writer << '\n' << "section .data" << '\n';
 }
 
 void as::IntelX86CodeGenerator::declareIntArray(const std::string& name, unsigned int size){
-    writer.stream() << "V" << name << ":" <<'\n';
-    writer.stream() << "dd " << size << '\n';
-    writer.stream() << "times " << size << " dd 0" << '\n';
+    writer << "V" << name << ":" <<'\n';
+    writer << "dd " << size << '\n';
+    writer << "times " << size << " dd 0" << '\n';
 }
 
 void as::IntelX86CodeGenerator::declareFloatArray(const std::string& name, unsigned int size){
-    writer.stream() << "V" << name << ":" <<'\n';
-    writer.stream() << "dd " << size << '\n';
-    writer.stream() << "times " << size << " dd __float32__(0.0)" << '\n';
+    writer << "V" << name << ":" <<'\n';
+    writer << "dd " << size << '\n';
+    writer << "times " << size << " dd __float32__(0.0)" << '\n';
 }
 
 void as::IntelX86CodeGenerator::declareStringArray(const std::string& name, unsigned int size){
-    writer.stream() << "V" << name << ":" <<'\n';
-    writer.stream() << "dd " << size << '\n';
-    writer.stream() << "%rep " << size << '\n';
-    writer.stream() << "dd S1" << '\n';
-    writer.stream() << "dd 0" << '\n';
-    writer.stream() << "%endrep" << '\n';
+    writer << "V" << name << ":" <<'\n';
+    writer << "dd " << size << '\n';
+    writer << "%rep " << size << '\n';
+    writer << "dd S1" << '\n';
+    writer << "dd 0" << '\n';
+    writer << "%endrep" << '\n';
 }
 
 void as::IntelX86CodeGenerator::declareIntVariable(const std::string& name, int value){
-    writer.stream() << "V" << name << " dd " << value << '\n';
+    writer << "V" << name << " dd " << value << '\n';
 }
 
 void as::IntelX86CodeGenerator::declareBoolVariable(const std::string& name, bool value){
-    writer.stream() << "V" << name << " db " << value << '\n';
+    writer << "V" << name << " db " << value << '\n';
 }
 
 void as::IntelX86CodeGenerator::declareCharVariable(const std::string& name, char value){
-    writer.stream() << "V" << name << " db " << value << '\n';
+    writer << "V" << name << " db " << value << '\n';
 }
 
 void as::IntelX86CodeGenerator::declareStringVariable(const std::string& name, const std::string& label, int size){
-    writer.stream() << "V" << name << " dd " << label << ", " << size << '\n';
+    writer << "V" << name << " dd " << label << ", " << size << '\n';
 }
 
 void as::IntelX86CodeGenerator::declareString(const std::string& label, const std::string& value){
-    writer.stream() << label << " dd \"" << value << "\"\n";
+    writer << label << " dd \"" << value << "\"\n";
 }
 
 void as::IntelX86CodeGenerator::declareFloat(const std::string& label, double value){
-    writer.stream() << std::fixed << label << " dd __float32__(" << value << ")" << '\n';
+    writer << label << " dd __float32__(" << value << ")" << '\n';
 }
 
 void as::IntelX86CodeGenerator::addStandardFunctions(){
     if(program.cg.is_reachable(context.getFunction("_F5printC"))){
-        output_function("x86_32_printC");
+        output_function(print_functions("x86_32_") + "printC");
     }
 
     if(program.cg.is_reachable(context.getFunction("_F5printS"))){
-        output_function("x86_32_printS");
+        output_function(print_functions("x86_32_") + "printS");
     }
 
     //Memory management functions are included the three together
@@ -505,4 +514,12 @@ void as::IntelX86CodeGenerator::addStandardFunctions(){
     if(program.cg.is_reachable(context.getFunction("_F9read_char"))){
         output_function("x86_32_read_char");
     }
+
+    if(uses_output_buffer()){
+        output_function("x86_32_flush");
+    }
+
+    if(!program.profile_file.empty()){
+        output_function("x86_32_profile_dump");
+    }
 }
@@ -5,8 +5,6 @@
 //  http://opensource.org/licenses/MIT)
 //=======================================================================
 
-#include <ostream>
-
 #include "cpp_utils/assert.hpp"
 
 #include "AssemblyFileWriter.hpp"
@@ -25,8 +23,8 @@
 
 using namespace eddic;
 
-as::IntelX86_64CodeGenerator::IntelX86_64CodeGenerator(AssemblyFileWriter& w, mtac::Program& program, GlobalContext & context) :
-    IntelCodeGenerator(w, program, context) {}
+as::IntelX86_64CodeGenerator::IntelX86_64CodeGenerator(AssemblyFileWriter& w, mtac::Program& program, GlobalContext & context, std::shared_ptr<Configuration> configuration) :
+    IntelCodeGenerator(w, program, context, std::move(configuration)) {}
 
 namespace {
 
@@ -48,45 +46,45 @@ const std::string registers_32[14] = {
 
 const std::string float_registers[8] = {"xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7"};
 
-struct X86_64StringConverter : public as::StringConverter, public boost::static_visitor<std::string> {
-    std::string operator()(ltac::Register& reg) const {
+struct X86_64StringConverter : public as::StringConverter, public boost::static_visitor<> {
+    explicit X86_64StringConverter(AssemblyFileWriter& writer) : StringConverter(writer) {}
+
+    void operator()(ltac::Register& reg) const {
         if(static_cast<int>(reg) == 1000){
-            return "rsp";
+            writer << "rsp";
         } else if(static_cast<int>(reg) == 1001){
-            return "rbp";
+            writer << "rbp";
+        } else {
+            writer << registers[static_cast<int>(reg)];
         }
-
-        return registers[static_cast<int>(reg)];
     }
 
-    std::string operator()(ltac::FloatRegister& reg) const {
-        return float_registers[static_cast<int>(reg)];
+    void operator()(ltac::FloatRegister& reg) const {
+        writer << float_registers[static_cast<int>(reg)];
     }
 
-    std::string operator()(ltac::Address& address) const {
-        return address_to_string(address);
+    void operator()(ltac::Address& address) const {
+        this->address(address);
     }
 
-    std::string operator()(int value) const {
-       return std::to_string(value);
+    void operator()(int value) const {
+       writer << value;
     }
 
-    std::string operator()(const std::string& value) const {
-        return value;
+    void operator()(const std::string& value) const {
+        writer << value;
     }
 
-    std::string operator()(ltac::PseudoRegister&) const {
+    void operator()(ltac::PseudoRegister&) const {
         cpp_unreachable("All the pseudo registers should have been converted into a hard register");
     }
 
-    std::string operator()(ltac::PseudoFloatRegister&) const {
+    void operator()(ltac::PseudoFloatRegister&) const {
         cpp_unreachable("All the pseudo registers should have been converted into a hard register");
     }
 
-    std::string operator()(double value) const {
-        std::stringstream ss;
-        ss << "__float64__(" << std::fixed << value << ")";
-        return ss.str();
+    void operator()(double value) const {
+        writer << "__float64__(" << value << ")";
     }
 };
 
@@ -94,9 +92,10 @@ struct X86_64StringConverter : public as::StringConverter, public boost::static_
 
 namespace x86_64 {
 
-std::ostream& operator<<(std::ostream& os, eddic::ltac::Argument& arg){
-    X86_64StringConverter converter;
-    return os << visit(converter, arg);
+AssemblyFileWriter& operator<<(AssemblyFileWriter& writer, eddic::ltac::Argument& arg){
+    X86_64StringConverter converter(writer);
+    visit(converter, arg);
+    return writer;
 }
 
 } //end of x86_64 namespace
@@ -105,19 +104,19 @@ using namespace x86_64;
 
 namespace {
 
-std::string get_register_8(ltac::Register& reg){
+const std::string& get_register_8(ltac::Register& reg){
     cpp_assert(reg.reg < 14, "SP and BP registers cannot be subclassed");
-    auto sub_reg = registers_8[reg.reg];
+    auto& sub_reg = registers_8[reg.reg];
     cpp_assert(!sub_reg.empty(), "The register is not 8-bit allocatable");
     return sub_reg;
 }
 
-std::string get_register_16(ltac::Register& reg){
+const std::string& get_register_16(ltac::Register& reg){
     cpp_assert(reg.reg < 14, "SP and BP registers cannot be subclassed");
     return registers_16[reg.reg];
 }
 
-std::string get_register_32(ltac::Register& reg){
+const std::string& get_register_32(ltac::Register& reg){
     cpp_assert(reg.reg < 14, "SP and BP registers cannot be subclassed");
     return registers_32[reg.reg];
 }
@@ -125,7 +124,7 @@ std::string get_register_32(ltac::Register& reg){
 void compile_statement(AssemblyFileWriter& writer, ltac::Instruction& instruction){
     switch(instruction.op){
         case ltac::Operator::LABEL:
-            writer.stream() << "." << instruction.label << ":" << '\n';
+            writer << "." << instruction.label << ":" << '\n';
             break;
         case ltac::Operator::MOV:
             if(instruction.size != tac::Size::DEFAULT){
@@ -133,31 +132,31 @@ void compile_statement(AssemblyFileWriter& writer, ltac::Instruction& instructio
                     if(auto* ptr = boost::get<ltac::Register>(&*instruction.arg2)){
                         switch(instruction.size){
                             case tac::Size::BYTE:
-                                writer.stream() << "mov byte " << *instruction.arg1 << ", " << get_register_8(*ptr) << '\n';
+                                writer << "mov byte " << *instruction.arg1 << ", " << get_register_8(*ptr) << '\n';
                                 break;
                             case tac::Size::WORD:
-                                writer.stream() << "mov word " << *instruction.arg1 << ", " << get_register_16(*ptr) << '\n';
+                                writer << "mov word " << *instruction.arg1 << ", " << get_register_16(*ptr) << '\n';
                                 break;
                             case tac::Size::DOUBLE_WORD:
-                                writer.stream() << "mov dword " << *instruction.arg1 << ", " << get_register_32(*ptr) << '\n';
+                                writer << "mov dword " << *instruction.arg1 << ", " << get_register_32(*ptr) << '\n';
                                 break;
                             default:
-                                writer.stream() << "mov qword " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+                                writer << "mov qword " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
                                 break;
                         }
                     } else {
                         switch(instruction.size){
                             case tac::Size::BYTE:
-                                writer.stream() << "mov byte " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+                                writer << "mov byte " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
                                 break;
                             case tac::Size::WORD:
-                                writer.stream() << "mov word " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+                                writer << "mov word " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
                                 break;
                             case tac::Size::DOUBLE_WORD:
-                                writer.stream() << "mov dword " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+                                writer << "mov dword " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
                                 break;
                             default:
-                                writer.stream() << "mov qword " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+                                writer << "mov qword " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
                                 break;
                         }
                     }
@@ -167,16 +166,16 @@ void compile_statement(AssemblyFileWriter& writer, ltac::Instruction& instructio
 
                     switch(instruction.size){
                         case tac::Size::BYTE:
-                            writer.stream() << "movzx " << *instruction.arg1 << ", byte " << *instruction.arg2 << '\n';
+                            writer << "movzx " << *instruction.arg1 << ", byte " << *instruction.arg2 << '\n';
                             break;
                         case tac::Size::WORD:
-                            writer.stream() << "movzx " << *instruction.arg1 << ", word " << *instruction.arg2 << '\n';
+                            writer << "movzx " << *instruction.arg1 << ", word " << *instruction.arg2 << '\n';
                             break;
                         case tac::Size::DOUBLE_WORD:
-                            writer.stream() << "movzx " << *instruction.arg1 << ", dword " << *instruction.arg2 << '\n';
+                            writer << "movzx " << *instruction.arg1 << ", dword " << *instruction.arg2 << '\n';
                             break;
                         default:
-                            writer.stream() << "mov " << *instruction.arg1 << ", qword " << *instruction.arg2 << '\n';
+                            writer << "mov " << *instruction.arg1 << ", qword " << *instruction.arg2 << '\n';
                             break;
                     }
                 }
@@ -185,201 +184,201 @@ void compile_statement(AssemblyFileWriter& writer, ltac::Instruction& instructio
             }
 
             if(boost::get<ltac::FloatRegister>(&*instruction.arg1) && boost::get<ltac::Register>(&*instruction.arg2)){
-                writer.stream() << "movq " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+                writer << "movq " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             } else if(boost::get<ltac::Register>(&*instruction.arg1) && boost::get<ltac::FloatRegister>(&*instruction.arg2)){
-                writer.stream() << "movq " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+                writer << "movq " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             } else if(boost::get<ltac::Address>(&*instruction.arg1)){
-                writer.stream() << "mov qword " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+                writer << "mov qword " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             } else {
-                writer.stream() << "mov " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+                writer << "mov " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             }
 
             break;
         case ltac::Operator::FMOV:
             if(boost::get<ltac::FloatRegister>(&*instruction.arg1) && boost::get<ltac::Register>(&*instruction.arg2)){
-                writer.stream() << "movq " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+                writer << "movq " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             } else {
-                writer.stream() << "movsd " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+                writer << "movsd " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             }
 
             break;
         case ltac::Operator::ENTER:
-            writer.stream() << "push rbp" << '\n';
-            writer.stream() << "mov rbp, rsp" << '\n';
+            writer << "push rbp" << '\n';
+            writer << "mov rbp, rsp" << '\n';
             break;
         case ltac::Operator::LEAVE:
-            writer.stream() << "mov rsp, rbp" << '\n';
-            writer.stream() << "pop rbp" << '\n';
+            writer << "mov rsp, rbp" << '\n';
+            writer << "pop rbp" << '\n';
             break;
         case ltac::Operator::RET:
-            writer.stream() << "ret" << '\n';
+            writer << "ret" << '\n';
             break;
         case ltac::Operator::CMP_INT:
-            writer.stream() << "cmp " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "cmp " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::CMP_FLOAT:
-            writer.stream() << "ucomisd " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "ucomisd " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::OR:
-            writer.stream() << "or " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "or " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::XOR:
-            writer.stream() << "xor " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "xor " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::PUSH:
             if(boost::get<ltac::Address>(&*instruction.arg1)){
-                writer.stream() << "push qword " << *instruction.arg1 << '\n';
+                writer << "push qword " << *instruction.arg1 << '\n';
             } else {
-                writer.stream() << "push " << *instruction.arg1 << '\n';
+                writer << "push " << *instruction.arg1 << '\n';
             }
 
             break;
         case ltac::Operator::POP:
-            writer.stream() << "pop " << *instruction.arg1 << '\n';
+            writer << "pop " << *instruction.arg1 << '\n';
             break;
         case ltac::Operator::LEA:
-            writer.stream() << "lea " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "lea " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::SHIFT_LEFT:
-            writer.stream() << "sal " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "sal " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::SHIFT_RIGHT:
-            writer.stream() << "sar " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "sar " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::ADD:
-            writer.stream() << "add " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "add " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::SUB:
-            writer.stream() << "sub " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "sub " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::MUL2:
         case ltac::Operator::MUL3:
             if(instruction.arg3){
-                writer.stream() << "imul " << *instruction.arg1 << ", " << *instruction.arg2 << ", " << *instruction.arg3 << '\n';
+                writer << "imul " << *instruction.arg1 << ", " << *instruction.arg2 << ", " << *instruction.arg3 << '\n';
             } else {
-                writer.stream() << "imul " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+                writer << "imul " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             }
 
             break;
         case ltac::Operator::DIV:
-            writer.stream() << "idiv " << *instruction.arg1 << '\n';
+            writer << "idiv " << *instruction.arg1 << '\n';
             break;
         case ltac::Operator::FADD:
-            writer.stream() << "addsd " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "addsd " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::FSUB:
-            writer.stream() << "subsd " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "subsd " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::FMUL:
-            writer.stream() << "mulsd " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "mulsd " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::FDIV:
-            writer.stream() << "divsd " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "divsd " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::INC:
-            writer.stream() << "inc " << *instruction.arg1 << '\n';
+            writer << "inc " << *instruction.arg1 << '\n';
             break;
         case ltac::Operator::DEC:
-            writer.stream() << "dec " << *instruction.arg1 << '\n';
+            writer << "dec " << *instruction.arg1 << '\n';
             break;
         case ltac::Operator::NEG:
-            writer.stream() << "neg " << *instruction.arg1 << '\n';
+            writer << "neg " << *instruction.arg1 << '\n';
             break;
         case ltac::Operator::NOT:
-            writer.stream() << "btc " << *instruction.arg1 << ", 0" << '\n';
+            writer << "btc " << *instruction.arg1 << ", 0" << '\n';
             break;
         case ltac::Operator::AND:
-            writer.stream() << "and " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "and " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::I2F:
-            writer.stream() << "cvtsi2sd " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "cvtsi2sd " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::F2I:
-            writer.stream() << "cvttsd2si " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "cvttsd2si " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::CMOVE:
-            writer.stream() << "cmove " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "cmove " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::CMOVNE:
-            writer.stream() << "cmovne " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "cmovne " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::CMOVA:
-            writer.stream() << "cmova " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "cmova " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::CMOVAE:
-            writer.stream() << "cmovae " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "cmovae " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::CMOVB:
-            writer.stream() << "cmovb " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "cmovb " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::CMOVBE:
-            writer.stream() << "cmovbe " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "cmovbe " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::CMOVG:
-            writer.stream() << "cmovg " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "cmovg " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::CMOVGE:
-            writer.stream() << "cmovge " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "cmovge " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::CMOVL:
-            writer.stream() << "cmovl " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "cmovl " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::CMOVLE:
-            writer.stream() << "cmovle " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "cmovle " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::XORPS:
-            writer.stream() << "xorps " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "xorps " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::MOVDQU:
-            writer.stream() << "movdqu " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
+            writer << "movdqu " << *instruction.arg1 << ", " << *instruction.arg2 << '\n';
             break;
         case ltac::Operator::NOP:
             //Nothing to output for a nop
             break;
         case ltac::Operator::CALL:
-            writer.stream() << "call " << instruction.label << '\n';
+            writer << "call " << instruction.label << '\n';
             break;
         case ltac::Operator::ALWAYS:
-            writer.stream() << "jmp " << "." << instruction.label << '\n';
+            writer << "jmp " << "." << instruction.label << '\n';
             break;
         case ltac::Operator::NE:
-            writer.stream() << "jne " << "." << instruction.label << '\n';
+            writer << "jne " << "." << instruction.label << '\n';
             break;
         case ltac::Operator::E:
-            writer.stream() << "je " << "." << instruction.label << '\n';
+            writer << "je " << "." << instruction.label << '\n';
             break;
         case ltac::Operator::GE:
-            writer.stream() << "jge " << "." << instruction.label << '\n';
+            writer << "jge " << "." << instruction.label << '\n';
             break;
         case ltac::Operator::G:
-            writer.stream() << "jg " << "." << instruction.label << '\n';
+            writer << "jg " << "." << instruction.label << '\n';
             break;
         case ltac::Operator::LE:
-            writer.stream() << "jle " << "." << instruction.label << '\n';
+            writer << "jle " << "." << instruction.label << '\n';
             break;
         case ltac::Operator::L:
-            writer.stream() << "jl " << "." << instruction.label << '\n';
+            writer << "jl " << "." << instruction.label << '\n';
             break;
         case ltac::Operator::AE:
-            writer.stream() << "jae " << "." << instruction.label << '\n';
+            writer << "jae " << "." << instruction.label << '\n';
             break;
         case ltac::Operator::A:
-            writer.stream() << "ja" << "." << instruction.label << '\n';
+            writer << "ja " << "." << instruction.label << '\n';
             break;
         case ltac::Operator::BE:
-            writer.stream() << "jbe " << "." << instruction.label << '\n';
+            writer << "jbe " << "." << instruction.label << '\n';
             break;
         case ltac::Operator::B:
-            writer.stream() << "jb " << "." << instruction.label << '\n';
+            writer << "jb " << "." << instruction.label << '\n';
             break;
         case ltac::Operator::P:
-            writer.stream() << "jp " << "." << instruction.label << '\n';
+            writer << "jp " << "." << instruction.label << '\n';
             break;
         case ltac::Operator::Z:
-            writer.stream() << "jz " << "." << instruction.label << '\n';
+            writer << "jz " << "." << instruction.label << '\n';
             break;
         case ltac::Operator::NZ:
-            writer.stream() << "jnz " << "." << instruction.label << '\n';
+            writer << "jnz " << "." << instruction.label << '\n';
             break;
         default:
             cpp_unreachable(("The operator " + std::to_string(static_cast<int>(instruction.op)) + " is not supported").c_str());
@@ -389,7 +388,7 @@ void compile_statement(AssemblyFileWriter& writer, ltac::Instruction& instructio
 } //end of anonymous namespace
 
 void as::IntelX86_64CodeGenerator::compile(mtac::Function& function){
-    writer.stream() << '\n' << function.get_name() << ":" << '\n';
+    writer << '\n' << function.get_name() << ":" << '\n';
 
     for(auto& bb : function){
         for(auto& statement : bb->l_statements){
@@ -399,125 +398,135 @@ void as::IntelX86_64CodeGenerator::compile(mtac::Function& function){
 }
 
 void as::IntelX86_64CodeGenerator::writeRuntimeSupport(){
-    writer.stream() << "section .text" << '\n' << '\n';
+    writer << "section .text" << '\n' << '\n';
 
-    writer.stream() << "global _start" << '\n' << '\n';
+    writer << "global _start" << '\n' << '\n';
 
-    writer.stream() << "_start:" << '\n';
+    writer << "_start:" << '\n';
 
     //If necessary init memory manager
     if(context.exists("_F4mainAS") || program.cg.is_reachable(context.getFunction("_F4freePI")) || program.cg.is_reachable(context.getFunction("_F5allocI"))){
-        writer.stream() << "call _F4init" << '\n';
+        writer << "call _F4init" << '\n';
     }
 
     //If the user wants the args, we add support for them
     if(context.exists("_F4mainAS")){
-        writer.stream() << "pop rbx" << '\n';                          //rbx = number of args
+        writer << "pop rbx" << '\n';                          //rbx = number of args
 
         //Calculate the size of the array
-        writer.stream() << "mov rcx, rbx" << '\n';
-        writer.stream() << "imul rcx, rcx, 16" << '\n';
-        writer.stream() << "add rcx, 8" << '\n';                       //rcx = size of the array
+        writer << "mov rcx, rbx" << '\n';
+        writer << "imul rcx, rcx, 16" << '\n';
+        writer << "add rcx, 8" << '\n';                       //rcx = size of the array
 
-        writer.stream() << "mov r14, rcx" << '\n';
-        writer.stream() << "call _F5allocI" << '\n';                   //rax = start address of the array
+        writer << "mov r14, rcx" << '\n';
+        writer << "call _F5allocI" << '\n';                   //rax = start address of the array
 
-        writer.stream() << "mov rsi, rax" << '\n';         //rsi = last address of the array
-        writer.stream() << "mov rdx, rsi" << '\n';                     //rdx = last address of the array
+        writer << "mov rsi, rax" << '\n';         //rsi = last address of the array
+        writer << "mov rdx, rsi" << '\n';                     //rdx = last address of the array
 
-        writer.stream() << "mov [rsi], rbx" << '\n';                   //Set the length of the array
-        writer.stream() << "add rsi, 8" << '\n';                       //Move to the destination address of the first arg
+        writer << "mov [rsi], rbx" << '\n';                   //Set the length of the array
+        writer << "add rsi, 8" << '\n';                       //Move to the destination address of the first arg
 
-        writer.stream() << ".copy_args:" << '\n';
-        writer.stream() << "pop rdi" << '\n';                          //rdi = address of current args
-        writer.stream() << "mov [rsi], rdi" << '\n';                   //set the address of the string
+        writer << ".copy_args:" << '\n';
+        writer << "pop rdi" << '\n';                          //rdi = address of current args
+        writer << "mov [rsi], rdi" << '\n';                   //set the address of the string
 
         /* Calculate the length of the string  */
-        writer.stream() << "xor rax, rax" << '\n';
-        writer.stream() << "xor rcx, rcx" << '\n';
-        writer.stream() << "not rcx" << '\n';
-        writer.stream() << "repne scasb" << '\n';
-        writer.stream() << "not rcx" << '\n';
-        writer.stream() << "dec rcx" << '\n';
+        writer << "xor rax, rax" << '\n';
+        writer << "xor rcx, rcx" << '\n';
+        writer << "not rcx" << '\n';
+        writer << "repne scasb" << '\n';
+        writer << "not rcx" << '\n';
+        writer << "dec rcx" << '\n';
         /* End of the calculation */
 
-        writer.stream() << "mov [rsi+8], rcx" << '\n';               //set the length of the string
-        writer.stream() << "add rsi, 16" << '\n';
-        writer.stream() << "dec rbx" << '\n';
-        writer.stream() << "jnz .copy_args" << '\n';
+        writer << "mov [rsi+8], rcx" << '\n';               //set the length of the string
+        writer << "add rsi, 16" << '\n';
+        writer << "dec rbx" << '\n';
+        writer << "jnz .copy_args" << '\n';
 
-        writer.stream() << "push rdx" << '\n';
+        writer << "push rdx" << '\n';
     }
 
     //Give control to the user function
     if(context.exists("_F4mainAS")){
-        writer.stream() << "call _F4mainAS" << '\n';
+        writer << "call _F4mainAS" << '\n';
     } else {
-        writer.stream() << "call _F4main" << '\n';
+        writer << "call _F4main" << '\n';
+    }
+
+    //Write the buffered output
+    if(uses_output_buffer()){
+        writer << "call _F5flush" << '\n';
+    }
+
+    //Write the counters of the instrumented program
+    if(!program.profile_file.empty()){
+        writer << "call _F12profile_dump" << '\n';
     }
 
     //Exit from the program
-    writer.stream() << "mov rax, 60" << '\n';  //syscall 60 is exit
-    writer.stream() << "xor rdi, rdi" << '\n'; //exit code (0 = success)
-    writer.stream() << "syscall" << '\n';
+    writer << "mov rax, 60" << '\n';  //syscall 60 is exit
+    writer << "xor rdi, rdi" << '\n'; //exit code (0 = success)
+    writer << "syscall" << '\n';
 }
 
 void as::IntelX86_64CodeGenerator::defineDataSection(){
-    writer.stream() << '\n' << "section .data" << '\n';
+    writer << '\n' << "section .data" << '\n';
 }
 
 void as::IntelX86_64CodeGenerator::declareIntArray(const std::string& name, unsigned int size){
-    writer.stream() << "V" << name << ":" <<'\n';
-    writer.stream() << "dq " << size << '\n';
-    writer.stream() << "times " << size << " dq 0" << '\n';
+    writer << "V" << name << ":" <<'\n';
+    writer << "dq " << size << '\n';
+    writer << "times " << size << " dq 0" << '\n';
 }
 
 void as::IntelX86_64CodeGenerator::declareFloatArray(const std::string& name, unsigned int size){
-    writer.stream() << "V" << name << ":" <<'\n';
-    writer.stream() << "dq " << size << '\n';
-    writer.stream() << "times " << size << " dq __float64__(0.0)" << '\n';
+    writer << "V" << name << ":" <<'\n';
+    writer << "dq " << size << '\n';
+    writer << "times " << size << " dq __float64__(0.0)" << '\n';
 }
 
 void as::IntelX86_64CodeGenerator::declareStringArray(const std::string& name, unsigned int size){
-    writer.stream() << "V" << name << ":" <<'\n';
-    writer.stream() << "dq " << size << '\n';
-    writer.stream() << "%rep " << size << '\n';
-    writer.stream() << "dq S1" << '\n';
-    writer.stream() << "dq 0" << '\n';
-    writer.stream() << "%endrep" << '\n';
+    writer << "V" << name << ":" <<'\n';
+    writer << "dq " << size << '\n';
+    writer << "%rep " << size << '\n';
+    writer << "dq S1" << '\n';
+    writer << "dq 0" << '\n';
+    writer << "%endrep" << '\n';
 }
 
 void as::IntelX86_64CodeGenerator::declareIntVariable(const std::string& name, int value){
-    writer.stream() << "V" << name << " dq " << value << '\n';
+    writer << "V" << name << " dq " << value << '\n';
 }
 
 void as::IntelX86_64CodeGenerator::declareBoolVariable(const std::string& name, bool value){
-    writer.stream() << "V" << name << " db " << value << '\n';
+    writer << "V" << name << " db " << value << '\n';
 }
 
 void as::IntelX86_64CodeGenerator::declareCharVariable(const std::string& name, char value){
-    writer.stream() << "V" << name << " db " << value << '\n';
+    writer << "V" << name << " db " << value << '\n';
 }
 
 void as::IntelX86_64CodeGenerator::declareStringVariable(const std::string& name, const std::string& label, int size){
-    writer.stream() << "V" << name << " dq " << label << ", " << size << '\n';
+    writer << "V" << name << " dq " << label << ", " << size << '\n';
 }
 
 void as::IntelX86_64CodeGenerator::declareString(const std::string& label, const std::string& value){
-    writer.stream() << label << " dq \"" << value << "\"\n";
+    writer << label << " dq \"" << value << "\"\n";
 }
 
 void as::IntelX86_64CodeGenerator::declareFloat(const std::string& label, double value){
-    writer.stream() << label << std::fixed << " dq __float64__(" << value << ")" << '\n';
+    writer << label << " dq __float64__(" << value << ")" << '\n';
 }
 
 void as::IntelX86_64CodeGenerator::addStandardFunctions(){
     if(program.cg.is_reachable(context.getFunction("_F5printC"))){
-        output_function("x86_64_printC");
+        output_function(print_functions("x86_64_") + "printC");
     }
 
     if(program.cg.is_reachable(context.getFunction("_F5printS"))){
-        output_function("x86_64_printS");
+        output_function(print_functions("x86_64_") + "printS");
     }
 
     //Memory management functions are included the three together
@@ -538,4 +547,12 @@ void as::IntelX86_64CodeGenerator::addStandardFunctions(){
     if(program.cg.is_reachable(context.getFunction("_F9read_char"))){
         output_function("x86_64_read_char");
     }
+
+    if(uses_output_buffer()){
+        output_function("x86_64_flush");
+    }
+
+    if(!program.profile_file.empty()){
+        output_function("x86_64_profile_dump");
+    }
 }
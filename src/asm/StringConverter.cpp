@@ -9,6 +9,8 @@
 
 #include "asm/StringConverter.hpp"
 
+#include "AssemblyFileWriter.hpp"
+
 #include "ltac/Address.hpp"
 #include "ltac/FloatRegister.hpp"
 #include "ltac/PseudoFloatRegister.hpp"
@@ -17,56 +19,48 @@
 
 using namespace eddic;
 
-std::string as::StringConverter::register_to_string(eddic::ltac::AddressRegister& reg) const {
+void as::StringConverter::address_register(eddic::ltac::AddressRegister& reg) const {
     if(auto* ptr = boost::get<ltac::PseudoRegister>(&reg)){
-        return (*this)(*ptr);
+        (*this)(*ptr);
     } else if(auto* ptr = boost::get<ltac::Register>(&reg)){
-        return (*this)(*ptr);
+        (*this)(*ptr);
     } else {
        cpp_unreachable("Invalid variant");
     }
 }
 
-std::string as::StringConverter::address_to_string(eddic::ltac::Address& address) const {
+void as::StringConverter::address(eddic::ltac::Address& address) const {
+    writer << '[';
+
     if(address.absolute){
-        if(address.displacement){
-            return "[" + *address.absolute + " + " + std::to_string(*address.displacement) + "]";
-        }
+        writer << *address.absolute;
 
-        if(address.base_register){
-            return "[" + *address.absolute + " + " + register_to_string(*address.base_register) + "]";
+        if(address.displacement){
+            writer << " + " << *address.displacement;
+        } else if(address.base_register){
+            writer << " + ";
+            address_register(*address.base_register);
         }
+    } else if(address.base_register){
+        address_register(*address.base_register);
 
-        return "[" + *address.absolute + "]";
-    }
-        
-    if(address.base_register){
         if(address.scaled_register){
+            writer << " + ";
+            address_register(*address.scaled_register);
+
             if(address.scale){
-                if(address.displacement){
-                    return "[" + register_to_string(*address.base_register) + " + " + register_to_string(*address.scaled_register) + " * " + std::to_string(*address.scale) + " + " + std::to_string(*address.displacement) + "]";
-                }
-                
-                return "[" + register_to_string(*address.base_register) + " + " + register_to_string(*address.scaled_register) + " * " + std::to_string(*address.scale) + "]";
+                writer << " * " << *address.scale;
             }
-                
-            if(address.displacement){
-                return "[" + register_to_string(*address.base_register) + " + " + register_to_string(*address.scaled_register) + " + " + std::to_string(*address.displacement) + "]";
-            }
-            
-            return "[" + register_to_string(*address.base_register) + " + " + register_to_string(*address.scaled_register) + "]";
         }
-                
+
         if(address.displacement){
-            return "[" + register_to_string(*address.base_register) + " + " + std::to_string(*address.displacement) + "]";
+            writer << " + " << *address.displacement;
         }
-
-        return "[" + register_to_string(*address.base_register) + "]";
-    }
-
-    if(address.displacement){
-        return "[" + std::to_string(*address.displacement) + "]";
+    } else if(address.displacement){
+        writer << *address.displacement;
+    } else {
+        cpp_unreachable("Invalid address type");
     }
 
-    cpp_unreachable("Invalid address type");
+    writer << ']';
 }
@@ -29,10 +29,10 @@ namespace {
 
 struct AnnotateVisitor : public boost::static_visitor<> {
         GlobalContext & global_context_;
-        FunctionContext & function_context_;
+        FunctionContext * function_context_;
         Context * currentContext = nullptr;
 
-        AnnotateVisitor(GlobalContext & global_context, FunctionContext & function_context) :
+        AnnotateVisitor(GlobalContext & global_context, FunctionContext * function_context) :
                 global_context_(global_context), function_context_(function_context) {}
 
         AUTO_RECURSE_BUILTIN_OPERATORS()
@@ -190,7 +190,7 @@ struct AnnotateVisitor : public boost::static_visitor<> {
         }
 
         void operator()(ast::Return& return_){
-            return_.context = &function_context_;
+            return_.context = function_context_;
 
             visit(*this, return_.value);
         }
@@ -220,7 +220,7 @@ struct AnnotateVisitor : public boost::static_visitor<> {
         }
 };
 
-inline AnnotateVisitor make_visitor(GlobalContext & globalContext, FunctionContext & functionContext, Context * currentContext){
+inline AnnotateVisitor make_visitor(GlobalContext & globalContext, FunctionContext * functionContext, Context * currentContext){
     AnnotateVisitor visitor(globalContext, functionContext);
     visitor.currentContext = currentContext;
     return visitor;
@@ -239,6 +239,10 @@ void ast::ContextAnnotationPass::apply_program(ast::SourceFile& program, bool in
                 ptr->context = currentContext;
             } else if(auto* ptr = boost::get<ast::GlobalArrayDeclaration>(&*it)){
                 ptr->context = currentContext;
+
+                //The size can be a global constant, there is no function context outside of the functions
+                auto visitor = make_visitor(globalContext, nullptr, currentContext);
+                visit(visitor, ptr->size);
             }
         }
     }
@@ -246,7 +250,7 @@ void ast::ContextAnnotationPass::apply_program(ast::SourceFile& program, bool in
 
 #define HANDLE_FUNCTION() \
     currentContext = function.context = functionContext = globalContext.new_function_context(configuration).get(); \
-    auto visitor = make_visitor(globalContext, *functionContext, currentContext); \
+    auto visitor = make_visitor(globalContext, functionContext, currentContext); \
     visit_each(visitor, function.instructions); \
     currentContext = currentContext->parent();
 
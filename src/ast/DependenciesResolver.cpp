@@ -5,8 +5,13 @@
 //  http://opensource.org/licenses/MIT)
 //=======================================================================
 
+#include<exception>
+#include<iostream>
+#include<map>
+#include<memory>
+#include<set>
+#include<sstream>
 #include<string>
-#include<unordered_set>
 
 #include "ast/DependenciesResolver.hpp"
 #include "ast/SourceFile.hpp"
@@ -15,43 +20,145 @@
 #include "SemanticalException.hpp"
 #include "VisitorUtils.hpp"
 #include "Utils.hpp"
+#include "parallel.hpp"
 
 #include "parser_x3/SpiritParser.hpp"
 
 using namespace eddic;
 
+namespace {
+
+struct parsed_file {
+    std::string file;
+    bool header;
+    ast::SourceFile program;
+
+    bool valid = false;
+    std::string errors;
+    std::exception_ptr exception;
+
+    parsed_file(std::string file, bool header, GlobalContext& context) : file(std::move(file)), header(header), program(context) {}
+};
+
+//The files are identified by their path and by whether they are standard headers
+using parsed_files = std::map<std::pair<bool, std::string>, std::unique_ptr<parsed_file>>;
+
+std::string header_file(const ast::StandardImport& import){
+    return "stdlib/" + import.header + ".eddi";
+}
+
+parsed_file* discover(parsed_files& files, bool header, const std::string& file, GlobalContext& context){
+    //The missing files are reported when the blocks are imported
+    if(!file_exists(file) || files.find({header, file}) != files.end()){
+        return nullptr;
+    }
+
+    auto& parsed = files[{header, file}];
+    parsed = std::make_unique<parsed_file>(file, header, context);
+    return parsed.get();
+}
+
+//Collect the dependencies of the given file that have not been seen yet, in source order
+void discover(parsed_files& files, ast::SourceFile& source, std::vector<parsed_file*>& pending){
+    for(auto& block : source){
+        parsed_file* parsed = nullptr;
+
+        if(auto* ptr = boost::get<ast::StandardImport>(&block)){
+            parsed = discover(files, true, header_file(*ptr), source.context);
+        } else if(auto* ptr = boost::get<ast::Import>(&block)){
+            parsed = discover(files, false, ptr->file, source.context);
+        }
+
+        if(parsed){
+            pending.push_back(parsed);
+        }
+    }
+}
+
+/*!
+ * \brief Parse all the files imported directly or indirectly by the program.
+ *
+ * The files are parsed level by level, the files of a level being parsed
+ * concurrently. The syntax errors are kept with each file, to be printed only
+ * if the file is really imported.
+ */
+void parse_dependencies(ast::SourceFile& program, parser_x3::SpiritParser& parser, parsed_files& files, std::size_t threads){
+    std::vector<parsed_file*> pending;
+    discover(files, program, pending);
+
+    while(!pending.empty()){
+        parallel_for(pending.size(), threads, [&](std::size_t i){
+            auto& parsed = *pending[i];
+            std::ostringstream errors;
+
+            try {
+                parsed.valid = parser.parse(parsed.file, parsed.program, program.context, parsed.header, errors);
+            } catch (...) {
+                parsed.exception = std::current_exception();
+            }
+
+            parsed.errors = errors.str();
+        });
+
+        std::vector<parsed_file*> next;
+        for(auto* parsed : pending){
+            if(parsed->valid){
+                discover(files, parsed->program, next);
+            }
+        }
+
+        pending = std::move(next);
+    }
+}
+
 class DependencyVisitor : public boost::static_visitor<> {
     private:
-        parser_x3::SpiritParser& parser;
-        ast::SourceFile& source_program;
+        parsed_files& files;
 
-        std::unordered_set<std::string> imported;
+        std::set<std::pair<bool, std::string>> imported;
 
-    public:
-        DependencyVisitor(parser_x3::SpiritParser& p, ast::SourceFile& source_program) : parser(p), source_program(source_program) {}
+        //Return the parsed file, once, or nullptr if it has already been imported
+        ast::SourceFile* import_file(bool header, const std::string& file, const std::string& name){
+            if(!imported.insert({header, file}).second){
+                return nullptr;
+            }
 
-        std::vector<ast::SourceFileBlock> blocks;
+            auto it = files.find({header, file});
 
-        AUTO_RECURSE_PROGRAM()
-
-        void operator()(ast::StandardImport& import){
-            if(imported.find(import.header) != imported.end()){
-                return;
+            if(!file_exists(file) || it == files.end()){
+                throw SemanticalException("The " + name + " does not exist");
             }
 
-            imported.insert(import.header);
+            auto& parsed = *it->second;
+
+            if(parsed.exception){
+                std::rethrow_exception(parsed.exception);
+            }
 
-            auto headerFile = "stdlib/" + import.header + ".eddi";
+            if(!parsed.valid){
+                std::cerr << parsed.errors;
+                std::cout << "Invalid source file" << std::endl;
 
-            if(!file_exists(headerFile)){
-                throw SemanticalException("The header " + import.header + " does not exist");
+                throw SemanticalException("The " + name + " cannot be imported");
             }
 
-            ast::SourceFile dependency(source_program.context);
-            if(parser.parse(headerFile, dependency, source_program.context)){
-                (*this)(dependency);
+            return &parsed.program;
+        }
 
-                for(ast::SourceFileBlock& block : dependency){
+    public:
+        explicit DependencyVisitor(parsed_files& files) : files(files) {}
+
+        std::vector<ast::SourceFileBlock> blocks;
+
+        AUTO_RECURSE_PROGRAM()
+
+        void operator()(ast::StandardImport& import){
+            auto* dependency = import_file(true, header_file(import), "header " + import.header);
+
+            if(dependency){
+                (*this)(*dependency);
+
+                for(ast::SourceFileBlock& block : *dependency){
                     if(auto* ptr = boost::get<ast::TemplateFunctionDeclaration>(&block)){
                         if(!ptr->is_template()){
                             ptr->standard = true;
@@ -62,25 +169,18 @@ class DependencyVisitor : public boost::static_visitor<> {
                         ptr->header = import.header;
                     }
 
-                    blocks.push_back(block);
+                    blocks.push_back(std::move(block));
                 }
-            } else {
-                throw SemanticalException("The header " + import.header + " cannot be imported");
             }
         }
 
         void operator()(ast::Import& import){
-            auto file = import.file;
-
-            if(!file_exists(file)){
-                throw SemanticalException("The file " + file + " does not exist");
-            }
+            auto* dependency = import_file(false, import.file, "file " + import.file);
 
-            ast::SourceFile dependency(source_program.context);
-            if(parser.parse(file, dependency, source_program.context)){
-                (*this)(dependency);
+            if(dependency){
+                (*this)(*dependency);
 
-                for(ast::SourceFileBlock& block : dependency){
+                for(ast::SourceFileBlock& block : *dependency){
                     if(auto* ptr = boost::get<ast::TemplateFunctionDeclaration>(&block)){
                         if(!ptr->is_template()){
                             ptr->header = import.file;
@@ -89,10 +189,8 @@ class DependencyVisitor : public boost::static_visitor<> {
                         ptr->header = import.file;
                     }
 
-                    blocks.push_back(block);
+                    blocks.push_back(std::move(block));
                 }
-            } else {
-                throw SemanticalException("The file " + file + " cannot be imported");
             }
         }
 
@@ -100,8 +198,14 @@ class DependencyVisitor : public boost::static_visitor<> {
         AUTO_IGNORE_OTHERS()
 };
 
-void ast::resolveDependencies(ast::SourceFile& program, parser_x3::SpiritParser& parser){
-    DependencyVisitor visitor(parser, program);
+} //end of anonymous namespace
+
+void ast::resolveDependencies(ast::SourceFile& program, parser_x3::SpiritParser& parser, std::size_t threads){
+    parsed_files files;
+    parse_dependencies(program, parser, files, threads);
+
+    //The blocks are spliced depth-first in source order, whatever the order of parsing
+    DependencyVisitor visitor(files);
     visitor(program);
 
     for(auto& block : visitor.blocks){
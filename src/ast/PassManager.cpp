@@ -62,6 +62,9 @@ void apply_pass(ast::Pass & pass, ast::SourceFile& program, Configuration & conf
 
     program.context.stats().inc_counter("passes");
 
+    auto& timing = program.context.timing();
+    trace_timer timer(timing, "ast_pass", pass.name());
+
     for(unsigned int i = 0; i < pass.passes(); ++i){
         pass.set_current_pass(i);
         pass.apply_program(program, false);
@@ -74,10 +77,12 @@ void apply_pass(ast::Pass & pass, ast::SourceFile& program, Configuration & conf
             try {
                 if (auto * ptr = boost::get<ast::struct_definition>(&block)) {
                     if(!ptr->is_template_declaration()){
+                        trace_timer struct_timer(timing, pass.name(), ptr->name);
                         apply_pass(pass, *ptr);
                     }
                 } else if (auto * ptr = boost::get<ast::TemplateFunctionDeclaration>(&block)) {
                     if(!ptr->is_template()){
+                        trace_timer function_timer(timing, pass.name(), ptr->functionName);
                         pass.apply_function(*ptr);
                     }
                 }
@@ -182,50 +187,43 @@ void ast::PassManager::init_passes(){
     passes.push_back(make_pass<ast::WarningsPass>("Warnings", template_engine, platform, configuration, pool));
 }
 
-void ast::PassManager::apply_function_instantiated(Pass & pass, ast::TemplateFunctionDeclaration & function) {
+//Replay each pass on the new declaration of an instantiated template
+template<typename Functor>
+void ast::PassManager::apply_instantiated(Pass & pass, Functor functor) {
+    timing_timer timer(program_.context.timing(), "template_pass " + pass.name());
+
     for (unsigned int i = 0; i < pass.passes(); ++i) {
         LOG<Info>("Passes") << "Run (template) pass \"" << pass.name() << "\":" << i << log::endl;
 
         program_.context.stats().inc_counter("passes");
 
         pass.set_current_pass(i);
+
         pass.apply_program(program_, true);
-        pass.apply_function(function);
+        functor();
         pass.apply_program_post(program_, true);
 
         LOG<Info>("Passes") << "Finished running (template) pass \"" << pass.name() << "\":" << i << log::endl;
     }
 }
 
-void ast::PassManager::apply_member_function_instantiated(Pass & pass, ast::struct_definition & struct_, ast::TemplateFunctionDeclaration & function) {
-    for (unsigned int i = 0; i < pass.passes(); ++i) {
-        LOG<Info>("Passes") << "Run (template) pass \"" << pass.name() << "\":" << i << log::endl;
-
-        program_.context.stats().inc_counter("passes");
+void ast::PassManager::apply_function_instantiated(Pass & pass, ast::TemplateFunctionDeclaration & function) {
+    apply_instantiated(pass, [&]() {
+        pass.apply_function(function);
+    });
+}
 
-        pass.set_current_pass(i);
-        pass.apply_program(program_, true);
+void ast::PassManager::apply_member_function_instantiated(Pass & pass, ast::struct_definition & struct_, ast::TemplateFunctionDeclaration & function) {
+    apply_instantiated(pass, [&]() {
         pass.apply_struct(struct_, true);
         pass.apply_struct_function(function);
-        pass.apply_program_post(program_, true);
-
-        LOG<Info>("Passes") << "Finished running (template) pass \"" << pass.name() << "\":" << i << log::endl;
-    }
+    });
 }
 
 void ast::PassManager::apply_struct_instantiated(Pass & pass, ast::struct_definition & struct_) {
-    for (unsigned int i = 0; i < pass.passes(); ++i) {
-        LOG<Info>("Passes") << "Run (template) pass \"" << pass.name() << "\":" << i << log::endl;
-
-        program_.context.stats().inc_counter("passes");
-
-        pass.set_current_pass(i);
-        pass.apply_program(program_, true);
+    apply_instantiated(pass, [&]() {
         apply_pass(pass, struct_);
-        pass.apply_program_post(program_, true);
-
-        LOG<Info>("Passes") << "Finished running (template) pass \"" << pass.name() << "\":" << i << log::endl;
-    }
+    });
 }
 
 void ast::PassManager::function_instantiated(ast::TemplateFunctionDeclaration& function){
@@ -297,6 +295,8 @@ void ast::PassManager::run_passes(){
         if(pass->is_simple()){
             LOG<Info>("Passes") << "Run simple pass \"" << pass->name() << "\"" << log::endl;
 
+            trace_timer pass_timer(program_.context.timing(), "ast_pass", pass->name());
+
             for(unsigned int i = 0; i < pass->passes(); ++i){
                 pass->set_current_pass(i);
 
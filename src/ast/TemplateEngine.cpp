@@ -722,37 +722,68 @@ std::vector<ast::StructBlock> copy(const std::vector<ast::StructBlock>& blocks){
     return destination;
 }
 
-template<typename Container>
-bool is_instantiated(const Container& container, const std::string& name, const std::vector<ast::Type>& template_types){
-    auto it_pair = container.equal_range(name);
+void append_key(std::string& key, const ast::Type& type){
+    if(auto* ptr = boost::smart_get<ast::SimpleType>(&type)){
+        if(ptr->const_){
+            key += "const ";
+        }
+
+        key += ptr->type;
+    } else if(auto* ptr = boost::smart_get<ast::ArrayType>(&type)){
+        append_key(key, ptr->type);
+        key += "[]";
+    } else if(auto* ptr = boost::smart_get<ast::PointerType>(&type)){
+        append_key(key, ptr->type);
+        key += '*';
+    } else if(auto* ptr = boost::smart_get<ast::TemplateType>(&type)){
+        key += ptr->type;
+        key += '<';
 
-    if(it_pair.first == it_pair.second && it_pair.second == container.end()){
-        return false;
+        for(auto& tmp_type : ptr->template_types){
+            append_key(key, tmp_type);
+            key += ',';
+        }
+
+        key += '>';
+    } else {
+        cpp_unreachable("Unhandled type");
     }
+}
 
-    do {
-        auto types = it_pair.first->second;
+//The separators cannot appear in identifiers, two different instantiations have different keys
+std::string instantiation_key(const std::string& context, const std::string& name, const std::vector<ast::Type>& template_types){
+    std::string key;
+    key.reserve(context.size() + name.size() + 16 * template_types.size() + 2);
 
-        if(are_equals(types, template_types)){
-            return true;
-        }
+    key += context;
+    key += ':';
+    key += name;
+    key += '<';
 
-        ++it_pair.first;
-    } while(it_pair.first != it_pair.second);
+    for(auto& type : template_types){
+        append_key(key, type);
+        key += ',';
+    }
 
-    return false;
+    key += '>';
+
+    return key;
 }
 
 } //end of anonymous namespace
 
 ast::TemplateEngine::TemplateEngine(ast::PassManager& pass_manager) : pass_manager(pass_manager) {}
 
-bool ast::TemplateEngine::is_instantiated(const std::string& name, const std::string& context, const std::vector<ast::Type>& template_types){
-    return ::is_instantiated(function_template_instantiations[context], name, template_types);
-}
+bool ast::TemplateEngine::mark_instantiated(InstantiationSet& instantiations, const std::string& name, const std::string& context, const std::vector<ast::Type>& template_types){
+    auto& stats = pass_manager.program().context.stats();
+
+    if(instantiations.insert(instantiation_key(context, name, template_types)).second){
+        stats.inc_counter("template_instantiations");
+        return true;
+    }
 
-bool ast::TemplateEngine::is_class_instantiated(const std::string& name, const std::vector<ast::Type>& template_types){
-    return ::is_instantiated(class_template_instantiations, name, template_types);
+    stats.inc_counter("template_instantiation_hits");
+    return false;
 }
 
 void ast::TemplateEngine::check_function(ast::FunctionCall& function_call){
@@ -781,7 +812,7 @@ void ast::TemplateEngine::instantiate_function(ast::struct_definition *
                                                const std::string &                context,
                                                const std::string &                name,
                                                std::vector<ast::Type> &           template_types) {
-    if(!is_instantiated(name, context, template_types)){
+    if(mark_instantiated(function_template_instantiations, name, context, template_types)){
         if (struct_) {
             LOG<Info>("Template") << "Instantiate member function template " << name << " in " << struct_->mangled_name<< log::endl;
         } else {
@@ -806,9 +837,6 @@ void ast::TemplateEngine::instantiate_function(ast::struct_definition *
         Adaptor adaptor(replacements);
         visit_non_variant(adaptor, declaration);
 
-        //Mark it as instantiated
-        function_template_instantiations[context].insert(ast::TemplateEngine::LocalFunctionInstantiationMap::value_type(name, template_types));
-
         if (struct_) {
             pass_manager.member_function_instantiated(*struct_, declaration);
         } else {
@@ -822,13 +850,16 @@ void ast::TemplateEngine::check_function(std::vector<ast::Type>& template_types,
 
     auto & program = pass_manager.program();
 
-    if (!function_templates.contains(context) || !function_templates[context].contains(name)) {
+    auto context_it = function_templates.find(context);
+
+    if (context_it == function_templates.end() || !context_it->second.contains(name)) {
         program.context.error_handler.semantical_exception("There are no registered template function named " + name, position);
     }
 
-    auto it = function_templates[context].find(name);
+    auto& templates = context_it->second;
+    auto it = templates.find(name);
 
-    while (it != function_templates[context].end()) {
+    while (it != templates.end()) {
         auto & [struct_, function] = it->second;
 
         if (function.template_types.size() == template_types.size()) {
@@ -858,7 +889,7 @@ void ast::TemplateEngine::check_type(ast::Type& type, x3::file_position_tagged&
             auto& source_types = struct_declaration.decl_template_types;
 
             if(source_types.size() == template_types.size()){
-                if(!is_class_instantiated(name, template_types)){
+                if(mark_instantiated(class_template_instantiations, name, "", template_types)){
                     LOG<Info>("Template") << "Instantiate class template " << name << log::endl;
 
                     //Instantiate the struct
@@ -881,9 +912,6 @@ void ast::TemplateEngine::check_type(ast::Type& type, x3::file_position_tagged&
                     Adaptor adaptor(replacements);
                     visit_non_variant(adaptor, declaration);
 
-                    //Mark it as instantiated
-                    class_template_instantiations.insert(ast::TemplateEngine::ClassInstantiationMap::value_type(name, template_types));
-
                     pass_manager.struct_instantiated(declaration);
                 }
 
@@ -452,6 +452,10 @@ class FunctionCheckerVisitor : public boost::static_visitor<> {
                 template_engine->check_member_function(type, op, value);
 
                 if(op.get<0>() == ast::Operator::DOT){
+                    if(!(type->is_pointer() ? type->data_type() : type)->is_structure()){
+                        this->context.error_handler.semantical_exception("Members can only be accessed on structures", value);
+                    }
+
                     auto struct_type = context.get_struct(type);
                     auto orig = struct_type;
 
@@ -253,14 +253,24 @@ void ast::TypeCollectionPass::apply_struct(ast::struct_definition& structure, bo
                 }
             }
 
-            // Put small types first
-            std::sort(signature->members.begin(), signature->members.end(), [](const Member & lhs, const Member & rhs) {
-                if (lhs.type == CHAR || lhs.type == BOOL) {
-                    return false;
-                }
+            if (configuration->option_defined("freorder-members")) {
+                // Put the most aligned members first to minimize the padding
+                std::stable_sort(signature->members.begin(), signature->members.end(), [this](const Member & lhs, const Member & rhs) {
+                    return context.alignment_of(lhs.type) > context.alignment_of(rhs.type);
+                });
+            } else {
+                // Put small types first
+                std::sort(signature->members.begin(), signature->members.end(), [](const Member & lhs, const Member & rhs) {
+                    if (lhs.type == CHAR || lhs.type == BOOL) {
+                        return false;
+                    }
+
+                    return rhs.type == CHAR || rhs.type == BOOL;
+                });
+            }
 
-                return rhs.type == CHAR || rhs.type == BOOL;
-            });
+            // All the members are known, the layout can be computed once for all
+            context.compute_layout(signature);
 
             // Create the type itself
 
@@ -0,0 +1,44 @@
+//=======================================================================
+// Copyright Baptiste Wicht 2011-2016.
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#include <mutex>
+#include <unordered_set>
+
+#include "interned_string.hpp"
+
+using namespace eddic;
+
+namespace {
+
+//The nodes of the set are never moved, the pointers to the strings stay valid
+std::unordered_set<std::string>& pool(){
+    static std::unordered_set<std::string> strings;
+    return strings;
+}
+
+std::mutex& pool_mutex(){
+    static std::mutex mutex;
+    return mutex;
+}
+
+const std::string* intern(const std::string& value){
+    std::lock_guard<std::mutex> lock(pool_mutex());
+
+    return &*pool().insert(value).first;
+}
+
+} //end of anonymous namespace
+
+interned_string::interned_string(){
+    static const std::string* empty = intern("");
+
+    value = empty;
+}
+
+interned_string::interned_string(const std::string& value) : value(intern(value)) {}
+
+interned_string::interned_string(const char* value) : value(intern(value)) {}
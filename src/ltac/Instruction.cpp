@@ -13,6 +13,18 @@ using namespace eddic;
 
 static std::atomic<std::size_t> uid_counter(0);
 
+namespace {
+
+std::unique_ptr<ltac::RegisterUsage> copy_usage(const std::unique_ptr<ltac::RegisterUsage>& usage){
+    if(usage){
+        return std::make_unique<ltac::RegisterUsage>(*usage);
+    }
+
+    return nullptr;
+}
+
+} //end of anonymous namespace
+
 ltac::Instruction::Instruction(ltac::Operator op, tac::Size size) : 
         _uid(++uid_counter), op(op), size(size) {
     //Nothing to init
@@ -40,21 +52,14 @@ ltac::Instruction::Instruction(std::string label, ltac::Operator op, tac::Size s
 
 ltac::Instruction::Instruction(const ltac::Instruction& rhs) :  
     _uid(++uid_counter), 
+    _usage(copy_usage(rhs._usage)),
     op(rhs.op),
     arg1(rhs.arg1),
     arg2(rhs.arg2),
     arg3(rhs.arg3),
     size(rhs.size),
     label(rhs.label),
-    target_function(rhs.target_function),
-    uses(rhs.uses),
-    float_uses(rhs.float_uses),
-    hard_uses(rhs.hard_uses),
-    hard_float_uses(rhs.hard_float_uses),
-    kills(rhs.kills),
-    float_kills(rhs.float_kills),
-    hard_kills(rhs.hard_kills),
-    hard_float_kills(rhs.hard_float_kills)
+    target_function(rhs.target_function)
 {
     //Nothing to init
 }
@@ -66,6 +71,7 @@ ltac::Instruction& ltac::Instruction::operator=(const ltac::Instruction& rhs){
     }
     
     _uid = ++uid_counter; 
+    _usage = copy_usage(rhs._usage);
     op = rhs.op;
     arg1 = rhs.arg1;
     arg2 = rhs.arg2;
@@ -73,35 +79,20 @@ ltac::Instruction& ltac::Instruction::operator=(const ltac::Instruction& rhs){
     size = rhs.size;
     label = rhs.label;
     target_function = rhs.target_function;
-    uses = rhs.uses;
-    float_uses = rhs.float_uses;
-    hard_uses = rhs.hard_uses;
-    hard_float_uses = rhs.hard_float_uses;
-    kills = rhs.kills;
-    float_kills = rhs.float_kills;
-    hard_kills = rhs.hard_kills;
-    hard_float_kills = rhs.hard_float_kills;
 
     return *this;
 }
 
 ltac::Instruction::Instruction(ltac::Instruction&& rhs) noexcept :
     _uid(std::move(rhs._uid)), 
+    _usage(std::move(rhs._usage)),
     op(std::move(rhs.op)),
     arg1(std::move(rhs.arg1)),
     arg2(std::move(rhs.arg2)),
     arg3(std::move(rhs.arg3)),
     size(std::move(rhs.size)),
     label(std::move(rhs.label)),
-    target_function(std::move(rhs.target_function)),
-    uses(std::move(rhs.uses)),
-    float_uses(std::move(rhs.float_uses)),
-    hard_uses(std::move(rhs.hard_uses)),
-    hard_float_uses(std::move(rhs.hard_float_uses)),
-    kills(std::move(rhs.kills)),
-    float_kills(std::move(rhs.float_kills)),
-    hard_kills(std::move(rhs.hard_kills)),
-    hard_float_kills(std::move(rhs.hard_float_kills))
+    target_function(std::move(rhs.target_function))
 {
     rhs._uid = 0;
 }
@@ -113,6 +104,7 @@ ltac::Instruction& ltac::Instruction::operator=(ltac::Instruction&& rhs) noexcep
     }
     
     _uid = std::move(rhs._uid);
+    _usage = std::move(rhs._usage);
     op = std::move(rhs.op);
     arg1 = std::move(rhs.arg1);
     arg2 = std::move(rhs.arg2);
@@ -120,20 +112,30 @@ ltac::Instruction& ltac::Instruction::operator=(ltac::Instruction&& rhs) noexcep
     size = std::move(rhs.size);
     label = std::move(rhs.label);
     target_function = std::move(rhs.target_function);
-    uses = std::move(rhs.uses);
-    float_uses = std::move(rhs.float_uses);
-    hard_uses = std::move(rhs.hard_uses);
-    hard_float_uses = std::move(rhs.hard_float_uses);
-    kills = std::move(rhs.kills);
-    float_kills = std::move(rhs.float_kills);
-    hard_kills = std::move(rhs.hard_kills);
-    hard_float_kills = std::move(rhs.hard_float_kills);
 
     rhs._uid = 0;
 
     return *this;
 }
         
+const ltac::RegisterUsage& ltac::Instruction::usage() const {
+    static const ltac::RegisterUsage empty_usage;
+
+    if(_usage){
+        return *_usage;
+    }
+
+    return empty_usage;
+}
+
+ltac::RegisterUsage& ltac::Instruction::edit_usage(){
+    if(!_usage){
+        _usage = std::make_unique<ltac::RegisterUsage>();
+    }
+
+    return *_usage;
+}
+
 bool ltac::Instruction::is_jump() const {
     return op >= ltac::Operator::ALWAYS && op <= ltac::Operator::NZ;
 }
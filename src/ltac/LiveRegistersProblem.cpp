@@ -19,27 +19,31 @@ namespace {
 
 template <typename Reg, typename FloatReg, typename ProblemDomain>
 void collect_jump(ltac::Instruction & instruction, ProblemDomain & in) {
+    auto & usage = instruction.usage();
+
     if constexpr (std::is_same_v<Reg, ltac::PseudoRegister>) {
-        std::ranges::for_each(instruction.uses, in.values().inserter());
-        std::ranges::for_each(instruction.float_uses, in.values().inserter());
-        std::ranges::for_each(instruction.kills, in.values().eraser());
-        std::ranges::for_each(instruction.float_kills, in.values().eraser());
+        std::ranges::for_each(usage.uses, in.values().inserter());
+        std::ranges::for_each(usage.float_uses, in.values().inserter());
+        std::ranges::for_each(usage.kills, in.values().eraser());
+        std::ranges::for_each(usage.float_kills, in.values().eraser());
     } else {
-        std::ranges::for_each(instruction.hard_uses, in.values().inserter());
-        std::ranges::for_each(instruction.hard_float_uses, in.values().inserter());
-        std::ranges::for_each(instruction.hard_kills, in.values().eraser());
-        std::ranges::for_each(instruction.hard_float_kills, in.values().eraser());
+        std::ranges::for_each(usage.hard_uses, in.values().inserter());
+        std::ranges::for_each(usage.hard_float_uses, in.values().inserter());
+        std::ranges::for_each(usage.hard_kills, in.values().eraser());
+        std::ranges::for_each(usage.hard_float_kills, in.values().eraser());
     }
 }
 
 template <typename Reg, typename FloatReg, typename ProblemDomain>
 void collect_instruction(ltac::Instruction & instruction, ProblemDomain & in) {
+    auto & usage = instruction.usage();
+
     if constexpr (std::is_same_v<Reg, ltac::PseudoRegister>) {
-        std::ranges::for_each(instruction.uses, in.values().inserter());
-        std::ranges::for_each(instruction.float_uses, in.values().inserter());
+        std::ranges::for_each(usage.uses, in.values().inserter());
+        std::ranges::for_each(usage.float_uses, in.values().inserter());
     } else {
-        std::ranges::for_each(instruction.hard_uses, in.values().inserter());
-        std::ranges::for_each(instruction.hard_float_uses, in.values().inserter());
+        std::ranges::for_each(usage.hard_uses, in.values().inserter());
+        std::ranges::for_each(usage.hard_float_uses, in.values().inserter());
     }
 }
 
@@ -109,13 +113,7 @@ inline void meet(Domain& in, const Domain& out){
     } else if(in.top()){
         in = out;
     } else {
-        for(auto& value : out.values().registers){
-            in.values().insert(value);
-        }
-
-        for(auto& value : out.values().float_registers){
-            in.values().insert(value);
-        }
+        in.values() |= out.values();
     }
 }
 
@@ -149,20 +147,12 @@ void ltac::LivePseudoRegistersProblem::meet(PseudoProblemDomain& in, const Pseud
     ::meet(in, out);
 }
 
-ProblemDomain ltac::LiveRegistersProblem::transfer(const mtac::basic_block_p & /*basic_block*/, ltac::Instruction& statement, ProblemDomain& in){
-    auto out = in;
-
-    LivenessCollector<ltac::Register, ltac::FloatRegister, ProblemDomain> collector(out);
+void ltac::LiveRegistersProblem::transfer(const mtac::basic_block_p & /*basic_block*/, ltac::Instruction& statement, ProblemDomain& in){
+    LivenessCollector<ltac::Register, ltac::FloatRegister, ProblemDomain> collector(in);
     collector.collect(statement);
-
-    return out;
 }
 
-PseudoProblemDomain ltac::LivePseudoRegistersProblem::transfer(const mtac::basic_block_p & /*basic_block*/, ltac::Instruction& statement, PseudoProblemDomain& in){
-    auto out = in;
-
-    LivenessCollector<ltac::PseudoRegister, ltac::PseudoFloatRegister, PseudoProblemDomain> collector(out);
+void ltac::LivePseudoRegistersProblem::transfer(const mtac::basic_block_p & /*basic_block*/, ltac::Instruction& statement, PseudoProblemDomain& in){
+    LivenessCollector<ltac::PseudoRegister, ltac::PseudoFloatRegister, PseudoProblemDomain> collector(in);
     collector.collect(statement);
-
-    return out;
 }
@@ -21,6 +21,7 @@
 #include "Variable.hpp"
 
 #include "mtac/GlobalOptimizations.hpp"
+#include "mtac/data_flow_cursor.hpp"
 #include "mtac/Quadruple.hpp"
 
 #include "ltac/PeepholeOptimizer.hpp"
@@ -250,9 +251,9 @@ inline bool multiple_statement_optimizations(ltac::Instruction& i1, ltac::Instru
                     i2.arg2 = ltac::Address(boost::get<ltac::Register>(*i1.arg2), boost::get<int>(*i2.arg2));
 
                     return ltac::transform_to_nop(i1);
-                } else if(boost::get<std::string>(&*i1.arg2) && boost::get<int>(&*i2.arg2)){
+                } else if(boost::get<interned_string>(&*i1.arg2) && boost::get<int>(&*i2.arg2)){
                     i2.op = ltac::Operator::LEA;
-                    i2.arg2 = ltac::Address(boost::get<std::string>(*i1.arg2), boost::get<int>(*i2.arg2));
+                    i2.arg2 = ltac::Address(boost::get<interned_string>(*i1.arg2).str(), boost::get<int>(*i2.arg2));
 
                     return ltac::transform_to_nop(i1);
                 }
@@ -631,11 +632,14 @@ bool dead_code_elimination(mtac::Function& function){
 
     ltac::LiveRegistersProblem problem;
     auto results = mtac::data_flow(function, problem);
+
+    mtac::data_flow_cursor<ltac::LiveRegistersProblem> cursor(problem, results);
     
     for(auto& block : function){
         auto it = iterate(block->l_statements);
 
-        while(it.has_next()){
+        //The index of the instruction in the block before any erasure
+        for(std::size_t i = 0; it.has_next(); ++i){
             auto& instruction = *it;
 
             if(ltac::erase_result(instruction.op)){
@@ -652,11 +656,11 @@ bool dead_code_elimination(mtac::Function& function){
                         continue;
                     }
 
-                    //Some statements (in ENTRY and EXIT) are not annotated, it is enough to ignore them
-                    if(results->OUT_S.count(instruction.uid())){
-                        auto& liveness = results->OUT_S[instruction.uid()].values();
+                    auto& liveness = cursor.out(block, i);
 
-                        if(liveness.find(*reg_ptr) == liveness.end()){
+                    //Some statements (in ENTRY and EXIT) are not annotated, it is enough to ignore them
+                    if(!liveness.top()){
+                        if(!liveness.values().contains(*reg_ptr)){
                             it.erase();
                             optimized=true;
                             continue;
@@ -898,6 +902,9 @@ void eddic::ltac::optimize(mtac::Program& program, Platform platform){
 
         bool optimized;
         do {
+            trace_timer iteration(program.context.timing(), "peephole_iteration", function.get_name());
+            program.context.stats().inc_counter("peephole_iterations");
+
             optimized = false;
             
             optimized |= debug("Basic optimizations", basic_optimizations(function, platform), function);
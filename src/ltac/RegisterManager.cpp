@@ -54,7 +54,7 @@ void ltac::RegisterManager::reset(){
 void ltac::RegisterManager::copy(mtac::Argument argument, ltac::PseudoFloatRegister reg){
     assert(ltac::is_variable(argument) || mtac::isFloat(argument));
 
-    if(auto* ptr = boost::get<std::shared_ptr<Variable>>(&argument)){
+    if(auto* ptr = boost::get<variable_ref>(&argument)){
         auto variable = *ptr;
         
         //If the variable is hold in a register, just move the register value
@@ -82,7 +82,7 @@ void ltac::RegisterManager::copy(mtac::Argument argument, ltac::PseudoFloatRegis
 }
 
 void ltac::RegisterManager::copy(mtac::Argument argument, ltac::PseudoRegister reg, tac::Size size){
-    if(auto* ptr = boost::get<std::shared_ptr<Variable>>(&argument)){
+    if(auto* ptr = boost::get<variable_ref>(&argument)){
         auto variable = *ptr;
         
         //If the variable is hold in a register, just move the register value
@@ -114,7 +114,7 @@ void ltac::RegisterManager::copy(mtac::Argument argument, ltac::PseudoRegister r
 void ltac::RegisterManager::move(mtac::Argument argument, ltac::PseudoRegister reg){
     copy(argument, reg);
 
-    if(auto* ptr = boost::get<std::shared_ptr<Variable>>(&argument)){
+    if(auto* ptr = boost::get<variable_ref>(&argument)){
         //The variable is now held in the new register
         pseudo_registers.setLocation(*ptr, reg);
     }
@@ -125,7 +125,7 @@ void ltac::RegisterManager::move(mtac::Argument argument, ltac::PseudoFloatRegis
     
     copy(argument, reg);
 
-    if(auto* ptr = boost::get<std::shared_ptr<Variable>>(&argument)){
+    if(auto* ptr = boost::get<variable_ref>(&argument)){
         //The variable is now held in the new register
         pseudo_float_registers.setLocation(*ptr, reg);
     } 
@@ -436,12 +436,17 @@ void ltac::StatementCompiler::compile_PARAM(mtac::Quadruple& param){
 
     //2. If the param as not been handled as register passing, push it on the stack
 
+    //The padding of a structure passed by value is above its member
+    if(param.arg2){
+        bb->emplace_back_low(ltac::Operator::SUB, ltac::SP, boost::get<int>(*param.arg2));
+    }
+
     //Char has a smaller size, cannot use push instructions
 
     if(param.param() && (param.param()->type() == CHAR || param.param()->type() == BOOL)){
         bb->emplace_back_low(ltac::Operator::SUB, ltac::SP, 1);
 
-        if(auto* ptr = boost::get<std::shared_ptr<Variable>>(&*param.arg1)){
+        if(auto* ptr = boost::get<variable_ref>(&*param.arg1)){
             auto& var = *ptr;
             auto reg = manager.get_pseudo_reg(var);
 
@@ -464,7 +469,7 @@ void ltac::StatementCompiler::compile_PARAM(mtac::Quadruple& param){
 
     //Use push instructions for regular types
 
-    if(auto* ptr = boost::get<std::shared_ptr<Variable>>(&*param.arg1)){
+    if(auto* ptr = boost::get<variable_ref>(&*param.arg1)){
         auto var = *ptr;
 
         if(!var->type()->is_array() && ltac::is_float_var(var)){
@@ -531,7 +536,7 @@ void ltac::StatementCompiler::compile_PARAM(mtac::Quadruple& param){
 void ltac::StatementCompiler::compile_PPARAM(mtac::Quadruple& param){
     auto [type, register_allocated, position] = common_param(param);
 
-    if(auto* ptr = boost::get<std::shared_ptr<Variable>>(&*param.arg1)){
+    if(auto* ptr = boost::get<variable_ref>(&*param.arg1)){
         auto variable = *ptr;
 
         if(variable->type()->is_pointer()){
@@ -624,8 +629,8 @@ void ltac::StatementCompiler::compile_CALL(mtac::Quadruple& call){
 
     ltac::Instruction call_instruction(call.function().mangled_name(), ltac::Operator::CALL);
     call_instruction.target_function = &call.function();
-    call_instruction.uses = uses;
-    call_instruction.float_uses = float_uses;
+    call_instruction.edit_usage().uses = uses;
+    call_instruction.edit_usage().float_uses = float_uses;
 
     ltac::PseudoRegister return_reg_1;
     ltac::PseudoRegister return_reg_2;
@@ -634,16 +639,16 @@ void ltac::StatementCompiler::compile_CALL(mtac::Quadruple& call){
     if(call.return1()){
         if(call.return1()->type() == FLOAT){
             return_float_reg_1 = manager.get_bound_pseudo_float_reg(descriptor->float_return_register());
-            call_instruction.float_kills.push_back(return_float_reg_1);
+            call_instruction.edit_usage().float_kills.push_back(return_float_reg_1);
         } else {
             return_reg_1 = manager.get_bound_pseudo_reg(descriptor->int_return_register1());
-            call_instruction.kills.push_back(return_reg_1);
+            call_instruction.edit_usage().kills.push_back(return_reg_1);
         }
     }
 
     if(call.return2()){
         return_reg_2 = manager.get_bound_pseudo_reg(descriptor->int_return_register2());
-        call_instruction.kills.push_back(return_reg_2);
+        call_instruction.edit_usage().kills.push_back(return_reg_2);
     }
 
     bb->l_statements.push_back(std::move(call_instruction));
@@ -703,7 +708,7 @@ void ltac::StatementCompiler::compile_ASSIGN(mtac::Quadruple& quadruple){
 }
 
 void ltac::StatementCompiler::compile_PASSIGN(mtac::Quadruple& quadruple){
-    if(auto* ptr = boost::get<std::shared_ptr<Variable>>(&*quadruple.arg1)){
+    if(auto* ptr = boost::get<variable_ref>(&*quadruple.arg1)){
         if((*ptr)->type()->is_pointer()){
             compile_ASSIGN(quadruple);
         } else {
@@ -856,13 +861,13 @@ void ltac::StatementCompiler::perform_div(mtac::Quadruple& quadruple){
         manager.move(*quadruple.arg2, reg);
 
         ltac::Instruction instruction(ltac::Operator::DIV, reg);
-        instruction.uses.push_back(a_reg);
-        instruction.uses.push_back(d_reg);
+        instruction.edit_usage().uses.push_back(a_reg);
+        instruction.edit_usage().uses.push_back(d_reg);
         bb->push_back(std::move(instruction));
     } else {
         ltac::Instruction instruction(ltac::Operator::DIV, to_arg(*quadruple.arg2));
-        instruction.uses.push_back(a_reg);
-        instruction.uses.push_back(d_reg);
+        instruction.edit_usage().uses.push_back(a_reg);
+        instruction.edit_usage().uses.push_back(d_reg);
         bb->push_back(std::move(instruction));
     }
 
@@ -1171,7 +1176,7 @@ void ltac::StatementCompiler::write_8_bit(const ltac::PseudoRegister& reg, ltac:
 void ltac::StatementCompiler::compile_DOT(mtac::Quadruple& quadruple){
     auto size = quadruple.size;
 
-    if(auto* var_ptr = boost::get<std::shared_ptr<Variable>>(&*quadruple.arg1)){
+    if(auto* var_ptr = boost::get<variable_ref>(&*quadruple.arg1)){
         auto variable = *var_ptr;
 
         if(variable->type()->is_pointer() || (variable->type()->is_dynamic_array() && !variable->position().isParameter())){
@@ -1186,12 +1191,12 @@ void ltac::StatementCompiler::compile_DOT(mtac::Quadruple& quadruple){
 
             write_8_bit(reg, address(variable, *quadruple.arg2), quadruple.size);
         }
-    } else if(auto* string_ptr = boost::get<std::string>(&*quadruple.arg1)){
+    } else if(auto* string_ptr = boost::get<interned_string>(&*quadruple.arg1)){
         auto reg = manager.get_pseudo_reg_no_move(quadruple.result);
 
         if(auto* offset_ptr = boost::get<int>(&*quadruple.arg2)){
             bb->emplace_back_low(ltac::Operator::MOV, reg, ltac::Address(*string_ptr, *offset_ptr), size);
-        } else if(auto* offset_ptr = boost::get<std::shared_ptr<Variable>>(&*quadruple.arg2)){
+        } else if(auto* offset_ptr = boost::get<variable_ref>(&*quadruple.arg2)){
             auto offset_reg = manager.get_pseudo_reg(*offset_ptr);
             bb->emplace_back_low(ltac::Operator::MOV, reg, ltac::Address(*string_ptr, offset_reg), size);
         }
@@ -1201,21 +1206,19 @@ void ltac::StatementCompiler::compile_DOT(mtac::Quadruple& quadruple){
 }
 
 void ltac::StatementCompiler::compile_FDOT(mtac::Quadruple& quadruple){
-    assert(boost::get<std::shared_ptr<Variable>>(&*quadruple.arg1));
-    auto variable = boost::get<std::shared_ptr<Variable>>(*quadruple.arg1);
-
-    assert(boost::get<int>(&*quadruple.arg2));
-    const int offset = boost::get<int>(*quadruple.arg2);
+    assert(boost::get<variable_ref>(&*quadruple.arg1));
+    auto variable = boost::get<variable_ref>(*quadruple.arg1);
 
+    //The offset is not constant for the fields of the elements of an array
     auto reg = manager.get_pseudo_float_reg_no_move(quadruple.result);
-    bb->emplace_back_low(ltac::Operator::FMOV, reg, address(variable, offset));
+    bb->emplace_back_low(ltac::Operator::FMOV, reg, address(variable, *quadruple.arg2));
 
     manager.set_written(quadruple.result);
 }
 
 void ltac::StatementCompiler::compile_PDOT(mtac::Quadruple& quadruple){
-    assert(boost::get<std::shared_ptr<Variable>>(&*quadruple.arg1));
-    auto variable = boost::get<std::shared_ptr<Variable>>(*quadruple.arg1);
+    assert(boost::get<variable_ref>(&*quadruple.arg1));
+    auto variable = boost::get<variable_ref>(*quadruple.arg1);
 
     auto reg = manager.get_pseudo_reg_no_move(quadruple.result);
 
@@ -1267,7 +1270,7 @@ void ltac::StatementCompiler::write_8_bit_to(const ltac::PseudoRegister& reg, lt
 
 void ltac::StatementCompiler::compile_DOT_ASSIGN(mtac::Quadruple& quadruple){
     if(quadruple.size == tac::Size::BYTE){
-        if(auto* ptr = boost::get<std::shared_ptr<Variable>>(&*quadruple.arg2)){
+        if(auto* ptr = boost::get<variable_ref>(&*quadruple.arg2)){
             auto reg = manager.get_pseudo_reg(*ptr);
 
             write_8_bit_to(reg, address(quadruple.result, *quadruple.arg1), quadruple.size);
@@ -1286,7 +1289,7 @@ void ltac::StatementCompiler::compile_DOT_FASSIGN(mtac::Quadruple& quadruple){
 }
 
 void ltac::StatementCompiler::compile_DOT_PASSIGN(mtac::Quadruple& quadruple){
-    if(auto* ptr = boost::get<std::shared_ptr<Variable>>(&*quadruple.arg2)){
+    if(auto* ptr = boost::get<variable_ref>(&*quadruple.arg2)){
         auto variable = *ptr;
 
         auto reg = get_address_in_pseudo_reg(variable, 0);
@@ -1318,24 +1321,24 @@ void ltac::StatementCompiler::compile_RETURN(mtac::Quadruple& quadruple){
         if(mtac::isFloat(*quadruple.arg1)){
             auto return_reg = manager.get_bound_pseudo_float_reg(descriptor->float_return_register());
             manager.move(*quadruple.arg1, return_reg);
-            instruction.float_uses.push_back(return_reg);
-        } else if(boost::get<std::shared_ptr<Variable>>(&*quadruple.arg1) && ltac::is_float_var(ltac::get_variable(*quadruple.arg1))){
-            auto variable = boost::get<std::shared_ptr<Variable>>(*quadruple.arg1);
+            instruction.edit_usage().float_uses.push_back(return_reg);
+        } else if(boost::get<variable_ref>(&*quadruple.arg1) && ltac::is_float_var(ltac::get_variable(*quadruple.arg1))){
+            auto variable = boost::get<variable_ref>(*quadruple.arg1);
 
             auto reg = manager.get_pseudo_float_reg(variable);
             auto return_reg = manager.get_bound_pseudo_float_reg(descriptor->float_return_register());
 
             bb->emplace_back_low(ltac::Operator::FMOV, return_reg, reg);
-            instruction.float_uses.push_back(return_reg);
+            instruction.edit_usage().float_uses.push_back(return_reg);
         } else {
             auto reg1 = manager.get_bound_pseudo_reg(descriptor->int_return_register1());
             bb->emplace_back_low(ltac::Operator::MOV, reg1, to_arg(*quadruple.arg1));
-            instruction.uses.push_back(reg1);
+            instruction.edit_usage().uses.push_back(reg1);
 
             if(quadruple.arg2){
                 auto reg2 = manager.get_bound_pseudo_reg(descriptor->int_return_register2());
                 bb->emplace_back_low(ltac::Operator::MOV, reg2, to_arg(*quadruple.arg2));
-                instruction.uses.push_back(reg2);
+                instruction.edit_usage().uses.push_back(reg2);
             }
         }
     }
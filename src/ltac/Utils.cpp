@@ -69,11 +69,11 @@ struct ToArgVisitor : public boost::static_visitor<ltac::Argument> {
         return arg;
     }
 
-    ltac::Argument operator()(std::string& arg) const {
-        return arg;
+    ltac::Argument operator()(interned_string& arg) const {
+        return arg.str();
     }
 
-    ltac::Argument operator()(std::shared_ptr<Variable> variable) const {
+    ltac::Argument operator()(variable_ref variable) const {
         if(ltac::is_float_var(variable)){
             return to_float_register(variable, manager);
         } else {
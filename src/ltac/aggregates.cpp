@@ -36,7 +36,8 @@ void ltac::allocate_aggregates(mtac::Program& program){
 
                 if (!variable->is_reference() && (position.is_temporary() || position.is_variable())
                     && (type == STRING || type->is_template_type() || type->is_array() || type->is_custom_type() || escaped->count(variable))) {
-                    current_position -= type->size();
+                    //Keep the aggregates aligned on the stack
+                    current_position -= (type->size() + INT->size() - 1) / INT->size() * INT->size();
 
                     Position position(PositionType::STACK, current_position + INT->size());
                     variable->setPosition(position);
@@ -33,6 +33,24 @@ bool ltac::bit_matrix::is_set(std::size_t i, std::size_t j){
     return bitset[i * size + j];
 }
 
+std::size_t ltac::bit_matrix::find_first(std::size_t i) const {
+    if(size == 0 || bitset[i * size]){
+        return 0;
+    }
+
+    return find_next(i, 0);
+}
+
+std::size_t ltac::bit_matrix::find_next(std::size_t i, std::size_t j) const {
+    auto next = bitset.find_next(i * size + j);
+
+    if(next == boost::dynamic_bitset<>::npos || next >= (i + 1) * size){
+        return size;
+    }
+
+    return next - i * size;
+}
+
 ltac::sub_bit_matrix ltac::bit_matrix::operator[](std::size_t i){
     return {*this, i};
 }
@@ -6,7 +6,9 @@
 //=======================================================================
 
 #include <list>
+#include <queue>
 #include <ranges>
+#include <set>
 
 #include "cpp_utils/assert.hpp"
 
@@ -17,6 +19,8 @@
 #include "Type.hpp"
 
 #include "mtac/GlobalOptimizations.hpp"
+#include "mtac/data_flow_cursor.hpp"
+#include "mtac/profile.hpp"
 
 #include "ltac/LiveRegistersProblem.hpp"
 #include "ltac/register_allocator.hpp"
@@ -27,13 +31,14 @@
 /*
  * Register allocation using Chaitin-style graph coloring allocation. 
  *
- * The renumber and coalescing are simplified by renumbering coalescing 
- * only pseudo registers that are local to a basic block. 
+ * The renumber is simplified by renumbering only pseudo registers that 
+ * are local to a basic block. The copies are coalesced conservatively 
+ * (Briggs and George tests) directly in the interference graph. 
  *
  * TODO:
  *  - Use Chaitin-Briggs optimistic coloring
  *  - Implement rematerialization
- *  - Use UD-chains and make renumber and coalescing complete
+ *  - Use UD-chains and make renumber complete
  */
 
 using namespace eddic;
@@ -65,12 +70,19 @@ void update_uses(ltac::Instruction&, std::unordered_map<Source, Target>&){
 
 template<>
 void update_uses(ltac::Instruction& statement, std::unordered_map<ltac::PseudoRegister, ltac::Register>& register_allocation){
-    for(auto& reg : statement.uses){
-        statement.hard_uses.push_back(register_allocation[reg]);
+    //Most instructions have no implicit registers
+    if(statement.usage().uses.empty() && statement.usage().kills.empty()){
+        return;
+    }
+
+    auto& usage = statement.edit_usage();
+
+    for(auto& reg : usage.uses){
+        usage.hard_uses.push_back(register_allocation[reg]);
     }
 
-    for(auto& reg : statement.kills){
-        statement.hard_kills.push_back(register_allocation[reg]);
+    for(auto& reg : usage.kills){
+        usage.hard_kills.push_back(register_allocation[reg]);
     }
 }
 
@@ -231,11 +243,11 @@ void find_reg(Opt& arg, std::unordered_set<Pseudo>& registers){
 template <typename Stmt, typename Pseudo>
 void get_special_uses(Stmt & instruction, std::unordered_set<Pseudo> & local_pseudo_registers) {
     if constexpr (std::is_same_v<Pseudo, ltac::PseudoFloatRegister>) {
-        for (auto & reg : instruction.float_uses) {
+        for (auto & reg : instruction.usage().float_uses) {
             local_pseudo_registers.insert(reg);
         }
     } else {
-        for (auto & reg : instruction.uses) {
+        for (auto & reg : instruction.usage().uses) {
             local_pseudo_registers.insert(reg);
         }
     }
@@ -365,12 +377,12 @@ void gather_pseudo_regs(mtac::Function& function, ltac::interference_graph<Pseud
     LOG<Trace>("registers") << "Found " << graph.size() << " pseudo registers" << log::endl;
 }
 
-template <typename Pseudo, typename Results>
-std::unordered_set<Pseudo> & get_live_results(Results & results) {
+template <typename Pseudo, typename Results, typename Functor>
+void for_each_live(const Results & results, Functor functor) {
     if constexpr (std::is_same_v<Pseudo, ltac::PseudoFloatRegister>) {
-        return results.float_registers;
+        results.for_each_float_register(functor);
     } else {
-        return results.registers;
+        results.for_each_register(functor);
     }
 }
 
@@ -388,31 +400,38 @@ void build_interference_graph(ltac::interference_graph<Pseudo>& graph, mtac::Fun
     ltac::LivePseudoRegistersProblem problem;
     auto live_results = mtac::data_flow(function, problem);
 
+    mtac::data_flow_cursor<ltac::LivePseudoRegistersProblem> cursor(problem, live_results);
+
+    std::vector<std::size_t> live_registers;
+
     for(auto& bb : function){
-        for(auto& statement : bb->l_statements){
-            auto& results = live_results->OUT_S[statement.uid()];
+        for(std::size_t i = 0; i < bb->l_statements.size(); ++i){
+            auto& results = cursor.out(bb, i);
 
             if(results.top()){
                continue; 
             }
 
-            auto& live_registers = get_live_results<Pseudo>(results.values());
-
-            if(live_registers.size() > 1){
-                auto it = live_registers.begin();
-                auto end = live_registers.end();
+            live_registers.clear();
+            for_each_live<Pseudo>(results.values(), [&](const Pseudo& reg){ live_registers.push_back(graph.convert(reg)); });
 
-                while(it != end){
-                    auto next = it;
-                    ++next;
+            for(std::size_t i = 0; i < live_registers.size(); ++i){
+                for(std::size_t j = i + 1; j < live_registers.size(); ++j){
+                    graph.add_edge(live_registers[i], live_registers[j]);
+                }
+            }
 
-                    while(next != end){
-                        graph.add_edge(graph.convert(*it), graph.convert(*next));
+            //A register written but never read must not overwrite the live registers
+            auto& statement = bb->l_statements[i];
+            if(!statement.is_jump() && !statement.is_label() && statement.arg1 && ltac::erase_result_complete(statement.op)){
+                if(auto* ptr = boost::get<Pseudo>(&*statement.arg1)){
+                    auto written = graph.convert(*ptr);
 
-                        ++next;
+                    if(std::ranges::find(live_registers, written) == live_registers.end()){
+                        for(auto live : live_registers){
+                            graph.add_edge(written, live);
+                        }
                     }
-
-                    ++it;
                 }
             }
         }
@@ -433,80 +452,132 @@ bool is_copy(ltac::Instruction & statement) {
 }
 
 template<typename Pseudo>
-bool coalesce(ltac::interference_graph<Pseudo>& graph, mtac::Function& function){
-    local_reg<Pseudo> local_pseudo_registers;
-    find_local_registers(function, local_pseudo_registers);
-    
-    std::unordered_set<Pseudo> prune;
-    std::unordered_map<Pseudo, Pseudo> replaces;
+unsigned int number_of_registers(Platform platform){
+    if constexpr (std::is_same_v<Pseudo, ltac::PseudoFloatRegister>) {
+        return getPlatformDescriptor(platform)->number_of_float_registers();
+    } else {
+        return getPlatformDescriptor(platform)->number_of_registers();
+    }
+}
 
-    //TODO Instead of pruning dependent registers pairs, update the graph 
-    //and continue to avoid too many rebuilding of the graph
+//Briggs: the merged node has less than K neighbors of significant degree
+template<typename Pseudo>
+bool briggs_safe(ltac::interference_graph<Pseudo>& graph, std::size_t a, std::size_t b, std::size_t K){
+    std::size_t significant = 0;
 
-    for(const auto& bb : function){
-        for(auto& instruction : bb->l_statements){
-            if(is_copy<Pseudo>(instruction)){
-                auto reg1 = boost::get<Pseudo>(*instruction.arg1);
-                auto reg2 = boost::get<Pseudo>(*instruction.arg2);
-
-                if(
-                           reg1 != reg2
-                        && !reg1.bound && !reg2.bound 
-                        && local_pseudo_registers[bb].contains(reg1) && local_pseudo_registers[bb].contains(reg2) 
-                        && !graph.connected(graph.convert(reg1), graph.convert(reg2))
-                        && !prune.contains(reg1) && !prune.contains(reg2))
-                {
-                    LOG<Debug>("registers") << "Coalesce " << reg1 << " and " << reg2 << log::endl;
-
-                    replaces[reg1] = reg2;
-                    prune.insert(reg1);
-                    prune.insert(reg2);
-
-                    ltac::transform_to_nop(instruction);            
-                }
-            }
+    for(auto t : graph.neighbors(a)){
+        //The common neighbors lose one neighbor with the merge
+        auto degree = graph.connected(t, b) ? graph.degree(t) - 1 : graph.degree(t);
+
+        if(degree >= K){
+            ++significant;
         }
     }
 
-    replace_registers(function, replaces);
+    for(auto t : graph.neighbors(b)){
+        if(!graph.connected(t, a) && graph.degree(t) >= K){
+            ++significant;
+        }
+    }
 
-    return !replaces.empty();
+    return significant < K;
 }
 
-//4. Spill costs
+//George: each neighbor of a already interferes with b or is of insignificant degree
+template<typename Pseudo>
+bool george_safe(ltac::interference_graph<Pseudo>& graph, std::size_t a, std::size_t b, std::size_t K){
+    for(auto t : graph.neighbors(a)){
+        if(graph.degree(t) >= K && !graph.connected(t, b)){
+            return false;
+        }
+    }
 
-constexpr std::size_t store_cost = 5;
-constexpr std::size_t load_cost = 3;
+    return true;
+}
+
+template<typename Pseudo>
+bool coalesce(ltac::interference_graph<Pseudo>& graph, mtac::Function& function, Platform platform){
+    auto K = number_of_registers<Pseudo>(platform);
+
+    std::size_t coalesced = 0;
+
+    //A merge can make other copies safe to coalesce, so the copies are visited until no more merges are done
+    bool changes = true;
+    while(changes){
+        changes = false;
+
+        for(const auto& bb : function){
+            for(auto& instruction : bb->l_statements){
+                if(is_copy<Pseudo>(instruction)){
+                    auto reg1 = boost::get<Pseudo>(*instruction.arg1);
+                    auto reg2 = boost::get<Pseudo>(*instruction.arg2);
+
+                    if(reg1 == reg2 || reg1.bound || reg2.bound){
+                        continue;
+                    }
 
-constexpr std::size_t depth_cost(unsigned int depth){
-    unsigned int cost = 1;
+                    auto a = graph.alias(graph.convert(reg1));
+                    auto b = graph.alias(graph.convert(reg2));
 
-    while(depth > 0){
-        cost *= 10;
+                    if(a == b){
+                        //The copy has become useless with a previous merge
+                        ltac::transform_to_nop(instruction);
+                        continue;
+                    }
+
+                    if(!graph.connected(a, b) && (briggs_safe(graph, a, b, K) || george_safe(graph, a, b, K))){
+                        LOG<Debug>("registers") << "Coalesce " << reg1 << " and " << reg2 << log::endl;
+
+                        graph.merge(a, b);
+                        ++coalesced;
+                        changes = true;
+
+                        ltac::transform_to_nop(instruction);
+                    }
+                }
+            }
+        }
+    }
 
-        --depth;
+    if(!coalesced){
+        return false;
     }
 
-    return cost;
+    std::unordered_map<Pseudo, Pseudo> replaces;
+
+    for(std::size_t r = 0; r < graph.size(); ++r){
+        if(graph.merged(r)){
+            replaces[graph.convert(r)] = graph.convert(graph.alias(r));
+        }
+    }
+
+    replace_registers(function, replaces);
+
+    return true;
 }
 
+//4. Spill costs
+
+constexpr std::size_t store_cost = 5;
+constexpr std::size_t load_cost = 3;
+
 template<typename Opt, typename Pseudo>
-void update_cost_reg(Opt& reg, ltac::interference_graph<Pseudo>& graph, unsigned int depth){
+void update_cost_reg(Opt& reg, ltac::interference_graph<Pseudo>& graph, std::size_t weight){
     if(reg){
         if(auto* ptr = boost::get<Pseudo>(&*reg)){
-            graph.spill_cost(graph.convert(*ptr)) += load_cost * depth_cost(depth);
+            graph.spill_cost(graph.convert(*ptr)) += load_cost * weight;
         }
     }
 }
 
 template<typename Opt, typename Pseudo>
-void update_cost(Opt& arg, ltac::interference_graph<Pseudo>& graph, unsigned int depth){
+void update_cost(Opt& arg, ltac::interference_graph<Pseudo>& graph, std::size_t weight){
     if(arg){
         if(auto* ptr = boost::get<Pseudo>(&*arg)){
-            graph.spill_cost(graph.convert(*ptr)) += load_cost * depth_cost(depth);
+            graph.spill_cost(graph.convert(*ptr)) += load_cost * weight;
         } else if(auto* ptr = boost::get<ltac::Address>(&*arg)){
-            update_cost_reg(ptr->base_register, graph, depth);
-            update_cost_reg(ptr->scaled_register, graph, depth);
+            update_cost_reg(ptr->base_register, graph, weight);
+            update_cost_reg(ptr->scaled_register, graph, weight);
         }
     }
 }
@@ -514,32 +585,26 @@ void update_cost(Opt& arg, ltac::interference_graph<Pseudo>& graph, unsigned int
 template<typename Pseudo>
 void estimate_spill_costs(mtac::Function& function, ltac::interference_graph<Pseudo>& graph){
     for(const auto& bb : function){
+        //The accesses are weighted by the frequency of the block, from the profile or from the loop depth
+        auto weight = mtac::block_weight(function, bb);
+
         for(auto& statement : bb->l_statements){
             if(ltac::erase_result(statement.op)){
                 if(auto* reg_ptr = boost::get<Pseudo>(&*statement.arg1)){
-                    graph.spill_cost(graph.convert(*reg_ptr)) += store_cost * depth_cost(bb->depth);
+                    graph.spill_cost(graph.convert(*reg_ptr)) += store_cost * weight;
                 }
             } else {
-                update_cost(statement.arg1, graph, bb->depth);
+                update_cost(statement.arg1, graph, weight);
             }
 
-            update_cost(statement.arg2, graph, bb->depth);
-            update_cost(statement.arg3, graph, bb->depth);
+            update_cost(statement.arg2, graph, weight);
+            update_cost(statement.arg3, graph, weight);
         }
     }
 }
 
 //5. Simplify
 
-template<typename Pseudo>
-unsigned int number_of_registers(Platform platform){
-    if constexpr (std::is_same_v<Pseudo, ltac::PseudoFloatRegister>) {
-        return getPlatformDescriptor(platform)->number_of_float_registers();
-    } else {
-        return getPlatformDescriptor(platform)->number_of_registers();
-    }
-}
-
 template<typename Pseudo>
 std::vector<unsigned short> hard_registers(Platform platform){
     if constexpr (std::is_same_v<Pseudo, ltac::PseudoFloatRegister>) {
@@ -549,77 +614,114 @@ std::vector<unsigned short> hard_registers(Platform platform){
     }
 }
 
-//TODO Find a way to get rid of that and use graph.degree() instead
-//graph.degree() is constant-time...
-
+//The worklists of the simplify phase. The candidates whose degree is lower than K are kept
+//in a min-heap so that the lowest one is simplified first, the others are kept ordered for the
+//spill heuristic. The degrees are updated incrementally when a candidate is simplified.
 template<typename Pseudo>
-std::size_t degree(ltac::interference_graph<Pseudo>& graph, std::size_t candidate, const std::list<std::size_t>& order){
-    std::size_t count = 0;
+struct simplify_worklist {
+    enum class state : char { HIGH, LOW, REMOVED };
 
-    const auto& neighbors = graph.neighbors(candidate);
+    ltac::interference_graph<Pseudo>& graph;
+    const std::size_t K;
 
-    std::unordered_set<std::size_t> bound;
+    std::vector<std::size_t> degrees;
+    std::vector<state> states;
 
-    for(auto neighbor : neighbors){
-        auto n_reg = graph.convert(neighbor);
+    std::priority_queue<std::size_t, std::vector<std::size_t>, std::greater<>> low;
+    std::set<std::size_t> high;
 
-        if (std::ranges::find(order, neighbor) == order.end()) {
-            ++count;
+    simplify_worklist(ltac::interference_graph<Pseudo>& graph, std::size_t K) : graph(graph), K(K), degrees(graph.size(), 0), states(graph.size(), state::REMOVED) {}
+
+    void add(std::size_t candidate){
+        //The bound registers are removed first, but each binding still uses a color
+        std::unordered_set<std::size_t> bindings;
+
+        for(auto neighbor : graph.neighbors(candidate)){
+            auto n_reg = graph.convert(neighbor);
 
             if(n_reg.bound){
-                bound.insert(n_reg.binding);
+                bindings.insert(n_reg.binding);
+            } else {
+                ++degrees[candidate];
             }
+        }
+
+        degrees[candidate] += bindings.size();
+
+        LOG<Dev>("registers") << "Degree(" << graph.convert(candidate) << ") = " << degrees[candidate] << log::endl;
+
+        if(degrees[candidate] < K){
+            states[candidate] = state::LOW;
+            low.push(candidate);
         } else {
-            if(n_reg.bound && !bound.contains(n_reg.binding)){
-                ++count;
-                bound.insert(n_reg.binding);
-            }
+            states[candidate] = state::HIGH;
+            high.insert(candidate);
         }
     }
 
-    return count;
-}
+    double spill_heuristic(std::size_t candidate) const {
+        return static_cast<double>(graph.spill_cost(candidate)) / static_cast<double>(degrees[candidate]);
+    }
 
-template<typename Pseudo>
-double spill_heuristic(ltac::interference_graph<Pseudo>& graph, std::size_t reg, std::list<std::size_t>& order){
-    return static_cast<double>(graph.spill_cost(reg)) / static_cast<double>(degree(graph, reg, order));
-}
+    //The spilled candidates are not removed from the graph, their neighbors keep their degree
+    void spill(std::size_t candidate){
+        states[candidate] = state::REMOVED;
+        high.erase(candidate);
+    }
+
+    void simplify(std::size_t candidate){
+        states[candidate] = state::REMOVED;
+
+        for(auto neighbor : graph.neighbors(candidate)){
+            if(states[neighbor] != state::REMOVED && !graph.convert(neighbor).bound){
+                if(--degrees[neighbor] == K - 1 && states[neighbor] == state::HIGH){
+                    high.erase(neighbor);
+                    states[neighbor] = state::LOW;
+                    low.push(neighbor);
+                }
+            }
+        }
+    }
+};
 
 template<typename Pseudo>
 void simplify(ltac::interference_graph<Pseudo>& graph, Platform platform, std::vector<std::size_t>& spilled, std::list<std::size_t>& order){
-    std::set<std::size_t> n;
+    auto K = number_of_registers<Pseudo>(platform);
+    LOG<Trace>("registers") << "Attempt a " << K << "-coloring of the graph" << log::endl;
+
+    simplify_worklist<Pseudo> worklist(graph, K);
+
     for(std::size_t r = 0; r < graph.size(); ++r){
         if(graph.convert(r).bound){
             order.push_back(r);
-            graph.remove_node(r);
-        } else {
-            n.insert(r);
         }
     }
 
-    auto K = number_of_registers<Pseudo>(platform);
-    LOG<Trace>("registers") << "Attempt a " << K << "-coloring of the graph" << log::endl;
+    for(std::size_t r = 0; r < graph.size(); ++r){
+        //The merged nodes do not appear in the function anymore
+        if(!graph.convert(r).bound && !graph.merged(r)){
+            worklist.add(r);
+        }
+    }
 
-    while(!n.empty()){
-        std::size_t node = 0;
-        bool found = false;
+    while(!worklist.low.empty() || !worklist.high.empty()){
+        if(!worklist.low.empty()){
+            auto node = worklist.low.top();
+            worklist.low.pop();
 
-        for(auto candidate : n){
-            LOG<Dev>("registers") << "Degree(" << graph.convert(candidate) << ") = " << degree(graph, candidate, order) << log::endl;
-            if(degree(graph, candidate, order) < K){
-                node = candidate;
-                found = true;
-                break;
-            }
-        }
+            LOG<Trace>("registers") << "Put pseudo " << graph.convert(node) << " on the stack" << log::endl;
+
+            order.push_back(node);
+            worklist.simplify(node);
+        } else {
+            auto node = *worklist.high.begin();
+            auto min_cost = worklist.spill_heuristic(node);
 
-        if(!found){
-            node = *n.begin();
-            auto min_cost = spill_heuristic(graph, node, order);
+            for(auto candidate : worklist.high){
+                auto cost = worklist.spill_heuristic(candidate);
 
-            for(auto candidate : n){
-                if(!graph.convert(candidate).bound && spill_heuristic(graph, candidate, order) < min_cost){
-                    min_cost = spill_heuristic(graph, candidate, order);
+                if(cost < min_cost){
+                    min_cost = cost;
                     node = candidate;
                 }
             }
@@ -627,14 +729,8 @@ void simplify(ltac::interference_graph<Pseudo>& graph, Platform platform, std::v
             LOG<Trace>("registers") << "Mark pseudo " << node << "(" << graph.convert(node) << ") to be spilled" << log::endl;
 
             spilled.push_back(node);
-        } else {
-            LOG<Trace>("registers") << "Put pseudo " << graph.convert(node) << " on the stack" << log::endl;
-
-            order.push_back(node);
+            worklist.spill(node);
         }
-
-        n.erase(node);
-        graph.remove_node(node);
     }
 
     LOG<Trace>("registers") << "Graph simplified" << log::endl;
@@ -743,53 +839,137 @@ void spill_store(ltac::PseudoFloatRegister& pseudo, unsigned int position, It& i
 }
 
 template<typename Pseudo>
-void spill_code(ltac::interference_graph<Pseudo>& graph, mtac::Function& function, std::vector<std::size_t>& spilled){
-    auto current_reg = last_register<Pseudo>(function);
-    
-    for(auto reg : spilled){
-        auto pseudo_reg = graph.convert(reg);
+unsigned int spill_slot_size(){
+    if constexpr (std::is_same_v<Pseudo, ltac::PseudoFloatRegister>) {
+        return FLOAT->size();
+    } else {
+        return INT->size();
+    }
+}
 
-        //Allocate stack space for the pseudo reg
-        auto position = function.context->stack_position();
-        position -= INT->size();
-        function.context->set_stack_position(position);
+//Each access to the spilled register uses its own short-lived pseudo register
+template<typename Pseudo>
+void spill_each_access(const mtac::basic_block_p& bb, const Pseudo& pseudo_reg, unsigned int position, std::size_t& current_reg){
+    auto it = iterate(bb->l_statements);
 
-        for(auto& bb : function){
-            auto it = iterate(bb->l_statements);
-            
-            //TODO Add support for spilling float registers
+    while(it.has_next()){
+        auto& statement = *it;
+
+        if(is_store_complete(statement, pseudo_reg)){
+            Pseudo new_pseudo_reg(++current_reg);
 
-            while(it.has_next()){
-                auto& statement = *it;
+            replace_register(statement, pseudo_reg, new_pseudo_reg);
 
-                if(is_store_complete(statement, pseudo_reg)){
-                    Pseudo new_pseudo_reg(++current_reg);
+            spill_store(new_pseudo_reg, position, it);
+        } else if(is_store(statement, pseudo_reg)){
+            Pseudo new_pseudo_reg(++current_reg);
 
-                    replace_register(statement, pseudo_reg, new_pseudo_reg);
+            replace_register(statement, pseudo_reg, new_pseudo_reg);
 
-                    spill_store(new_pseudo_reg, position, it);
-                } else if(is_store(statement, pseudo_reg)){
-                    Pseudo new_pseudo_reg(++current_reg);
-                    
-                    replace_register(statement, pseudo_reg, new_pseudo_reg);
-                    
-                    spill_load(new_pseudo_reg, position, it);
+            spill_load(new_pseudo_reg, position, it);
 
-                    ++it;
-                    
-                    spill_store(new_pseudo_reg, position, it);
-                } else if(is_load(statement, pseudo_reg)){
-                    Pseudo new_pseudo_reg(++current_reg);
+            ++it;
 
-                    replace_register(statement, pseudo_reg, new_pseudo_reg);
+            spill_store(new_pseudo_reg, position, it);
+        } else if(is_load(statement, pseudo_reg)){
+            Pseudo new_pseudo_reg(++current_reg);
 
-                    spill_load(new_pseudo_reg, position, it);
+            replace_register(statement, pseudo_reg, new_pseudo_reg);
+
+            spill_load(new_pseudo_reg, position, it);
+
+            ++it;
+        } 
+
+        ++it;
+    }
+}
+
+//The spilled register is split at the boundaries of the basic block: it is loaded
+//at most once in the block and the following accesses reuse the same pseudo register
+template<typename Pseudo>
+void spill_split_block(mtac::Function& function, const mtac::basic_block_p& bb, const Pseudo& pseudo_reg, unsigned int position, std::size_t& current_reg){
+    auto it = iterate(bb->l_statements);
+
+    Pseudo new_pseudo_reg;
+    bool available = false;
+
+    //Number of reads of the spilled register and number of reloads inserted for them
+    std::size_t reads = 0;
+    std::size_t reloads = 0;
+    std::size_t stores = 0;
+
+    while(it.has_next()){
+        auto& statement = *it;
+
+        if(is_store_complete(statement, pseudo_reg)){
+            if(!available){
+                new_pseudo_reg = Pseudo(++current_reg);
+                available = true;
+            }
+
+            replace_register(statement, pseudo_reg, new_pseudo_reg);
+
+            spill_store(new_pseudo_reg, position, it);
+            ++stores;
+        } else if(is_store(statement, pseudo_reg) || is_load(statement, pseudo_reg)){
+            bool store = is_store(statement, pseudo_reg);
+            bool load = !available;
+
+            if(load){
+                new_pseudo_reg = Pseudo(++current_reg);
+                available = true;
+            }
+
+            replace_register(statement, pseudo_reg, new_pseudo_reg);
+
+            ++reads;
+
+            if(load){
+                spill_load(new_pseudo_reg, position, it);
+                ++reloads;
 
-                    ++it;
-                } 
-                
                 ++it;
             }
+
+            if(store){
+                spill_store(new_pseudo_reg, position, it);
+                ++stores;
+            }
+        }
+
+        ++it;
+    }
+
+    //Only the blocks where spill code has been inserted for the split register are counted
+    if(reloads || stores){
+        auto& stats = function.context->global().stats();
+
+        stats.inc_counter("split_spills");
+        stats.inc_counter("split_spill_reads", reads);
+        stats.inc_counter("split_spill_reloads", reloads);
+    }
+}
+
+template<typename Pseudo>
+void spill_code(ltac::interference_graph<Pseudo>& graph, mtac::Function& function, std::vector<std::size_t>& spilled, bool split){
+    std::size_t current_reg = last_register<Pseudo>(function);
+    
+    for(auto reg : spilled){
+        auto pseudo_reg = graph.convert(reg);
+
+        //Allocate stack space for the pseudo reg
+        auto position = function.context->stack_position();
+        position -= spill_slot_size<Pseudo>();
+        function.context->set_stack_position(position);
+
+        for(auto& bb : function){
+            //Inside loops, the register is reloaded once per block instead of once per use
+            if(split && bb->depth > 0){
+                spill_split_block(function, bb, pseudo_reg, position, current_reg);
+            } else {
+                spill_each_access(bb, pseudo_reg, position, current_reg);
+            }
         }
     }
 
@@ -800,13 +980,18 @@ void spill_code(ltac::interference_graph<Pseudo>& graph, mtac::Function& functio
 
 template<typename Pseudo, typename Hard>
 void register_allocation(mtac::Function& function, Platform platform){
-    bool coalesced = false;
+    //Only the first spills split the live ranges, the registers spilled after that are spilled at
+    //each access, which guarantees that the allocation terminates
+    bool split = true;
+
+    auto& timing = function.context->global().timing();
 
     while(true){
-        if(!coalesced){
-            //1. Renumber
-            renumber<Pseudo>(function);
-        }
+        trace_timer timer(timing, "register_allocation_round", function.get_name());
+        function.context->global().stats().inc_counter("register_allocation_rounds");
+
+        //1. Renumber
+        renumber<Pseudo>(function);
 
         //2. Build
         ltac::interference_graph<Pseudo> graph;
@@ -817,12 +1002,8 @@ void register_allocation(mtac::Function& function, Platform platform){
             return;
         }
 
-        //3. Coalesce
-        coalesced = coalesce(graph, function);
-
-        if(coalesced){
-            continue;
-        }
+        //3. Coalesce (the graph is updated in place)
+        coalesce(graph, function, platform);
 
         //4. Spill costs
         estimate_spill_costs(function, graph);
@@ -834,7 +1015,8 @@ void register_allocation(mtac::Function& function, Platform platform){
 
         if(!spilled.empty()){
             //6. Spill code
-            spill_code(graph, function, spilled);
+            spill_code(graph, function, spilled, split);
+            split = false;
         } else {
             //7. Select
             select<Pseudo, Hard>(graph, function, platform, order);
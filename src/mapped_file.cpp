@@ -0,0 +1,51 @@
+//=======================================================================
+// Copyright Baptiste Wicht 2011-2016.
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "mapped_file.hpp"
+
+using namespace eddic;
+
+mapped_file::mapped_file(const std::string& path){
+    int fd = open(path.c_str(), O_RDONLY);
+
+    if(fd < 0){
+        return;
+    }
+
+    struct stat infos;
+    if(fstat(fd, &infos) == 0 && S_ISREG(infos.st_mode)){
+        m_size = infos.st_size;
+
+        //mmap cannot map an empty file
+        if(m_size == 0){
+            m_valid = true;
+        } else {
+            void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+            if(data != MAP_FAILED){
+                m_data = static_cast<const char*>(data);
+                m_valid = true;
+            } else {
+                m_size = 0;
+            }
+        }
+    }
+
+    //The mapping stays valid once the descriptor is closed
+    close(fd);
+}
+
+mapped_file::~mapped_file(){
+    if(m_data){
+        munmap(const_cast<char*>(m_data), m_size);
+    }
+}
@@ -24,7 +24,7 @@ void mtac::extract_basic_blocks(mtac::Program & program) {
     timing_timer timer(program.context.timing(), "basic_block_extraction");
 
     for (auto & function : program.functions) {
-        std::unordered_map<std::string, std::shared_ptr<basic_block>> labels;
+        std::unordered_map<std::string, basic_block_p> labels;
 
         // The first is always a leader
         bool nextIsLeader = true;
@@ -139,7 +139,7 @@ Offset variant_cast(Source source){
     if(auto* ptr = boost::get<int>(&source)){
         return *ptr;
     }
-    if (auto* ptr = boost::get<std::shared_ptr<Variable>>(&source)) {
+    if (auto* ptr = boost::get<variable_ref>(&source)) {
         return *ptr;
     } else {
         cpp_unreachable("Invalid source type");
@@ -406,7 +406,7 @@ arguments compute_expression_operation(mtac::Function& function, std::shared_ptr
                 } else {
                     assert(left.size() == 1);
 
-                    auto index = index_of_array(boost::get<std::shared_ptr<Variable>>(left[0]), index_value, function);
+                    auto index = index_of_array(boost::get<variable_ref>(left[0]), index_value, function);
                     auto data_type = type->data_type();
 
                     if(T == ArgumentType::ADDRESS){
@@ -419,7 +419,7 @@ arguments compute_expression_operation(mtac::Function& function, std::shared_ptr
                         if(data_type == INT || data_type == FLOAT || data_type->is_pointer()){
                             std::shared_ptr<Variable> temp;
                             if(T == ArgumentType::REFERENCE){
-                                temp = function.context->new_reference(data_type, boost::get<std::shared_ptr<Variable>>(left[0]), variant_cast(index));
+                                temp = function.context->new_reference(data_type, boost::get<variable_ref>(left[0]), variant_cast(index));
                             } else {
                                 temp = function.context->new_temporary(data_type);
                             }
@@ -430,7 +430,7 @@ arguments compute_expression_operation(mtac::Function& function, std::shared_ptr
                         } else if(data_type == CHAR || data_type == BOOL){
                             std::shared_ptr<Variable> temp;
                             if(T == ArgumentType::REFERENCE){
-                                temp = function.context->new_reference(data_type, boost::get<std::shared_ptr<Variable>>(left[0]), variant_cast(index));
+                                temp = function.context->new_reference(data_type, boost::get<variable_ref>(left[0]), variant_cast(index));
                             } else {
                                 temp = function.context->new_temporary(data_type);
                             }
@@ -454,7 +454,7 @@ arguments compute_expression_operation(mtac::Function& function, std::shared_ptr
                             //A reference to a structure is a special case
                             //Does not get any value from the array
                             if(T == ArgumentType::REFERENCE){
-                                left = {function.context->new_reference(data_type, boost::get<std::shared_ptr<Variable>>(left[0]), variant_cast(index))};
+                                left = {function.context->new_reference(data_type, boost::get<variable_ref>(left[0]), variant_cast(index))};
                             } else {
                                 cpp_unreachable("Type not handled by BRACKET");
                             }
@@ -468,7 +468,7 @@ arguments compute_expression_operation(mtac::Function& function, std::shared_ptr
         case ast::Operator::DOT:
             {
                 assert(left.size() == 1);
-                auto variable = boost::get<std::shared_ptr<Variable>>(left[0]);
+                auto variable = boost::get<variable_ref>(left[0]);
                 auto& member = boost::get<ast::Literal>(operation_value).value;
 
                 auto [offset, member_type] = mtac::compute_member(function.context->global(), variable->type(), member);
@@ -589,7 +589,7 @@ arguments compute_expression_operation(mtac::Function& function, std::shared_ptr
             {
                 cpp_assert(mtac::isVariable(left[0]), "The visitor should return a variable");
 
-                auto t1 = boost::get<std::shared_ptr<Variable>>(left[0]);
+                auto t1 = boost::get<variable_ref>(left[0]);
                 auto t2 = function.context->new_temporary(type);
 
                 if(type == FLOAT){
@@ -611,7 +611,7 @@ arguments compute_expression_operation(mtac::Function& function, std::shared_ptr
             {
                 cpp_assert(mtac::isVariable(left[0]), "The visitor should return a variable");
 
-                auto t1 = boost::get<std::shared_ptr<Variable>>(left[0]);
+                auto t1 = boost::get<variable_ref>(left[0]);
                 auto t2 = function.context->new_temporary(type);
 
                 if(type == FLOAT){
@@ -732,7 +732,7 @@ struct ToArgumentsVisitor : public boost::static_visitor<arguments> {
 
                     cpp_assert(mtac::isVariable(right[0]), "The visitor should return a variable");
 
-                    auto variable = boost::get<std::shared_ptr<Variable>>(right[0]);
+                    auto variable = boost::get<variable_ref>(right[0]);
 
                     if(variable->position().isGlobal()){
                         return {static_cast<int>(variable->type()->elements())};
@@ -928,7 +928,7 @@ struct ToArgumentsVisitor : public boost::static_visitor<arguments> {
                 cpp_assert(left.size() == 1, "STAR only support one value");
                 cpp_assert(mtac::isVariable(left[0]), "The visitor should return a temporary variable");
 
-                auto variable = boost::get<std::shared_ptr<Variable>>(left[0]);
+                auto variable = boost::get<variable_ref>(left[0]);
 
                 if(T == ArgumentType::ADDRESS){
                     return {variable};
@@ -988,7 +988,7 @@ struct ToArgumentsVisitor : public boost::static_visitor<arguments> {
 
                 cpp_assert(mtac::isVariable(left[0]), "The visitor should return a variable");
 
-                auto t1 = boost::get<std::shared_ptr<Variable>>(left[0]);
+                auto t1 = boost::get<variable_ref>(left[0]);
 
                 if(type == FLOAT){
                     function.emplace_back(t1, t1, mtac::Operator::FADD, 1.0);
@@ -1008,7 +1008,7 @@ struct ToArgumentsVisitor : public boost::static_visitor<arguments> {
 
                 cpp_assert(mtac::isVariable(left[0]), "The visitor should return a variable");
 
-                auto t1 = boost::get<std::shared_ptr<Variable>>(left[0]);
+                auto t1 = boost::get<variable_ref>(left[0]);
 
                 if(type == FLOAT){
                     function.emplace_back(t1, t1, mtac::Operator::FSUB, 1.0);
@@ -1202,7 +1202,7 @@ struct AssignmentVisitor : public boost::static_visitor<> {
         //Assign to an element of an array
         if(last_operation.get<0>() == ast::Operator::BRACKET){
             assert(mtac::isVariable(left[0]));
-            auto array_variable = boost::get<std::shared_ptr<Variable>>(left[0]);
+            auto array_variable = boost::get<variable_ref>(left[0]);
 
             auto& index_value = last_operation.get<1>();
             auto index = index_of_array(array_variable, index_value, function);
@@ -1238,7 +1238,7 @@ struct AssignmentVisitor : public boost::static_visitor<> {
         //Assign to a member of a structure
         else if(last_operation.get<0>() == ast::Operator::DOT){
             assert(mtac::isVariable(left[0]));
-            auto struct_variable = boost::get<std::shared_ptr<Variable>>(left[0]);
+            auto struct_variable = boost::get<variable_ref>(left[0]);
 
             auto& member = boost::get<ast::Literal>(last_operation.get<1>()).value;
 
@@ -1284,7 +1284,7 @@ struct AssignmentVisitor : public boost::static_visitor<> {
         if(dereference_value.op == ast::Operator::STAR){
             auto left = visit(ToArgumentsVisitor<>(function), dereference_value.left_value);
             assert(mtac::isVariable(left[0]));
-            auto pointer_variable = boost::get<std::shared_ptr<Variable>>(left[0]);
+            auto pointer_variable = boost::get<variable_ref>(left[0]);
 
             auto values = visit(ToArgumentsVisitor<>(function), right_value);
             auto right_type = visit(ast::GetTypeVisitor(), right_value);
@@ -1633,6 +1633,59 @@ mtac::Argument moveToArgument(ast::Value value, mtac::Function& function){
     return move_to_arguments(value, function)[0];
 }
 
+//Collect the offsets and the sizes of the values pushed for a value of the given type, in the order of get_member
+void pushed_values(const GlobalContext& global, const std::shared_ptr<const Type>& type, unsigned int offset, std::vector<std::pair<unsigned int, unsigned int>>& values){
+    if(type == STRING){
+        values.emplace_back(offset, INT->size());
+        values.emplace_back(offset + INT->size(), INT->size());
+    } else if(type->is_array() && !type->is_dynamic_array()){
+        auto data_type = type->data_type();
+
+        for(unsigned int i = 0; i < type->elements(); ++i){
+            pushed_values(global, data_type, offset + i * data_type->size(), values);
+        }
+
+        //The number of elements
+        values.emplace_back(offset + type->elements() * data_type->size(), INT->size());
+    } else if(type->is_structure()){
+        auto struct_type = global.get_struct(type);
+
+        for(auto& member : struct_type->members){
+            auto [member_offset, member_type] = mtac::compute_member(global, type, member.name);
+            pushed_values(global, member_type, offset + member_offset, values);
+        }
+    } else if(type == CHAR || type == BOOL){
+        values.emplace_back(offset, 1);
+    } else {
+        values.emplace_back(offset, INT->size());
+    }
+}
+
+/*!
+ * Compute the padding to leave above each value of a structure passed by value. The values are
+ * pushed one by one, the padding of the layout must be pushed as well for the callee to find the
+ * members at their offsets.
+ */
+std::vector<int> struct_paddings(const GlobalContext& global, const std::shared_ptr<const Type>& type){
+    std::vector<std::pair<unsigned int, unsigned int>> values;
+    pushed_values(global, type, 0, values);
+
+    std::vector<int> paddings(values.size(), 0);
+
+    auto end = type->size();
+    for(std::size_t i = values.size(); i > 0; --i){
+        auto [offset, size] = values[i - 1];
+
+        if(offset + size < end){
+            paddings[i - 1] = end - (offset + size);
+        }
+
+        end = offset;
+    }
+
+    return paddings;
+}
+
 void pass_arguments(mtac::Function& function, eddic::Function& definition, std::vector<ast::Value>& values){
     //Fail quickly if no values to pass
     if(values.empty()){
@@ -1668,6 +1721,8 @@ void pass_arguments(mtac::Function& function, eddic::Function& definition, std::
             auto param = context->getVariable(definition.parameter(i--).name());
 
             arguments args;
+            std::vector<int> paddings;
+
             if(param->type()->is_pointer()){
                 args = visit(ToArgumentsVisitor<ArgumentType::ADDRESS>(function), first);
             } else {
@@ -1677,14 +1732,22 @@ void pass_arguments(mtac::Function& function, eddic::Function& definition, std::
                     copy_construct(function, param->type(), new_temporary, first);
 
                     args = visit_non_variant(ToArgumentsVisitor<>(function), new_temporary);
+                    paddings = struct_paddings(function.context->global(), param->type());
                 } else {
                     args = visit(ToArgumentsVisitor<>(function), first);
                 }
             }
 
-            for(auto& arg : boost::adaptors::reverse(args)){
+            for(std::size_t j = args.size(); j > 0; --j){
+                auto& arg = args[j - 1];
+
                 if(param->type()->is_pointer()){
                     function.emplace_back(mtac::Operator::PPARAM, arg, param, definition);
+                } else if(paddings.size() == args.size() && paddings[j - 1] > 0){
+                    //The padding is pushed with the value, in the second argument
+                    mtac::Quadruple quadruple(mtac::Operator::PARAM, arg, param, definition);
+                    quadruple.arg2 = paddings[j - 1];
+                    function.push_back(std::move(quadruple));
                 } else {
                     function.emplace_back(mtac::Operator::PARAM, arg, param, definition);
                 }
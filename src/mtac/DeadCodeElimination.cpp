@@ -38,7 +38,7 @@ bool mtac::dead_code_elimination::operator()(mtac::Function& function){
 
         for(auto& quadruple : boost::adaptors::reverse(block->statements)){
             if(quadruple.result && mtac::erase_result(quadruple.op)){
-                if(out.top() || out.values().find(quadruple.result) == out.values().end()){
+                if(!problem.live(out, quadruple.result)){
                     to_delete.push_back(quadruple.uid());
                 }
             }
@@ -78,13 +78,13 @@ bool mtac::dead_code_elimination::operator()(mtac::Function& function){
     for(auto& block : function){
         for(auto& quadruple : block->statements){
             if(quadruple.result && mtac::erase_result(quadruple.op)){
-                if_init_not_equals<std::shared_ptr<Variable>>(quadruple.arg1, quadruple.result, [&candidates](std::shared_ptr<Variable>& var){ candidates.erase(var);});
-                if_init_not_equals<std::shared_ptr<Variable>>(quadruple.arg2, quadruple.result, [&candidates](std::shared_ptr<Variable>& var){ candidates.erase(var);});
+                if_init_not_equals<variable_ref>(quadruple.arg1, quadruple.result, [&candidates](variable_ref var){ candidates.erase(var);});
+                if_init_not_equals<variable_ref>(quadruple.arg2, quadruple.result, [&candidates](variable_ref var){ candidates.erase(var);});
             } else {
                 candidates.erase(quadruple.result);
 
-                if_init<std::shared_ptr<Variable>>(quadruple.arg1, [&candidates](std::shared_ptr<Variable>& var){ candidates.erase(var); });
-                if_init<std::shared_ptr<Variable>>(quadruple.arg2, [&candidates](std::shared_ptr<Variable>& var){ candidates.erase(var); });
+                if_init<variable_ref>(quadruple.arg1, [&candidates](variable_ref var){ candidates.erase(var); });
+                if_init<variable_ref>(quadruple.arg2, [&candidates](variable_ref var){ candidates.erase(var); });
             }
         }
     }
@@ -108,7 +108,7 @@ bool mtac::dead_code_elimination::operator()(mtac::Function& function){
     for(auto& block : function){
         for(auto& quadruple : block->statements){
             if(quadruple.op == mtac::Operator::DOT || quadruple.op == mtac::Operator::FDOT || quadruple.op == mtac::Operator::PDOT){
-                if(auto* var_ptr = boost::get<std::shared_ptr<Variable>>(&*quadruple.arg1)){
+                if(auto* var_ptr = boost::get<variable_ref>(&*quadruple.arg1)){
                     if(auto* offset_ptr = boost::get<int>(&*quadruple.arg2)){
                         mtac::Offset offset(*var_ptr, *offset_ptr);
                         used_offsets.insert(offset);
@@ -20,22 +20,22 @@ mtac::escaped_variables_ptr mtac::escape_analysis(mtac::Function& function){
         for(auto& quadruple : block->statements){
             if(quadruple.op == mtac::Operator::PASSIGN){
                 if(quadruple.arg1 && mtac::isVariable(*quadruple.arg1)){
-                    auto var = boost::get<std::shared_ptr<Variable>>(*quadruple.arg1);
+                    auto var = boost::get<variable_ref>(*quadruple.arg1);
                     pointer_escaped->insert(var);
                 }
             } else if(quadruple.op == mtac::Operator::DOT_PASSIGN){
                 if(quadruple.arg2 && mtac::isVariable(*quadruple.arg2)){
-                    auto var = boost::get<std::shared_ptr<Variable>>(*quadruple.arg2);
+                    auto var = boost::get<variable_ref>(*quadruple.arg2);
                     pointer_escaped->insert(var);
                 }
             } else if(quadruple.op == mtac::Operator::PDOT){
                 if(quadruple.arg1 && mtac::isVariable(*quadruple.arg1)){
-                    auto var = boost::get<std::shared_ptr<Variable>>(*quadruple.arg1);
+                    auto var = boost::get<variable_ref>(*quadruple.arg1);
                     pointer_escaped->insert(var);
                 }
             } else if(quadruple.op == mtac::Operator::PPARAM){
                 if(mtac::isVariable(*quadruple.arg1)){
-                    auto var = boost::get<std::shared_ptr<Variable>>(*quadruple.arg1);
+                    auto var = boost::get<variable_ref>(*quadruple.arg1);
                     pointer_escaped->insert(var);
                 }
             }
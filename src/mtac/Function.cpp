@@ -26,8 +26,8 @@ mtac::Function::Function(FunctionContext * c, std::string n, eddic::Function& de
 mtac::Function::Function(mtac::Function&& rhs) : 
             context(std::move(rhs.context)), _definition(rhs._definition), 
             statements(std::move(rhs.statements)), 
-            _pure(std::move(rhs._pure)), _standard(std::move(rhs._standard)),
-            count(std::move(rhs.count)), index(std::move(rhs.index)),
+            _pure(std::move(rhs._pure)), _standard(std::move(rhs._standard)), _profiled(std::move(rhs._profiled)),
+            arena(std::move(rhs.arena)), count(std::move(rhs.count)), index(std::move(rhs.index)),
             entry(std::move(rhs.entry)), exit(std::move(rhs.exit)), 
             _use_registers(std::move(rhs._use_registers)), _use_float_registers(std::move(rhs._use_float_registers)),
             _variable_registers(std::move(rhs._variable_registers)), _variable_float_registers(std::move(rhs._variable_float_registers)),
@@ -37,6 +37,8 @@ mtac::Function::Function(mtac::Function&& rhs) :
     //Reset rhs
     rhs.count = 0;
     rhs.index = 0;
+    rhs.entry = nullptr;
+    rhs.exit = nullptr;
     rhs.last_pseudo_registers = 0;
     rhs.last_float_pseudo_registers = 0;
 }
@@ -47,6 +49,8 @@ mtac::Function& mtac::Function::operator=(mtac::Function&& rhs){
     statements = std::move(rhs.statements); 
     _pure = std::move(rhs._pure);
     _standard = std::move(rhs._standard);
+    _profiled = std::move(rhs._profiled);
+    arena = std::move(rhs.arena);
     count = std::move(rhs.count); 
     index = std::move(rhs.index);
     entry = std::move(rhs.entry); 
@@ -63,6 +67,8 @@ mtac::Function& mtac::Function::operator=(mtac::Function&& rhs){
     //Reset rhs
     rhs.count = 0;
     rhs.index = 0;
+    rhs.entry = nullptr;
+    rhs.exit = nullptr;
     rhs.last_pseudo_registers = 0;
     rhs.last_float_pseudo_registers = 0;
     
@@ -74,21 +80,7 @@ mtac::Function::~Function(){
 }
 
 void mtac::Function::clear_basic_blocks() {
-    auto block = exit;
-
-    while(block){
-        auto next = block->prev;
-
-        block->next = nullptr;
-        block->prev = nullptr;
-        block->successors.clear();
-        block->predecessors.clear();
-        block->dominator = nullptr;
-        block->statements.clear();
-        block->l_statements.clear();
-
-        block = next;
-    }
+    arena.clear();
 
     entry = nullptr;
     exit = nullptr;
@@ -114,6 +106,14 @@ bool mtac::Function::standard() const {
     return _standard;
 }
 
+bool& mtac::Function::profiled(){
+    return _profiled;
+}
+
+bool mtac::Function::profiled() const {
+    return _profiled;
+}
+
 mtac::Quadruple& mtac::Function::find(std::size_t uid){
     for(auto& block : *this){
         for(auto& quadruple : block){
@@ -126,7 +126,7 @@ mtac::Quadruple& mtac::Function::find(std::size_t uid){
     cpp_unreachable("The given uid does not exist");
 }
 
-mtac::basic_block_iterator mtac::Function::at(std::shared_ptr<basic_block> bb){
+mtac::basic_block_iterator mtac::Function::at(basic_block_p bb){
     if(bb){
         return basic_block_iterator(bb, bb->prev);
     } else {
@@ -149,7 +149,8 @@ mtac::basic_block_p mtac::Function::current_bb(){
 void mtac::Function::create_entry_bb(){
     ++count;
 
-    auto new_block = std::make_shared<mtac::basic_block>(-1);
+    auto new_block = &arena.emplace_back(-1);
+    new_block->id = arena.size() - 1;
     new_block->context = context;
 
     entry = exit = new_block;
@@ -158,7 +159,8 @@ void mtac::Function::create_entry_bb(){
 void mtac::Function::create_exit_bb(){
     ++count;
 
-    auto new_block = std::make_shared<mtac::basic_block>(-2);
+    auto new_block = &arena.emplace_back(-2);
+    new_block->id = arena.size() - 1;
     new_block->context = context;
     
     exit->next = new_block;
@@ -168,7 +170,8 @@ void mtac::Function::create_exit_bb(){
 }
 
 mtac::basic_block_p mtac::Function::new_bb(){
-    auto bb = std::make_shared<mtac::basic_block>(++index);
+    auto bb = &arena.emplace_back(++index);
+    bb->id = arena.size() - 1;
     bb->context = context;
     return bb;
 }
@@ -258,7 +261,7 @@ mtac::basic_block_iterator mtac::Function::remove(mtac::basic_block_iterator it)
     return remove(*it);
 }
 
-mtac::basic_block_iterator mtac::Function::merge_basic_blocks(basic_block_iterator it, std::shared_ptr<basic_block> block){
+mtac::basic_block_iterator mtac::Function::merge_basic_blocks(basic_block_iterator it, basic_block_p block){
     auto source = *it; 
 
     cpp_assert(source->next == block || source->prev == block, "Can only merge sibling blocks");
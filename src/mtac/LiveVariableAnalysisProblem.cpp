@@ -20,30 +20,45 @@ typedef mtac::LiveVariableAnalysisProblem::ProblemDomain ProblemDomain;
 ProblemDomain mtac::LiveVariableAnalysisProblem::Boundary(mtac::Function& function){
     pointer_escaped = mtac::escape_analysis(function);
 
+    numbering = mtac::variable_numbering(function);
+
+    for(auto& escaped_var : *pointer_escaped){
+        numbering.add(escaped_var);
+    }
+
+    //The escaped variables are used in every block
+    auto escaped = numbering.empty_set();
+    for(auto& escaped_var : *pointer_escaped){
+        escaped.set(numbering.index(escaped_var));
+    }
+
     for(auto& block : function){
+        auto& block_def = def[block] = numbering.empty_set();
+        auto& block_use = use[block] = escaped;
+
         for(auto& q : block){
-            if(mtac::erase_result(q.op)){
-                if(use[block].find(q.result) == use[block].end()){
-                    def[block].insert(q.result);
+            if(q.result){
+                auto result = numbering.index(q.result);
+
+                if(mtac::erase_result(q.op)){
+                    if(!block_use[result]){
+                        block_def.set(result);
+                    }
+                } else {
+                    block_use.set(result);
                 }
-            } else {
-                use[block].insert(q.result);
             }
 
-            if_init<std::shared_ptr<Variable>>(q.arg1, [this, &block](std::shared_ptr<Variable>& var){ use[block].insert(var); });
-            if_init<std::shared_ptr<Variable>>(q.arg2, [this, &block](std::shared_ptr<Variable>& var){ use[block].insert(var); });
-        }
-        
-        for(auto& escaped_var : *pointer_escaped){
-            use[block].insert(escaped_var);
+            if_init<variable_ref>(q.arg1, [this, &block_use](variable_ref var){ block_use.set(numbering.index(var)); });
+            if_init<variable_ref>(q.arg2, [this, &block_use](variable_ref var){ block_use.set(numbering.index(var)); });
         }
     }
 
-    return ProblemDomain(ProblemDomain::Values());
+    return ProblemDomain(numbering.empty_set());
 }
 
 ProblemDomain mtac::LiveVariableAnalysisProblem::Init(mtac::Function& /*function*/){
-    return ProblemDomain(ProblemDomain::Values());
+    return ProblemDomain(numbering.empty_set());
 }
 
 void mtac::LiveVariableAnalysisProblem::meet(ProblemDomain& out, const ProblemDomain& in){
@@ -55,64 +70,45 @@ void mtac::LiveVariableAnalysisProblem::meet(ProblemDomain& out, const ProblemDo
         return;
     }
 
-    for(auto& value : in.values()){
-        out.values().insert(value);
-    }
+    out.values() |= in.values();
 }
 
 void mtac::LiveVariableAnalysisProblem::transfer(const mtac::basic_block_p & B, ProblemDomain& x){
     auto& x_values = x.values();
 
-    //Compute x - def(B)
-
-    for(auto& v : def[B]){
-        x_values.erase(v);
-    }
-
     //Compute use(B) U (x - def(B))
-     
-    for(auto& v : use[B]){
-        x_values.insert(v);
-    }
+
+    x_values -= def[B];
+    x_values |= use[B];
 }
 
 void mtac::LiveVariableAnalysisProblem::transfer(const mtac::basic_block_p &/* basic_block*/, mtac::Quadruple& quadruple, ProblemDomain& in){
     if(in.top()){
-        ProblemDomain::Values values;
-        in.int_values = values;
+        in.int_values = numbering.empty_set();
     }
 
     if(quadruple.op != mtac::Operator::NOP){
-        if(mtac::erase_result(quadruple.op)){
-            in.values().erase(quadruple.result);
-        } else {
-            in.values().insert(quadruple.result);
+        auto& values = in.values();
+
+        if(quadruple.result){
+            values[numbering.index(quadruple.result)] = !mtac::erase_result(quadruple.op);
         }
 
-        if_init<std::shared_ptr<Variable>>(quadruple.arg1, [&in](std::shared_ptr<Variable>& var){in.values().insert(var);});
-        if_init<std::shared_ptr<Variable>>(quadruple.arg2, [&in](std::shared_ptr<Variable>& var){in.values().insert(var);});
+        if_init<variable_ref>(quadruple.arg1, [this, &values](variable_ref var){ values.set(numbering.index(var)); });
+        if_init<variable_ref>(quadruple.arg2, [this, &values](variable_ref var){ values.set(numbering.index(var)); });
     }
 }
 
+bool mtac::LiveVariableAnalysisProblem::live(const ProblemDomain& values, variable_ref variable) const {
+    return !values.top() && values.values()[numbering.index(variable)];
+}
+
 bool mtac::operator==(const mtac::Domain<mtac::Values>& lhs, const mtac::Domain<mtac::Values>& rhs){
     if(lhs.top() || rhs.top()){
         return lhs.top() == rhs.top();
     }
 
-    auto& lhs_values = lhs.values();
-    auto& rhs_values = rhs.values();
-
-    if(lhs_values.size() != rhs_values.size()){
-        return false;
-    }
-
-    for(auto& lhs_variable : lhs_values){
-        if(rhs_values.find(lhs_variable) == rhs_values.end()){
-            return false;
-        }
-    }
-
-    return true;
+    return lhs.values() == rhs.values();
 }
 
 bool mtac::operator!=(const mtac::Domain<Values>& lhs, const mtac::Domain<Values>& rhs){
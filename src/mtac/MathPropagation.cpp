@@ -22,15 +22,15 @@ void mtac::MathPropagation::clear(){
 
 void mtac::MathPropagation::operator()(mtac::Quadruple& quadruple){
     if(pass == mtac::Pass::DATA_MINING){
-        if_init<std::shared_ptr<Variable>>(quadruple.arg1, [this](auto& var){ ++usage[var]; });
-        if_init<std::shared_ptr<Variable>>(quadruple.arg2, [this](auto& var){ ++usage[var]; });
+        if_init<variable_ref>(quadruple.arg1, [this](auto& var){ ++usage[var]; });
+        if_init<variable_ref>(quadruple.arg2, [this](auto& var){ ++usage[var]; });
     } else if(!quadruple.is_if() && quadruple.is_if_false()){
         if(quadruple.result && quadruple.op != mtac::Operator::CALL){
             assigns.emplace(std::make_pair(quadruple.result, std::ref(quadruple)));
         }
 
         if(quadruple.op == mtac::Operator::ASSIGN){
-            if_type<std::shared_ptr<Variable>>(quadruple.arg1, [&quadruple, this](auto& var){
+            if_type<variable_ref>(quadruple.arg1, [&quadruple, this](auto& var){
                 //We only duplicate the math operation if the variable is used once to not add overhead
                 if(!quadruple.result->type()->is_array() && var->type() != STRING && usage[var] == 1 && assigns.find(var) != assigns.end()){
                     auto& assign = assigns.at(var).get();
@@ -5,13 +5,16 @@
 //  http://opensource.org/licenses/MIT)
 //=======================================================================
 
+#include <algorithm>
 #include <memory>
-#include <thread>
 #include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 #include "boost_cfg.hpp"
 #include <boost/mpl/vector.hpp>
 #include <boost/mpl/for_each.hpp>
+#include <boost/mpl/size.hpp>
 
 #include "cpp_utils/assert.hpp"
 #include "cpp_utils/tmp.hpp"
@@ -22,6 +25,7 @@
 #include "logging.hpp"
 #include "timing.hpp"
 #include "GlobalContext.hpp"
+#include "parallel.hpp"
 
 #include "mtac/pass_traits.hpp"
 #include "mtac/Utils.hpp"
@@ -30,6 +34,7 @@
 #include "mtac/Program.hpp"
 #include "mtac/ControlFlowGraph.hpp"
 #include "mtac/Quadruple.hpp"
+#include "mtac/fingerprint.hpp"
 
 //The custom optimizations
 #include "mtac/conditional_propagation.hpp"
@@ -184,6 +189,13 @@ struct pass_runner {
     Platform platform;
     timing_system& system;
 
+    //Number of workers used to run the sub passes of IPA_SUB passes
+    std::size_t threads = 1;
+
+    //For each IPA_SUB pass, the fingerprints of the functions its sub passes did not modify the last time they ran
+    typedef std::unordered_map<std::string, mtac::function_fingerprint> fingerprints_map;
+    std::shared_ptr<std::unordered_map<std::string, fingerprints_map>> clean_functions = std::make_shared<std::unordered_map<std::string, fingerprints_map>>();
+
     pass_runner(mtac::Program& program, std::shared_ptr<StringPool> pool, std::shared_ptr<Configuration> configuration, Platform platform, timing_system& system) :
             program(program), pool(pool), configuration(configuration), platform(platform), system(system) {};
 
@@ -249,18 +261,72 @@ struct pass_runner {
         if constexpr (type == mtac::pass_type::IPA) {
             return pass(program);
         } else if constexpr (type == mtac::pass_type::IPA_SUB) {
-            for (auto & function : program.functions) {
-                this->function = &function;
+            //The sub passes modify the function they are run on and, in the shared call graph, only the
+            //counts of the edges going out of it (loop unrolling, peeling and dead blocks removal). These
+            //edges are found with call_graph::edge() that never inserts into the graph, so the functions
+            //can be optimized in parallel, each with its own runner
+            auto n = program.functions.size();
+
+            std::vector<char> optimized_functions(n, false);
+            std::vector<char> skipped_functions(n, false);
+            std::vector<mtac::function_fingerprint> fingerprints(n);
+
+            auto purity = mtac::summarize_purity(program);
+            auto& clean = (*clean_functions)[mtac::pass_traits<Pass>::name()];
+
+            parallel_for(n, threads, [&](std::size_t i){
+                auto& function = program.functions[i];
+
+                //If neither the function nor the functions it calls changed since the sub passes found
+                //nothing to optimize in it, they would not find anything this time either
+                fingerprints[i] = mtac::fingerprint(function, purity);
+
+                auto it = clean.find(function.get_name());
+                if(it != clean.end() && it->second == fingerprints[i]){
+                    skipped_functions[i] = true;
+                    return;
+                }
+
+                trace_timer timer(system, "optimize_function", function.get_name());
+
+                pass_runner runner(*this);
+                runner.optimized = false;
+                runner.function = &function;
 
                 if (log::enabled<Debug>()) {
-                    LOG<Debug>("Optimizer") << "Start optimizations on " << function.get_name() << log::endl;
+                    LOG<Debug>("Optimizer") << "Start optimizations on " << runner.function->get_name() << log::endl;
+
+                    std::cout << *runner.function << std::endl;
+                }
+
+                boost::mpl::for_each<typename mtac::pass_traits<Pass>::sub_passes>(boost::ref(runner));
+
+                optimized_functions[i] = runner.optimized;
+            });
+
+            std::size_t skipped = 0;
 
-                    std::cout << function << std::endl;
+            for(std::size_t i = 0; i < n; ++i){
+                auto& function = program.functions[i];
+
+                if(skipped_functions[i]){
+                    ++skipped;
+                } else if(optimized_functions[i]){
+                    clean.erase(function.get_name());
+                } else {
+                    clean[function.get_name()] = std::move(fingerprints[i]);
                 }
+            }
 
-                boost::mpl::for_each<typename mtac::pass_traits<Pass>::sub_passes>(boost::ref(*this));
+            if(skipped){
+                constexpr std::size_t sub_passes = boost::mpl::size<typename mtac::pass_traits<Pass>::sub_passes>::value;
+
+                program.context.stats().inc_counter("skipped_functions", skipped);
+                program.context.stats().inc_counter("skipped_passes", skipped * sub_passes);
             }
 
+            optimized |= std::find(optimized_functions.begin(), optimized_functions.end(), true) != optimized_functions.end();
+
             return false;
         } else if constexpr (type == mtac::pass_type::CUSTOM) {
             return pass(*function);
@@ -339,7 +405,8 @@ struct pass_runner {
         auto pass = make_pass<Pass>();
 
         if(has_to_be_run(pass)){
-            timing_timer timer(system, mtac::pass_traits<Pass>::name());
+            //In the trace, the intra-procedural passes are attributed to their function
+            timing_timer timer(system, mtac::pass_traits<Pass>::name(), function && system.tracing() ? function->get_name() : std::string());
 
             bool local = apply<Pass>(pass);
             if(local){
@@ -365,16 +432,31 @@ void mtac::Optimizer::optimize(mtac::Program& program, std::shared_ptr<StringPoo
         mtac::build_control_flow_graph(function);
     }
 
+    //The IPA passes act as barriers between the parallel intra-procedural passes.
+    //The debug output is only readable if the functions are optimized in order
+    std::size_t threads = 1;
+    if(!configuration->option_defined("single-threaded") && !log::enabled<Debug>()){
+        threads = hardware_threads();
+    }
+
     if(configuration->option_defined("fglobal-optimization")){
         //Apply Interprocedural Optimizations
         pass_runner runner(program, string_pool, configuration, platform, program.context.timing());
+        runner.threads = threads;
+
+        std::size_t iteration = 0;
+
         do{
+            trace_timer timer(program.context.timing(), "optimization_iteration", std::to_string(++iteration));
+            program.context.stats().inc_counter("optimization_iterations");
+
             runner.optimized = false;
             boost::mpl::for_each<ipa_passes>(boost::ref(runner));
         } while(runner.optimized);
     } else {
         //Even if global optimizations are disabled, perform basic optimization (only constant folding)
         pass_runner runner(program, string_pool, configuration, platform, program.context.timing());
+        runner.threads = threads;
         boost::mpl::for_each<ipa_basic_passes>(boost::ref(runner));
     }
 }
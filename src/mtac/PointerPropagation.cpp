@@ -17,8 +17,8 @@ using namespace eddic;
 
 namespace {
 
-bool optimize_dot(mtac::Quadruple& quadruple, mtac::Operator op, std::unordered_map<std::shared_ptr<Variable>, std::shared_ptr<Variable>>& aliases){
-    if(auto* ptr = boost::get<std::shared_ptr<Variable>>(&*quadruple.arg1)){
+bool optimize_dot(mtac::Quadruple& quadruple, mtac::Operator op, std::unordered_map<variable_ref, variable_ref>& aliases){
+    if(auto* ptr = boost::get<variable_ref>(&*quadruple.arg1)){
         auto variable = *ptr;
 
         if(aliases.count(variable)){
@@ -42,7 +42,7 @@ bool optimize_dot(mtac::Quadruple& quadruple, mtac::Operator op, std::unordered_
     return false;
 }
 
-bool optimize_dot_assign(mtac::Quadruple& quadruple, mtac::Operator op, std::unordered_map<std::shared_ptr<Variable>, std::shared_ptr<Variable>>& aliases){
+bool optimize_dot_assign(mtac::Quadruple& quadruple, mtac::Operator op, std::unordered_map<variable_ref, variable_ref>& aliases){
     auto variable = quadruple.result;
 
     if(aliases.count(variable)){
@@ -67,14 +67,14 @@ bool optimize_dot_assign(mtac::Quadruple& quadruple, mtac::Operator op, std::uno
 }
 
 struct CopyApplier {
-    std::unordered_map<std::shared_ptr<Variable>, std::shared_ptr<Variable>>& pointer_copies;
+    std::unordered_map<variable_ref, variable_ref>& pointer_copies;
     bool changes = false;
 
-    CopyApplier(std::unordered_map<std::shared_ptr<Variable>, std::shared_ptr<Variable>>& pointer_copies) : pointer_copies(pointer_copies) {}
+    CopyApplier(std::unordered_map<variable_ref, variable_ref>& pointer_copies) : pointer_copies(pointer_copies) {}
 
     bool optimize_optional(boost::optional<mtac::Argument>& arg){
         if(arg){
-            if(auto* ptr = boost::get<std::shared_ptr<Variable>>(&*arg)){
+            if(auto* ptr = boost::get<variable_ref>(&*arg)){
                 if(pointer_copies.count(*ptr)){
                     arg = pointer_copies[*ptr];
                     return true;
@@ -111,7 +111,7 @@ void mtac::PointerPropagation::operator()(mtac::Quadruple& quadruple){
     }
 
     if(quadruple.op == mtac::Operator::PASSIGN){
-        if(auto* ptr = boost::get<std::shared_ptr<Variable>>(&*quadruple.arg1)){
+        if(auto* ptr = boost::get<variable_ref>(&*quadruple.arg1)){
             if(!(*ptr)->type()->is_pointer()){
                 aliases[quadruple.result] = *ptr;
             } else if((*ptr)->type()->is_pointer()){
@@ -124,7 +124,7 @@ void mtac::PointerPropagation::operator()(mtac::Quadruple& quadruple){
             }
         }
         
-        if(auto* ptr = boost::get<std::shared_ptr<Variable>>(&*quadruple.arg1)){
+        if(auto* ptr = boost::get<variable_ref>(&*quadruple.arg1)){
             if((*ptr)->type()->is_pointer() && quadruple.result->type()->is_pointer()){
                 pointer_copies[quadruple.result] = *ptr;    
             }
@@ -26,13 +26,13 @@ mtac::Quadruple::Quadruple(mtac::Operator o, tac::Size size) :
     //Nothing to init    
 }
 
-mtac::Quadruple::Quadruple(std::shared_ptr<Variable> result, mtac::Argument a1, mtac::Operator o, tac::Size size) : 
-        _uid(++uid_counter), result(result), arg1(std::move(a1)), op(o), size(size) {
+mtac::Quadruple::Quadruple(variable_ref result, mtac::Argument a1, mtac::Operator o, tac::Size size) : 
+        _uid(++uid_counter), result(std::move(result)), arg1(std::move(a1)), op(o), size(size) {
     //Nothing to init    
 }
 
-mtac::Quadruple::Quadruple(std::shared_ptr<Variable> result, mtac::Argument a1, mtac::Operator o, mtac::Argument a2, tac::Size size) : 
-        _uid(++uid_counter), result(result), arg1(std::move(a1)), arg2(std::move(a2)), op(o), size(size) {
+mtac::Quadruple::Quadruple(variable_ref result, mtac::Argument a1, mtac::Operator o, mtac::Argument a2, tac::Size size) : 
+        _uid(++uid_counter), result(std::move(result)), arg1(std::move(a1)), arg2(std::move(a2)), op(o), size(size) {
     //Nothing to init    
 }
 
@@ -47,27 +47,27 @@ mtac::Quadruple::Quadruple(mtac::Operator o, mtac::Argument a1, mtac::Argument a
 }
     
 mtac::Quadruple::Quadruple(std::string param, mtac::Operator op, tac::Size size) : 
-        _uid(++uid_counter), op(op), size(size), m_param(std::move(param)) {
+        _uid(++uid_counter), op(op), size(size), m_param(param) {
     //Nothing to init
 }
 
-mtac::Quadruple::Quadruple(mtac::Operator op, mtac::Argument arg, std::shared_ptr<Variable> param, eddic::Function& function, tac::Size size) : 
-        _uid(++uid_counter), result(param), arg1(std::move(arg)), op(op), size(size), m_function(&function) {
+mtac::Quadruple::Quadruple(mtac::Operator op, mtac::Argument arg, variable_ref param, eddic::Function& function, tac::Size size) : 
+        _uid(++uid_counter), result(std::move(param)), arg1(std::move(arg)), op(op), size(size), m_function(&function) {
     //Nothing to init
 }
 
 mtac::Quadruple::Quadruple(mtac::Operator op, mtac::Argument arg, std::string param, eddic::Function& function, tac::Size size) : 
-        _uid(++uid_counter), arg1(std::move(arg)), op(op), size(size), m_function(&function), m_param(std::move(param)) {
+        _uid(++uid_counter), arg1(std::move(arg)), op(op), size(size), m_function(&function), m_param(param) {
     //Nothing to init
 }
 
-mtac::Quadruple::Quadruple(mtac::Operator op, eddic::Function& function, std::shared_ptr<Variable> return1, std::shared_ptr<Variable> return2, tac::Size size) : 
-        _uid(++uid_counter), result(return1), op(op), size(size), secondary(return2), m_function(&function) {
+mtac::Quadruple::Quadruple(mtac::Operator op, eddic::Function& function, variable_ref return1, variable_ref return2, tac::Size size) : 
+        _uid(++uid_counter), result(std::move(return1)), op(op), size(size), secondary(std::move(return2)), m_function(&function) {
     cpp_assert(m_function, "Function is mandatory for calls");
 }
 
 mtac::Quadruple::Quadruple(mtac::Operator op, mtac::Argument arg, std::string label, tac::Size size) : 
-        _uid(++uid_counter), arg1(std::move(arg)), op(op), size(size), m_param(std::move(label)) {
+        _uid(++uid_counter), arg1(std::move(arg)), op(op), size(size), m_param(label) {
     //Nothing to init
 }
 
@@ -144,11 +144,11 @@ mtac::Quadruple& mtac::Quadruple::operator=(mtac::Quadruple&& rhs) noexcept {
 }
 
 const std::string& mtac::Quadruple::label() const {
-    return m_param;
+    return m_param.str();
 }
 
 const std::string& mtac::Quadruple::std_param() const {
-    return m_param;
+    return m_param.str();
 }
 
 eddic::Function& mtac::Quadruple::function(){
@@ -163,15 +163,15 @@ const eddic::Function& mtac::Quadruple::function() const {
     return *m_function;
 }
 
-const std::shared_ptr<Variable>& mtac::Quadruple::param() const {
+variable_ref mtac::Quadruple::param() const {
     return result;
 }
 
-const std::shared_ptr<Variable>& mtac::Quadruple::return1() const {
+variable_ref mtac::Quadruple::return1() const {
     return result;
 }
 
-const std::shared_ptr<Variable>& mtac::Quadruple::return2() const {
+variable_ref mtac::Quadruple::return2() const {
     return secondary;
 }
 
@@ -231,7 +231,7 @@ void mtac::transform_to_nop(mtac::Quadruple& quadruple){
     quadruple.secondary = nullptr;
     quadruple.block = nullptr;
     quadruple.m_function = nullptr;
-    quadruple.m_param.clear();
+    quadruple.m_param = interned_string();
 }
 
 std::ostream& eddic::mtac::operator<<(std::ostream& stream, const mtac::Quadruple& quadruple){
@@ -365,6 +365,10 @@ std::ostream& eddic::mtac::operator<<(std::ostream& stream, const mtac::Quadrupl
         case mtac::Operator::PARAM:
             if(quadruple.param()){
                 stream << "\t" << "param " << size(quadruple.size) << "(" << quadruple.param() << ") " << *quadruple.arg1;
+
+                if(quadruple.arg2){
+                    stream << " padding " << *quadruple.arg2;
+                }
             } else {
                 if(quadruple.std_param().length() > 0){
                     stream << "\t" << "param " << size(quadruple.size) << "(std::" << quadruple.std_param() << ") " << *quadruple.arg1;
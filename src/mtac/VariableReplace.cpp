@@ -14,7 +14,7 @@
 using namespace eddic;
 
 void mtac::VariableReplace::update_usage(mtac::Argument& value){
-    if(auto* ptr = boost::get<std::shared_ptr<Variable>>(&value)){
+    if(auto* ptr = boost::get<variable_ref>(&value)){
         if(clones.find(*ptr) != clones.end()){
             value = clones[*ptr];
         }
@@ -30,12 +30,12 @@ void mtac::VariableReplace::update_usage_optional(boost::optional<mtac::Argument
 void mtac::VariableReplace::replace(mtac::Quadruple& quadruple){
     if(clones.find(quadruple.result) != clones.end()){
         cpp_assert(mtac::isVariable(clones[quadruple.result]), "The result cannot be replaced by other thing than a variable");
-        quadruple.result = boost::get<std::shared_ptr<Variable>>(clones[quadruple.result]);
+        quadruple.result = boost::get<variable_ref>(clones[quadruple.result]);
     }
 
     if(quadruple.secondary && clones.find(quadruple.secondary) != clones.end()){
         cpp_assert(mtac::isVariable(clones[quadruple.secondary]), "The return variable cannot be replaced by other thing than a variable");
-        quadruple.secondary = boost::get<std::shared_ptr<Variable>>(clones[quadruple.secondary]);
+        quadruple.secondary = boost::get<variable_ref>(clones[quadruple.secondary]);
     }
 
     update_usage_optional(quadruple.arg1);
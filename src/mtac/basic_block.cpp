@@ -39,7 +39,7 @@ std::size_t mtac::basic_block::size_no_nop() const {
     return size;
 }
 
-std::ostream& mtac::operator<<(std::ostream& stream, const std::shared_ptr<basic_block>& basic_block){
+std::ostream& mtac::operator<<(std::ostream& stream, const basic_block_p& basic_block){
     if(basic_block){
         return stream << *basic_block;
     } else {
@@ -65,7 +65,7 @@ mtac::basic_block::iterator mtac::end(mtac::basic_block_p block){
     return block->end(); 
 }
     
-void pretty_print(std::vector<mtac::basic_block_p> blocks, std::ostream& stream){
+void pretty_print(const mtac::basic_block::edges& blocks, std::ostream& stream){
     if(blocks.empty()){
         stream << "{}";
     } else {
@@ -85,6 +85,7 @@ mtac::basic_block_p mtac::clone(mtac::Function& function, mtac::basic_block_p bl
     //Copy the control flow graph properties, they will be corrected after
     new_bb->successors = block->successors;
     new_bb->predecessors = block->predecessors;
+    new_bb->frequency = block->frequency;
 
     //Copy all the statements
     new_bb->statements = block->statements;
@@ -92,7 +93,7 @@ mtac::basic_block_p mtac::clone(mtac::Function& function, mtac::basic_block_p bl
     return new_bb;
 }
 
-void mtac::pretty_print(std::shared_ptr<const mtac::basic_block> block, std::ostream& stream){
+void mtac::pretty_print(mtac::basic_block_cp block, std::ostream& stream){
     std::string sep(25, '-');
 
     stream << sep << std::endl;
@@ -47,12 +47,15 @@ mtac::call_graph_node_p mtac::call_graph::node(eddic::Function& function){
     return it->second;
 }
 
-mtac::call_graph_edge_p mtac::call_graph::edge(eddic::Function& source, eddic::Function& target){
-    auto source_node = node(source);
-    auto target_node = node(target);
+mtac::call_graph_edge_p mtac::call_graph::edge(eddic::Function& source, eddic::Function& target) const {
+    auto source_it = nodes.find(source.mangled_name());
+    auto target_it = nodes.find(target.mangled_name());
 
-    for(auto& edge : source_node->out_edges){
-        if(edge->target == target_node){
+    cpp_assert(source_it != nodes.end(), "The source function must be in the call graph");
+    cpp_assert(target_it != nodes.end(), "The target function must be in the call graph");
+
+    for(auto& edge : source_it->second->out_edges){
+        if(edge->target == target_it->second){
             return edge;
         }
     }
@@ -60,13 +63,13 @@ mtac::call_graph_edge_p mtac::call_graph::edge(eddic::Function& source, eddic::F
     return nullptr;
 }
 
-void mtac::call_graph::add_edge(eddic::Function& source, eddic::Function& target){
+mtac::call_graph_edge_p mtac::call_graph::add_edge(eddic::Function& source, eddic::Function& target){
+    auto source_node = node(source);
+    auto target_node = node(target);
+
     auto edge = this->edge(source, target);
 
     if(!edge){
-        auto source_node = node(source);
-        auto target_node = node(target);
-
         edge = std::make_shared<mtac::call_graph_edge>(source_node, target_node);
 
         source_node->out_edges.push_back(edge);
@@ -74,6 +77,8 @@ void mtac::call_graph::add_edge(eddic::Function& source, eddic::Function& target
     }
 
     ++edge->count;
+
+    return edge;
 }
 
 void compute_reachable(mtac::Reachable& reachable, mtac::call_graph_node_p node){
@@ -118,7 +123,7 @@ void mtac::build_call_graph(mtac::Program& program){
         for(auto& block : function){
             for(auto& quadruple : block){
                 if(quadruple.op == mtac::Operator::CALL){
-                    cg.add_edge(function.definition(), quadruple.function());
+                    cg.add_edge(function.definition(), quadruple.function())->frequency += block->frequency;
                 }
             }
         }
@@ -49,7 +49,7 @@ void peel(mtac::loop& loop, mtac::Function& function, mtac::Program& program){
     auto real_entry = loop.find_entry();
     auto entry = real_entry;
 
-    mtac::basic_block_p next_bb;
+    mtac::basic_block_p next_bb = nullptr;
     for(auto& succ : exit->successors){
         if(loop.blocks().find(succ) == loop.blocks().end()){
             next_bb = succ;
@@ -103,7 +103,7 @@ mtac::Operator to_binary_operator(mtac::Operator op){
 template<bool If, typename Branch>
 bool optimize_branch(Branch& branch, mtac::basic_block_p basic_block, mtac::VariableUsage variable_usage){
     if(mtac::isVariable(*branch.arg1)){
-        auto variable = boost::get<std::shared_ptr<Variable>>(*branch.arg1);
+        auto variable = boost::get<variable_ref>(*branch.arg1);
 
         if(variable_usage[variable] == 2){
             auto& declaration = get_variable_declaration(basic_block, variable);
@@ -27,11 +27,11 @@ bool mtac::are_equivalent(mtac::Quadruple& quadruple, const expression& exp){
 }
 
 bool mtac::is_interesting(mtac::Quadruple& quadruple){
-    if(boost::get<std::shared_ptr<Variable>>(&*quadruple.arg1)){
+    if(boost::get<variable_ref>(&*quadruple.arg1)){
         return true;
     }
     
-    if(boost::get<std::shared_ptr<Variable>>(&*quadruple.arg2)){
+    if(boost::get<variable_ref>(&*quadruple.arg2)){
         return true;
     }
 
@@ -40,20 +40,20 @@ bool mtac::is_interesting(mtac::Quadruple& quadruple){
 
 bool mtac::is_valid(mtac::Quadruple& quadruple, const mtac::escaped_variables& escaped){
     if(quadruple.op == mtac::Operator::DOT){
-        if(auto* ptr = boost::get<std::shared_ptr<Variable>>(&*quadruple.arg1)){
+        if(auto* ptr = boost::get<variable_ref>(&*quadruple.arg1)){
             if((*ptr)->type()->is_pointer()){
                 return false;
             }
         }
     }
     
-    if(auto* ptr = boost::get<std::shared_ptr<Variable>>(&*quadruple.arg1)){
+    if(auto* ptr = boost::get<variable_ref>(&*quadruple.arg1)){
         if(escaped.find(*ptr) != escaped.end()){
             return false;
         }
     }
     
-    if(auto* ptr = boost::get<std::shared_ptr<Variable>>(&*quadruple.arg2)){
+    if(auto* ptr = boost::get<variable_ref>(&*quadruple.arg2)){
         if(escaped.find(*ptr) != escaped.end()){
             return false;
         }
@@ -73,13 +73,13 @@ bool mtac::is_expression(mtac::Operator op){
 bool mtac::is_killing(mtac::Quadruple& quadruple, const mtac::expression& expression){
     cpp_assert(quadruple.result, "is_killing should only be called on quadruple erasing the result, thus having a result");
 
-    if(auto* ptr = boost::get<std::shared_ptr<Variable>>(&expression.arg1)){
+    if(auto* ptr = boost::get<variable_ref>(&expression.arg1)){
         if(quadruple.result == *ptr){
             return true;
         }
     }
 
-    if(auto* ptr = boost::get<std::shared_ptr<Variable>>(&expression.arg2)){
+    if(auto* ptr = boost::get<variable_ref>(&expression.arg2)){
         if(quadruple.result == *ptr){
             return true;
         }
@@ -0,0 +1,108 @@
+//=======================================================================
+// Copyright Baptiste Wicht 2011-2016.
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#include <algorithm>
+
+#include "GlobalContext.hpp"
+#include "FunctionContext.hpp"
+
+#include "mtac/data_flow_worklist.hpp"
+#include "mtac/Function.hpp"
+
+using namespace eddic;
+
+std::vector<mtac::basic_block_p> mtac::post_order(mtac::Function& function){
+    std::vector<mtac::basic_block_p> order;
+    std::vector<char> visited(function.bb_ids(), false);
+
+    //Iterative depth-first search to support very large functions
+    std::vector<std::pair<mtac::basic_block_p, std::size_t>> stack;
+
+    auto entry = function.entry_bb();
+    visited[entry->id] = true;
+    stack.emplace_back(entry, 0);
+
+    while(!stack.empty()){
+        auto& top = stack.back();
+        auto& successors = top.first->successors;
+
+        if(top.second < successors.size()){
+            auto& successor = successors[top.second++];
+
+            if(!visited[successor->id]){
+                visited[successor->id] = true;
+                stack.emplace_back(successor, 0);
+            }
+        } else {
+            order.push_back(top.first);
+            stack.pop_back();
+        }
+    }
+
+    return order;
+}
+
+mtac::data_flow_worklist::data_flow_worklist(mtac::Function& function, bool forward){
+    order = post_order(function);
+    position = mtac::block_map<std::size_t>(function.bb_ids());
+
+    if(forward){
+        std::reverse(order.begin(), order.end());
+    }
+
+    for(std::size_t i = 0; i < order.size(); ++i){
+        position[order[i]] = i;
+    }
+
+    //The blocks that are not reachable from ENTRY are visited last
+    for(auto& block : function){
+        if(!position.contains(block)){
+            position[block] = order.size();
+            order.push_back(block);
+        }
+    }
+
+    queued.resize(order.size(), false);
+
+    auto boundary = forward ? -1 : -2;
+
+    for(auto& block : order){
+        if(block->index != boundary){
+            push(block);
+        }
+    }
+}
+
+bool mtac::data_flow_worklist::empty() const {
+    return queue.empty();
+}
+
+mtac::basic_block_p mtac::data_flow_worklist::pop(){
+    auto index = queue.top();
+    queue.pop();
+
+    queued[index] = false;
+    ++iterations;
+
+    return order[index];
+}
+
+void mtac::data_flow_worklist::push(const mtac::basic_block_p& block){
+    auto index = position[block];
+
+    if(!queued[index]){
+        queued[index] = true;
+        queue.push(index);
+    }
+}
+
+void mtac::data_flow_worklist::report(mtac::Function& function) const {
+    auto& stats = function.context->global().stats();
+
+    stats.inc_counter("data_flow_problems");
+    stats.inc_counter("data_flow_iterations", iterations);
+}
@@ -0,0 +1,113 @@
+//=======================================================================
+// Copyright Baptiste Wicht 2011-2016.
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#include <boost/functional/hash.hpp>
+
+#include "mtac/fingerprint.hpp"
+#include "mtac/Program.hpp"
+#include "mtac/Function.hpp"
+#include "mtac/Quadruple.hpp"
+
+#include "Variable.hpp"
+
+using namespace eddic;
+
+mtac::purity_summary mtac::summarize_purity(mtac::Program& program){
+    purity_summary purity;
+
+    for(auto& function : program.functions){
+        purity[&function.definition()] = function.pure();
+    }
+
+    return purity;
+}
+
+namespace {
+
+struct fingerprint_builder {
+    mtac::function_fingerprint& fingerprint;
+
+    void add(std::size_t value){
+        fingerprint.structure.push_back(value);
+    }
+
+    //The variables are identified by their id, their position type is kept since a variable can change
+    //of position between two rounds (a global becoming const for instance)
+    void add(variable_ref variable){
+        add(variable.id());
+
+        if(variable){
+            add(static_cast<std::size_t>(variable->position().type()));
+        }
+    }
+
+    void add(const boost::optional<mtac::Argument>& argument){
+        add(static_cast<std::size_t>(argument ? 1 : 0));
+
+        if(argument){
+            fingerprint.arguments.push_back(*argument);
+
+            if(auto* ptr = boost::get<variable_ref>(&*argument)){
+                add(*ptr);
+            }
+        }
+    }
+};
+
+} //end of anonymous namespace
+
+bool mtac::function_fingerprint::operator==(const function_fingerprint& rhs) const {
+    return hash == rhs.hash && structure == rhs.structure && arguments == rhs.arguments;
+}
+
+mtac::function_fingerprint mtac::fingerprint(mtac::Function& function, const purity_summary& purity){
+    function_fingerprint fingerprint;
+    fingerprint_builder builder{fingerprint};
+
+    builder.add(static_cast<std::size_t>(function.pure()));
+
+    for(auto& block : function){
+        builder.add(static_cast<std::size_t>(block->index));
+        builder.add(block->successors.size());
+
+        for(auto& successor : block->successors){
+            builder.add(static_cast<std::size_t>(successor->index));
+        }
+
+        builder.add(block->statements.size());
+
+        for(auto& quadruple : block->statements){
+            builder.add(static_cast<std::size_t>(quadruple.op));
+            builder.add(static_cast<std::size_t>(quadruple.size));
+            builder.add(quadruple.result);
+            builder.add(quadruple.secondary);
+            builder.add(quadruple.arg1);
+            builder.add(quadruple.arg2);
+
+            fingerprint.arguments.push_back(quadruple.m_param);
+
+            builder.add(static_cast<std::size_t>(quadruple.block ? 1 : 0));
+
+            if(quadruple.block){
+                builder.add(static_cast<std::size_t>(quadruple.block->index));
+            }
+
+            //The optimizations of a call depend on the purity of the called function
+            builder.add(reinterpret_cast<std::size_t>(quadruple.m_function));
+
+            if(quadruple.m_function){
+                auto it = purity.find(quadruple.m_function);
+                builder.add(static_cast<std::size_t>(it != purity.end() ? 1 + it->second : 0));
+            }
+        }
+    }
+
+    fingerprint.hash = boost::hash_range(fingerprint.structure.begin(), fingerprint.structure.end());
+    boost::hash_combine(fingerprint.hash, boost::hash_range(fingerprint.arguments.begin(), fingerprint.arguments.end()));
+
+    return fingerprint;
+}
@@ -23,15 +23,15 @@ namespace {
 
 struct ConstantCollector : public boost::static_visitor<> {
     ProblemDomain& out;
-    std::shared_ptr<Variable>& var;
+    variable_ref var;
 
-    ConstantCollector(ProblemDomain& out, std::shared_ptr<Variable>& var) : out(out), var(var) {}
+    ConstantCollector(ProblemDomain& out, variable_ref var) : out(out), var(var) {}
 
     void operator()(int value){
         out[var] = {value};
     }
 
-    void operator()(const std::string& value){
+    void operator()(const interned_string& value){
         out[var] = {value};
     }
 
@@ -39,7 +39,7 @@ struct ConstantCollector : public boost::static_visitor<> {
         out[var] = {value};
     }
 
-    void operator()(std::shared_ptr<Variable>& variable){
+    void operator()(variable_ref variable){
         if(variable != var){
             out[var] = {variable};
         }
@@ -54,7 +54,7 @@ struct ConstantOptimizer {
     ConstantOptimizer(mtac::Domain<mtac::ConstantPropagationValues>& results, const mtac::escaped_variables& pointer_escaped) : results(results), pointer_escaped(pointer_escaped) {}
 
     bool optimize_arg(mtac::Argument& arg){
-        if(auto* ptr = boost::get<std::shared_ptr<Variable>>(&arg)){
+        if(auto* ptr = boost::get<variable_ref>(&arg)){
             if(results.count(*ptr) && !pointer_escaped.count(*ptr)){
                 if(results[*ptr].constant()){
                     arg = results[*ptr].value();
@@ -85,12 +85,12 @@ struct ConstantOptimizer {
 
         //If the constant is a string, we can use it in the dot operator
         if(quadruple.op == mtac::Operator::DOT){
-            if(auto* ptr = boost::get<std::shared_ptr<Variable>>(&*quadruple.arg1)){
+            if(auto* ptr = boost::get<variable_ref>(&*quadruple.arg1)){
                 if((*ptr)->type() != STRING && results.count(*ptr) && !pointer_escaped.count(*ptr)){
                     if(results[*ptr].constant()){
                         auto arg = results[*ptr].value();
 
-                        if(auto* label_ptr = boost::get<std::string>(&arg)){
+                        if(auto* label_ptr = boost::get<interned_string>(&arg)){
                             quadruple.arg1 = *label_ptr;
 
                             changes = true;
@@ -107,12 +107,13 @@ struct ConstantOptimizer {
             changes |= optimize_optional(quadruple.arg2);
         }
 
-        if(!mtac::erase_result(quadruple.op) && quadruple.result && quadruple.op != mtac::Operator::DOT_ASSIGN){
+        //The result of a call is the variable returned, it is not used
+        if(!mtac::erase_result(quadruple.op) && quadruple.result && quadruple.op != mtac::Operator::DOT_ASSIGN && quadruple.op != mtac::Operator::CALL){
             if(results.find(quadruple.result) != results.end()){
                 if(results[quadruple.result].constant()){
                     auto lattice_value = results[quadruple.result].value();
                     if(mtac::isVariable(lattice_value)){
-                        quadruple.result = boost::get<std::shared_ptr<Variable>>(lattice_value);
+                        quadruple.result = boost::get<variable_ref>(lattice_value);
                     }
                 }
             }
@@ -200,6 +201,24 @@ void mtac::ConstantPropagationProblem::meet(ProblemDomain& in, const ProblemDoma
     }
 }
 
+//Cancel the copies of the variable erased
+void cancel_copies(ProblemDomain& out, variable_ref erased){
+    for(auto it = std::begin(out.values()); it != std::end(out.values()); ++it){
+        auto& lattice = it->second;
+
+        if(lattice.constant()){
+            auto lattice_value = lattice.value();
+            if(auto* ptr = boost::get<variable_ref>(&lattice_value)){
+                auto variable = *ptr;
+
+                if (variable == erased){
+                    lattice.set_nac();
+                } 
+            }
+        } 
+    }
+}
+
 int compute(mtac::Operator op, int lhs, int rhs){
     switch(op){
         case mtac::Operator::ADD:
@@ -239,7 +258,7 @@ void mtac::ConstantPropagationProblem::transfer(const mtac::basic_block_p &, mta
         return;
     }
     
-    std::shared_ptr<Variable> remove_copies;
+    variable_ref remove_copies;
 
     if(op == mtac::Operator::ASSIGN || op == mtac::Operator::FASSIGN){
         ConstantCollector collector(out, quadruple.result);
@@ -247,9 +266,9 @@ void mtac::ConstantPropagationProblem::transfer(const mtac::basic_block_p &, mta
 
         remove_copies = quadruple.result;
     } else if(op >= mtac::Operator::ADD && op <= mtac::Operator::MOD){
-        if(auto* lhs = boost::get<std::shared_ptr<Variable>>(&*quadruple.arg1)){
+        if(auto* lhs = boost::get<variable_ref>(&*quadruple.arg1)){
             if(out[*lhs].constant() && boost::get<int>(&out[*lhs].value())){
-                if(auto* rhs = boost::get<std::shared_ptr<Variable>>(&*quadruple.arg2)){
+                if(auto* rhs = boost::get<variable_ref>(&*quadruple.arg2)){
                     if(out[*rhs].constant() && boost::get<int>(&out[*rhs].value())){
                         out[quadruple.result] = {compute(op, boost::get<int>(out[*lhs].value()), boost::get<int>(out[*rhs].value()))};
                     } else {
@@ -263,7 +282,7 @@ void mtac::ConstantPropagationProblem::transfer(const mtac::basic_block_p &, mta
             } else {
                 out[quadruple.result].set_nac();
             }
-        } else if(auto* rhs = boost::get<std::shared_ptr<Variable>>(&*quadruple.arg2)){
+        } else if(auto* rhs = boost::get<variable_ref>(&*quadruple.arg2)){
             if(out[*rhs].constant() && boost::get<int>(&out[*rhs].value())){
                 if(auto* lhs = boost::get<int>(&*quadruple.arg1)){
                     out[quadruple.result] = {compute(op, *lhs, boost::get<int>(out[*rhs].value()))};
@@ -279,9 +298,9 @@ void mtac::ConstantPropagationProblem::transfer(const mtac::basic_block_p &, mta
 
         remove_copies = quadruple.result;
     } else if(op >= mtac::Operator::FADD && op <= mtac::Operator::FDIV){
-        if(auto* lhs = boost::get<std::shared_ptr<Variable>>(&*quadruple.arg1)){
+        if(auto* lhs = boost::get<variable_ref>(&*quadruple.arg1)){
             if(out[*lhs].constant() && boost::get<double>(&out[*lhs].value())){
-                if(auto* rhs = boost::get<std::shared_ptr<Variable>>(&*quadruple.arg2)){
+                if(auto* rhs = boost::get<variable_ref>(&*quadruple.arg2)){
                     if(out[*rhs].constant() && boost::get<double>(&out[*rhs].value())){
                         out[quadruple.result] = {compute(op, boost::get<double>(out[*lhs].value()), boost::get<double>(out[*rhs].value()))};
                     } else {
@@ -295,7 +314,7 @@ void mtac::ConstantPropagationProblem::transfer(const mtac::basic_block_p &, mta
             } else {
                 out[quadruple.result].set_nac();
             }
-        } else if(auto* rhs = boost::get<std::shared_ptr<Variable>>(&*quadruple.arg2)){
+        } else if(auto* rhs = boost::get<variable_ref>(&*quadruple.arg2)){
             if(out[*rhs].constant() && boost::get<double>(&out[*rhs].value())){
                 if(auto* lhs = boost::get<double>(&*quadruple.arg1)){
                     out[quadruple.result] = {compute(op, *lhs, boost::get<double>(out[*rhs].value()))};
@@ -313,12 +332,26 @@ void mtac::ConstantPropagationProblem::transfer(const mtac::basic_block_p &, mta
     }
     //Passing a variable by pointer erases its value
     else if(op == mtac::Operator::PPARAM){
-        if(auto* var_ptr = boost::get<std::shared_ptr<Variable>>(&*quadruple.arg1)){
+        if(auto* var_ptr = boost::get<variable_ref>(&*quadruple.arg1)){
             //Impossible to know if the variable is modified or not, consider it modified
             out[*var_ptr].set_nac();
 
             remove_copies = *var_ptr;
         }
+    }
+    //The values returned by a function are not known
+    else if(op == mtac::Operator::CALL){
+        if(quadruple.return2()){
+            out[quadruple.return2()].set_nac();
+
+            cancel_copies(out, quadruple.return2());
+        }
+
+        if(quadruple.return1()){
+            out[quadruple.return1()].set_nac();
+
+            remove_copies = quadruple.return1();
+        }
     } else {
         if(mtac::erase_result(op)){
             //The result is not constant at this point
@@ -329,21 +362,7 @@ void mtac::ConstantPropagationProblem::transfer(const mtac::basic_block_p &, mta
     }
 
     if(remove_copies){
-        //Cancel the copy of the variable erased
-        for(auto it = std::begin(out.values()); it != std::end(out.values()); ++it){
-            auto& lattice = it->second;
-
-            if(lattice.constant()){
-                auto lattice_value = lattice.value();
-                if(auto* ptr = boost::get<std::shared_ptr<Variable>>(&lattice_value)){
-                    auto variable = *ptr;
-
-                    if (variable == remove_copies){
-                        lattice.set_nac();
-                    } 
-                }
-            } 
-        }
+        cancel_copies(out, remove_copies);
     }
 }
 
@@ -172,10 +172,6 @@ bool mtac::global_cse::optimize(mtac::Function& function, std::shared_ptr<mtac::
 
         for(auto& exp : Eval[i]){
             if(AEin.find(exp) != AEin.end()){
-                function.context->global().stats().inc_counter("common_subexpr_eliminated");
-
-                changes = true;
-
                 auto it = i->begin();
 
                 while(!mtac::are_equivalent(*it, exp) && it != i->end()){
@@ -205,6 +201,10 @@ bool mtac::global_cse::optimize(mtac::Function& function, std::shared_ptr<mtac::
                     }
                 }
 
+                function.context->global().stats().inc_counter("common_subexpr_eliminated");
+
+                changes = true;
+
                 auto tj = function.context->new_temporary(exp.type);
                 mtac::Operator op = mtac::assign_op(exp.op);
 
@@ -97,7 +97,7 @@ struct ConstantCollector : public boost::static_visitor<> {
     }
 
     //Warning : Do not pass it by reference to avoid going to the template function
-    void operator()(std::string value){
+    void operator()(interned_string value){
         out[offset] = value;
     }
 
@@ -105,7 +105,7 @@ struct ConstantCollector : public boost::static_visitor<> {
         out[offset] = value;
     }
 
-    void operator()(std::shared_ptr<Variable> variable){
+    void operator()(variable_ref variable){
         out[offset] = variable;
     }
 
@@ -115,6 +115,22 @@ struct ConstantCollector : public boost::static_visitor<> {
     }
 };
 
+//Cancel the copies of the variable erased
+void cancel_copies(ProblemDomain& out, variable_ref erased){
+    for(auto it = std::begin(out.values()); it != std::end(out.values());){
+        auto value = it->second;
+
+        if(auto* ptr = boost::get<variable_ref>(&value)){
+            if(*ptr == erased){
+                it = out.values().erase(it);
+                continue;
+            }
+        }
+
+        ++it;
+    }
+}
+
 } //end of anonymous namespace
 
 void mtac::OffsetConstantPropagationProblem::transfer(const mtac::basic_block_p & /*basic_block*/, mtac::Quadruple& quadruple, ProblemDomain& out){
@@ -127,7 +143,7 @@ void mtac::OffsetConstantPropagationProblem::transfer(const mtac::basic_block_p
                 ConstantCollector collector(out, offset);
                 visit(collector, *quadruple.arg2);
             }
-        } else if(boost::get<std::shared_ptr<Variable>>(&*quadruple.arg1)){
+        } else if(boost::get<variable_ref>(&*quadruple.arg1)){
             auto variable = quadruple.result;
 
             //Impossible to know which offset is modified, consider the whole variable modified
@@ -144,14 +160,14 @@ void mtac::OffsetConstantPropagationProblem::transfer(const mtac::basic_block_p
         //PDOT Lets escape an offset
     } else if(quadruple.op == mtac::Operator::PDOT){
         if(auto* ptr = boost::get<int>(&*quadruple.arg2)){
-            auto variable = boost::get<std::shared_ptr<Variable>>(*quadruple.arg1);
+            auto variable = boost::get<variable_ref>(*quadruple.arg1);
 
             mtac::Offset offset(variable, *ptr);
             escaped.insert(offset);
         }
     //Passing a variable by pointer erases its value
     } else if(quadruple.op == mtac::Operator::PPARAM){
-        if(auto* ptr = boost::get<std::shared_ptr<Variable>>(&*quadruple.arg1)){
+        if(auto* ptr = boost::get<variable_ref>(&*quadruple.arg1)){
             auto variable = *ptr;
 
             //Impossible to know if the variable is modified or not, consider it modified
@@ -179,18 +195,15 @@ void mtac::OffsetConstantPropagationProblem::transfer(const mtac::basic_block_p
     }
 
     if(mtac::erase_result(quadruple.op)){
-        //Cancel the copy of the variable erased
-        for(auto it = std::begin(out.values()); it != std::end(out.values());){
-            auto value = it->second;
-
-            if(auto* ptr = boost::get<std::shared_ptr<Variable>>(&value)){
-                if(*ptr == quadruple.result){
-                    it = out.values().erase(it);
-                    continue;
-                }
-            }
+        cancel_copies(out, quadruple.result);
+    } else if(quadruple.op == mtac::Operator::CALL){
+        //The variables returned by the function are erased too
+        if(quadruple.return1()){
+            cancel_copies(out, quadruple.return1());
+        }
 
-            ++it;
+        if(quadruple.return2()){
+            cancel_copies(out, quadruple.return2());
         }
     }
 }
@@ -209,7 +222,7 @@ bool mtac::OffsetConstantPropagationProblem::optimize(mtac::Function& function,
             //If constant replace the value assigned to result by the value stored for arg1+arg2
             if(quadruple.op == mtac::Operator::DOT){
                 if(auto* ptr = boost::get<int>(&*quadruple.arg2)){
-                    if(auto* var_ptr = boost::get<std::shared_ptr<Variable>>(&*quadruple.arg1)){
+                    if(auto* var_ptr = boost::get<variable_ref>(&*quadruple.arg1)){
                         mtac::Offset offset(*var_ptr, *ptr);
 
                         if(results.find(offset) != results.end() && pointer_escaped->find(offset.variable) == pointer_escaped->end()){
@@ -218,7 +231,7 @@ bool mtac::OffsetConstantPropagationProblem::optimize(mtac::Function& function,
                             quadruple.arg2.reset();
 
                             if(quadruple.result->type()->is_pointer()){
-                                if(auto* var_ptr = boost::get<std::shared_ptr<Variable>>(&*quadruple.arg1)){
+                                if(auto* var_ptr = boost::get<variable_ref>(&*quadruple.arg1)){
                                     if(!(*var_ptr)->type()->is_pointer()){
                                         quadruple.op = mtac::Operator::PASSIGN;
                                     }
@@ -227,7 +240,7 @@ bool mtac::OffsetConstantPropagationProblem::optimize(mtac::Function& function,
 
                             optimized = true;
                         }
-                    } else if(auto* string_ptr = boost::get<std::string>(&*quadruple.arg1)){
+                    } else if(auto* string_ptr = boost::get<interned_string>(&*quadruple.arg1)){
                         auto string_value = string_pool->value(*string_ptr);
 
                         quadruple.op = mtac::Operator::ASSIGN;
@@ -239,7 +252,7 @@ bool mtac::OffsetConstantPropagationProblem::optimize(mtac::Function& function,
                 }
             } else if(quadruple.op == mtac::Operator::FDOT){
                 if(auto* ptr = boost::get<int>(&*quadruple.arg2)){
-                    mtac::Offset offset(boost::get<std::shared_ptr<Variable>>(*quadruple.arg1), *ptr);
+                    mtac::Offset offset(boost::get<variable_ref>(*quadruple.arg1), *ptr);
 
                     if(results.find(offset) != results.end() && pointer_escaped->find(offset.variable) == pointer_escaped->end()){
                         quadruple.op = mtac::Operator::FASSIGN;
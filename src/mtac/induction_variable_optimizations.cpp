@@ -119,7 +119,7 @@ void induction_variable_removal(mtac::Function& function, mtac::loop& loop){
 
             if(op == mtac::Operator::ASSIGN && mtac::isVariable(*quadruple.arg1)){
                 auto j = quadruple.result;
-                auto tj = boost::get<std::shared_ptr<Variable>>(*quadruple.arg1);
+                auto tj = boost::get<variable_ref>(*quadruple.arg1);
 
                 //If j = tj generated in strength reduction phase
                 if(dependent_induction_variables.count(j) && dependent_induction_variables.count(tj)){
@@ -139,7 +139,7 @@ void induction_variable_removal(mtac::Function& function, mtac::loop& loop){
             //Remove statements generated during strength reduction that are not necessary
             if(op == mtac::Operator::ADD && mtac::isVariable(*quadruple.arg1)){
                 auto j = quadruple.result;
-                auto tj = boost::get<std::shared_ptr<Variable>>(*quadruple.arg1);
+                auto tj = boost::get<variable_ref>(*quadruple.arg1);
 
                 if(j == tj && usage.read[j] == 1 && function_usage.read[j] == 1){
                     //If it is a dependent induction variable, remove it
@@ -191,20 +191,20 @@ void induction_variable_replace(mtac::Function& function, mtac::loop& loop){
     if(if_.is_if()){
         if(if_.op != mtac::Operator::IF_UNARY && if_.op <= mtac::Operator::IF_LESS_EQUALS){
             if(mtac::isVariable(*if_.arg1) && mtac::isInt(*if_.arg2)){
-                biv = boost::get<std::shared_ptr<Variable>>(*if_.arg1);
+                biv = boost::get<variable_ref>(*if_.arg1);
                 end = boost::get<int>(*if_.arg2);
             } else if(mtac::isVariable(*if_.arg2) && mtac::isInt(*if_.arg1)){
-                biv = boost::get<std::shared_ptr<Variable>>(*if_.arg2);
+                biv = boost::get<variable_ref>(*if_.arg2);
                 end = boost::get<int>(*if_.arg1);
             }
         }
     } else if(if_.is_if_false()){
         if(if_.op != mtac::Operator::IF_FALSE_UNARY && if_.op <= mtac::Operator::IF_FALSE_LESS_EQUALS){
             if(mtac::isVariable(*if_.arg1) && mtac::isInt(*if_.arg2)){
-                biv = boost::get<std::shared_ptr<Variable>>(*if_.arg1);
+                biv = boost::get<variable_ref>(*if_.arg1);
                 end = boost::get<int>(*if_.arg2);
             } else if(mtac::isVariable(*if_.arg2) && mtac::isInt(*if_.arg1)){
-                biv = boost::get<std::shared_ptr<Variable>>(*if_.arg2);
+                biv = boost::get<variable_ref>(*if_.arg2);
                 end = boost::get<int>(*if_.arg1);
             }
         }
@@ -23,6 +23,7 @@
 #include "mtac/VariableReplace.hpp"
 #include "mtac/ControlFlowGraph.hpp"
 #include "mtac/Quadruple.hpp"
+#include "mtac/profile.hpp"
 
 using namespace eddic;
 
@@ -30,6 +31,7 @@ namespace {
 
 mtac::basic_block_p create_safe_block(mtac::Function& dest_function, mtac::basic_block_p bb){
     auto safe_block = dest_function.new_bb();
+    safe_block->frequency = bb->frequency;
 
     //Insert the new basic block before the old one
     dest_function.insert_after(dest_function.at(bb), safe_block);
@@ -62,6 +64,7 @@ mtac::basic_block_p split_if_necessary(mtac::Function& dest_function, mtac::basi
         log::emit<Trace>("Inlining") << "Split block " << bb << " to perform inlining" << log::endl;
 
         auto split_block = dest_function.new_bb();
+        split_block->frequency = bb->frequency;
 
         dest_function.insert_after(dest_function.at(bb), split_block);
 
@@ -106,14 +109,18 @@ mtac::BBClones clone(mtac::Function& source_function, mtac::Function& dest_funct
     auto entry = bb->prev;
     const auto& exit = bb;
 
+    //The frequencies of the callee are scaled to the frequency of the call site
+    auto invocations = std::max<std::size_t>(old_entry->frequency, 1);
+
     for(auto& block : source_function){
-        //Copy all basic blocks except ENTRY and EXIT
-        if(block->index >= 0){
+        //Copy all basic blocks except EXIT and ENTRY, unless statements have been moved in ENTRY
+        if(block->index >= 0 || (block == old_entry && !block->statements.empty())){
             auto new_bb = dest_function.new_bb();
 
             //Copy the control flow graph properties, they will be corrected after
             new_bb->successors = block->successors;
             new_bb->predecessors = block->predecessors;
+            new_bb->frequency = block->frequency * bb->frequency / invocations;
 
             for(auto& statement : block->statements){
                 new_bb->statements.push_back(mtac::copy(statement));
@@ -139,7 +146,7 @@ mtac::BBClones clone(mtac::Function& source_function, mtac::Function& dest_funct
         }
 
         for(auto& pred : block->predecessors){
-            if(pred == old_entry){
+            if(pred == old_entry && !bb_clones.count(old_entry)){
                 pred = entry;
                 entry->successors.push_back(block);
             } else {
@@ -148,6 +155,14 @@ mtac::BBClones clone(mtac::Function& source_function, mtac::Function& dest_funct
         }
     }
 
+    //The clone of ENTRY has no predecessor in the source function
+    if(bb_clones.count(old_entry)){
+        auto new_entry = bb_clones[old_entry];
+
+        new_entry->predecessors.push_back(entry);
+        entry->successors.push_back(new_entry);
+    }
+
     return bb_clones;
 }
 
@@ -181,7 +196,7 @@ mtac::VariableClones copy_parameters(mtac::Function& source_function, mtac::Func
                 auto src_var = statement.param();
 
                 if(src_var->type()->is_array()){
-                    auto dest_var = boost::get<std::shared_ptr<Variable>>(*statement.arg1);
+                    auto dest_var = boost::get<variable_ref>(*statement.arg1);
 
                     variable_clones[src_var] = dest_var;
 
@@ -203,7 +218,7 @@ mtac::VariableClones copy_parameters(mtac::Function& source_function, mtac::Func
 
                         //Copy the size
                         statement.op = mtac::Operator::DOT_ASSIGN;
-                        statement.result = boost::get<std::shared_ptr<Variable>>(variable_clones[src_var]);
+                        statement.result = boost::get<variable_ref>(variable_clones[src_var]);
                         statement.arg2 = statement.arg1;
                         statement.arg1 = static_cast<int>(INT->size());
 
@@ -270,7 +285,7 @@ unsigned int count_constant_parameters(mtac::Function& source_function, mtac::Fu
                         ++constant;
                     } else if(boost::get<double>(&arg)){
                         ++constant;
-                    } else if(boost::get<std::string>(&arg)){
+                    } else if(boost::get<interned_string>(&arg)){
                         ++constant;
                     }
                 }
@@ -393,13 +408,25 @@ bool will_inline(mtac::Program& program, mtac::Function& source_function, mtac::
             return callee_size < 100 && caller_size < 300;
         }
 
+        //With a profile, the call sites that are never executed are not worth growing the caller
+        if(source_function.profiled() && bb->frequency == 0){
+            return callee_size < SMALL_FUNCTION && caller_size < 200;
+        }
+
+        //The call sites are weighted by their frequency, from the profile or from the loop depth
+        auto weight = mtac::block_weight(source_function, bb);
+
         //For inner loop, increase the chances of inlining
-        if(bb->depth > 1){
+        if(weight >= 100){
+            if(source_function.profiled()){
+                source_function.context->global().stats().inc_counter("profile_hot_call_sites");
+            }
+
             return caller_size < 250 && callee_size < 75;
         }
 
         //For single loop, increase a bit the changes of inlining
-        if(bb->depth > 0){
+        if(weight >= 10){
             return caller_size < 150 && callee_size < 50;
         }
 
@@ -473,13 +500,15 @@ bool call_site_inlining(mtac::Function& dest_function, mtac::Function& source_fu
                         adapt_instructions(variable_clones, bb_clones, call, safe);
 
                         //The target function is called one less time
-                        --program.cg.edge(dest_definition, source_definition)->count;
+                        auto edge = program.cg.edge(dest_definition, source_definition);
+                        --edge->count;
+                        edge->frequency -= std::min(edge->frequency, basic_block->frequency);
 
                         //There are perhaps new references to functions
-                        for(auto& block : source_function){
-                            for(auto& statement : block){
+                        for(auto& [block, clone] : bb_clones){
+                            for(auto& statement : clone->statements){
                                 if(statement.op == mtac::Operator::CALL){
-                                    program.cg.add_edge(dest_definition, statement.function());
+                                    program.cg.add_edge(dest_definition, statement.function())->frequency += clone->frequency;
                                 }
                             }
                         }
@@ -175,7 +175,7 @@ void find_dependent_induction_variables(mtac::loop& loop, mtac::Function& functi
                 auto arg2 = *quadruple.arg2;
 
                 if(mtac::isInt(arg1) && mtac::isVariable(arg2)){
-                    auto variable = boost::get<std::shared_ptr<Variable>>(arg2);
+                    auto variable = boost::get<variable_ref>(arg2);
                     auto e = boost::get<int>(arg1);
 
                     if(variable != var){
@@ -189,7 +189,7 @@ void find_dependent_induction_variables(mtac::loop& loop, mtac::Function& functi
                         }
                     }
                 } else if(mtac::isInt(arg2) && mtac::isVariable(arg1)){
-                    auto variable = boost::get<std::shared_ptr<Variable>>(arg1);
+                    auto variable = boost::get<variable_ref>(arg1);
                     auto e = boost::get<int>(arg2);
 
                     if(variable != var){
@@ -207,7 +207,7 @@ void find_dependent_induction_variables(mtac::loop& loop, mtac::Function& functi
                 auto arg2 = *quadruple.arg2;
 
                 if(mtac::isInt(arg1) && mtac::isVariable(arg2)){
-                    auto variable = boost::get<std::shared_ptr<Variable>>(arg2);
+                    auto variable = boost::get<variable_ref>(arg2);
                     auto e = boost::get<int>(arg1);
 
                     if(variable != var){
@@ -221,7 +221,7 @@ void find_dependent_induction_variables(mtac::loop& loop, mtac::Function& functi
                         }
                     }
                 } else if(mtac::isInt(arg2) && mtac::isVariable(arg1)){
-                    auto variable = boost::get<std::shared_ptr<Variable>>(arg1);
+                    auto variable = boost::get<variable_ref>(arg1);
                     auto e = boost::get<int>(arg2);
 
                     if(variable != var){
@@ -235,8 +235,8 @@ void find_dependent_induction_variables(mtac::loop& loop, mtac::Function& functi
                         }
                     }
                 } else if(mtac::isVariable(arg1) && mtac::isVariable(arg2)){
-                    auto var1 = boost::get<std::shared_ptr<Variable>>(arg1);
-                    auto var2 = boost::get<std::shared_ptr<Variable>>(arg2);
+                    auto var1 = boost::get<variable_ref>(arg1);
+                    auto var2 = boost::get<variable_ref>(arg2);
 
                     if(var1 == var2 && var1 != var){
                         if(loop.basic_induction_variables().contains(var1)){
@@ -253,7 +253,7 @@ void find_dependent_induction_variables(mtac::loop& loop, mtac::Function& functi
                 auto arg2 = *quadruple.arg2;
 
                 if(mtac::isInt(arg2) && mtac::isVariable(arg1)){
-                    auto variable = boost::get<std::shared_ptr<Variable>>(arg1);
+                    auto variable = boost::get<variable_ref>(arg1);
                     auto e = boost::get<int>(arg2);
 
                     if(variable != var){
@@ -269,7 +269,7 @@ void find_dependent_induction_variables(mtac::loop& loop, mtac::Function& functi
                 }
             } else if(quadruple.op == mtac::Operator::MINUS){
                 if(mtac::isVariable(arg1)){
-                    auto variable = boost::get<std::shared_ptr<Variable>>(arg1);
+                    auto variable = boost::get<variable_ref>(arg1);
 
                     if(variable != var){
                         if(loop.basic_induction_variables().contains(variable)){
@@ -530,9 +530,9 @@ void estimate_iterations(mtac::Function& function){
                 if(condition.arg1 && condition.arg2){
                     std::shared_ptr<Variable> biv;
                     if(mtac::isVariable(*condition.arg1) && boost::get<int>(&*condition.arg2)){
-                        biv = boost::get<std::shared_ptr<Variable>>(*condition.arg1);
+                        biv = boost::get<variable_ref>(*condition.arg1);
                     } else if(mtac::isVariable(*condition.arg2) && boost::get<int>(&*condition.arg1)){
-                        biv = boost::get<std::shared_ptr<Variable>>(*condition.arg2);
+                        biv = boost::get<variable_ref>(*condition.arg2);
                     }
                     
                     auto& basic_induction_variables = loop.basic_induction_variables();
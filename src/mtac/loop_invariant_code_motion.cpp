@@ -30,7 +30,7 @@ namespace {
 
 bool is_invariant(boost::optional<mtac::Argument>& argument, mtac::Usage& usage){
     if(argument){
-        if(auto* ptr = boost::get<std::shared_ptr<Variable>>(&*argument)){
+        if(auto* ptr = boost::get<variable_ref>(&*argument)){
             return usage.written[*ptr] == 0;
         }
     }
@@ -38,13 +38,18 @@ bool is_invariant(boost::optional<mtac::Argument>& argument, mtac::Usage& usage)
     return true;
 }
 
-bool is_invariant(mtac::Quadruple& quadruple, mtac::Usage& usage){
+bool is_invariant(mtac::Quadruple& quadruple, mtac::Usage& usage, bool calls){
     if(mtac::erase_result(quadruple.op)){
         //If there are more than one write to this variable, the computation is not invariant
         if(usage.written[quadruple.result] > 1){
             return false;
         }
 
+        //A called function can write to the memory that is read
+        if(calls && (quadruple.op == mtac::Operator::DOT || quadruple.op == mtac::Operator::FDOT)){
+            return false;
+        }
+
         return is_invariant(quadruple.arg1, usage) && is_invariant(quadruple.arg2, usage);
     }
 
@@ -107,15 +112,27 @@ bool is_valid_invariant(mtac::basic_block_p source_bb, mtac::Quadruple& quadrupl
 }
 
 bool loop_invariant_code_motion(mtac::loop& loop, mtac::Function& function){
-    mtac::basic_block_p pre_header;
+    mtac::basic_block_p pre_header = nullptr;
 
     bool optimized = false;
 
     auto usage = compute_write_usage(loop);
+    bool calls = false;
+
+    //The writes to the memory of a variable invalidate the loads of this memory too
+    for(auto& bb : loop){
+        for(auto& statement : bb->statements){
+            if(statement.op == mtac::Operator::DOT_ASSIGN || statement.op == mtac::Operator::DOT_FASSIGN || statement.op == mtac::Operator::DOT_PASSIGN){
+                ++usage.written[statement.result];
+            } else if(statement.op == mtac::Operator::CALL){
+                calls = true;
+            }
+        }
+    }
 
     for(auto& bb : loop){
         for(auto& statement : bb->statements){
-            if(is_invariant(statement, usage)){
+            if(is_invariant(statement, usage, calls)){
                 LOG<Trace>("ICM") << "Found invariant " << statement << log::endl;
 
                 if(is_valid_invariant(bb, statement, loop)){
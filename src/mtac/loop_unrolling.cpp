@@ -12,6 +12,7 @@
 #include "mtac/Function.hpp"
 #include "mtac/loop.hpp"
 #include "mtac/loop_unrolling.hpp"
+#include "mtac/profile.hpp"
 #include "mtac/Utils.hpp"
 
 using namespace eddic;
@@ -34,6 +35,11 @@ bool mtac::loop_unrolling::operator()(mtac::Function& function){
             if(it > 100){
                 auto bb = *loop.begin();
 
+                //Do not increase the size of the loops that are never executed
+                if(function.profiled() && bb->frequency == 0){
+                    continue;
+                }
+
                 //Do not increase too much the size of the body
                 if(bb->statements.size() < 20){
                     unsigned int factor = 0;
@@ -43,7 +43,7 @@ bool mtac::loop_unswitching::operator()(mtac::Function& function){
                             auto usage = mtac::compute_write_usage(loop);
 
                             if(condition.arg1){
-                                if(auto* ptr = boost::get<std::shared_ptr<Variable>>(&*condition.arg1)){
+                                if(auto* ptr = boost::get<variable_ref>(&*condition.arg1)){
                                     if(usage.written[*ptr] > 0){
                                         continue;
                                     }
@@ -51,7 +51,7 @@ bool mtac::loop_unswitching::operator()(mtac::Function& function){
                             }
                             
                             if(condition.arg2){
-                                if(auto* ptr = boost::get<std::shared_ptr<Variable>>(&*condition.arg2)){
+                                if(auto* ptr = boost::get<variable_ref>(&*condition.arg2)){
                                     if(usage.written[*ptr] > 0){
                                         continue;
                                     }
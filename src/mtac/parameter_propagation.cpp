@@ -162,7 +162,7 @@ bool mtac::parameter_propagation::operator()(mtac::Program& program){
                                 auto& param_function = quadruple.function();
 
                                 if(param_function == function){
-                                    mtac::basic_block_p param_block;
+                                    mtac::basic_block_p param_block = nullptr;
                                     mtac::basic_block::reverse_iterator it;
                                     mtac::basic_block::reverse_iterator end;
 
@@ -0,0 +1,187 @@
+//=======================================================================
+// Copyright Baptiste Wicht 2011-2016.
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include "GlobalContext.hpp"
+#include "FunctionContext.hpp"
+#include "Type.hpp"
+#include "Variable.hpp"
+#include "Warnings.hpp"
+#include "logging.hpp"
+#include "timing.hpp"
+
+#include "mtac/profile.hpp"
+#include "mtac/Program.hpp"
+#include "mtac/Quadruple.hpp"
+
+using namespace eddic;
+
+namespace {
+
+//The runtime support writes this array, with its size, at exit
+const std::string counters_name = "__profile_counters";
+
+/*!
+ * Return the functions that are instrumented, in the order of their counters.
+ * The functions are sorted by name so that the order does not depend on the order of the declarations.
+ */
+std::vector<mtac::Function*> profiled_functions(mtac::Program& program){
+    std::vector<mtac::Function*> functions;
+
+    for(auto& function : program.functions){
+        if(!function.standard()){
+            functions.push_back(&function);
+        }
+    }
+
+    std::ranges::sort(functions, [](mtac::Function* lhs, mtac::Function* rhs){
+        return lhs->definition().mangled_name() < rhs->definition().mangled_name();
+    });
+
+    return functions;
+}
+
+std::size_t count_blocks(std::vector<mtac::Function*>& functions){
+    std::size_t blocks = 0;
+
+    for(auto* function : functions){
+        for(auto& block : *function){
+            if(block->index >= 0){
+                ++blocks;
+            }
+        }
+    }
+
+    return blocks;
+}
+
+void increment_counter(mtac::Function& function, mtac::basic_block_p block, std::shared_ptr<Variable> counters, std::size_t counter){
+    //The first element of the array is its size
+    auto offset = static_cast<int>((counter + 1) * INT->size());
+
+    auto value = function.context->new_temporary(INT);
+    auto incremented = function.context->new_temporary(INT);
+
+    //The call of an unsafe function must stay the first statement of its block, after its parameters
+    auto position = block->statements.begin();
+    if(position != block->statements.end() && position->op == mtac::Operator::CALL){
+        ++position;
+    }
+
+    position = block->statements.insert(position, mtac::Quadruple(value, counters, mtac::Operator::DOT, offset));
+    position = block->statements.insert(position + 1, mtac::Quadruple(incremented, value, mtac::Operator::ADD, 1));
+    block->statements.insert(position + 1, mtac::Quadruple(counters, offset, mtac::Operator::DOT_ASSIGN, incremented));
+}
+
+} //end of anonymous namespace
+
+void mtac::instrument_program(mtac::Program& program, const std::string& file){
+    timing_timer timer(program.context.timing(), "profile_instrumentation");
+
+    auto functions = profiled_functions(program);
+    auto blocks = count_blocks(functions);
+
+    //The counters of the blocks are followed by the number of invocations of each function
+    auto total = blocks + functions.size();
+    auto counters = program.context.addVariable(counters_name, new_array_type(INT, total));
+
+    std::size_t counter = 0;
+
+    for(auto* function : functions){
+        for(auto& block : *function){
+            if(block->index >= 0){
+                increment_counter(*function, block, counters, counter++);
+            }
+        }
+    }
+
+    for(auto* function : functions){
+        //The first block can be the target of a jump, a new block is executed exactly once per call
+        auto invocation_block = function->new_bb();
+        function->insert_after(function->begin(), invocation_block);
+
+        increment_counter(*function, invocation_block, counters, counter++);
+    }
+
+    program.profile_file = file;
+
+    program.context.stats().inc_counter("profile_counters", total);
+}
+
+bool mtac::annotate_program(mtac::Program& program, const std::string& file){
+    timing_timer timer(program.context.timing(), "profile_annotation");
+
+    std::ifstream stream(file, std::ios::binary);
+
+    if(!stream){
+        warn("The profile " + file + " cannot be read, it is ignored");
+        return false;
+    }
+
+    std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+    //The counters are written with the size of an integer of the target platform, in little endian
+    const auto word = INT->size();
+
+    auto read = [&bytes, word](std::size_t i){
+        std::size_t value = 0;
+
+        for(std::size_t b = 0; b < word; ++b){
+            value |= static_cast<std::size_t>(bytes[i * word + b]) << (8 * b);
+        }
+
+        return value;
+    };
+
+    auto functions = profiled_functions(program);
+    auto blocks = count_blocks(functions);
+    auto total = blocks + functions.size();
+
+    if(bytes.size() != (total + 1) * word || read(0) != total){
+        warn("The profile " + file + " does not match the program, it is ignored");
+        return false;
+    }
+
+    std::size_t counter = 0;
+
+    for(auto* function : functions){
+        for(auto& block : *function){
+            if(block->index >= 0){
+                block->frequency = read(++counter);
+            }
+        }
+    }
+
+    for(auto* function : functions){
+        //The frequency of the entry block is the number of invocations of the function
+        function->entry_bb()->frequency = read(++counter);
+        function->profiled() = true;
+    }
+
+    program.context.stats().inc_counter("profile_counters", total);
+
+    return true;
+}
+
+std::size_t mtac::block_weight(mtac::Function& function, mtac::basic_block_cp bb){
+    if(function.profiled()){
+        auto invocations = std::max<std::size_t>(function.entry_bb()->frequency, 1);
+        return std::max<std::size_t>(bb->frequency / invocations, 1);
+    }
+
+    std::size_t weight = 1;
+
+    for(unsigned int depth = 0; depth < bb->depth; ++depth){
+        weight *= 10;
+    }
+
+    return weight;
+}
@@ -51,7 +51,7 @@ bool is_not_direct_alias(std::shared_ptr<Variable> source, std::shared_ptr<Varia
     for(auto& block : function){
         for(auto& quadruple : block){
             if(quadruple.op == mtac::Operator::PASSIGN && quadruple.result == source){
-                if(auto* var_ptr = boost::get<std::shared_ptr<Variable>>(&*quadruple.arg1)){
+                if(auto* var_ptr = boost::get<variable_ref>(&*quadruple.arg1)){
                     if(*var_ptr == target){
                         return false;
                     }
@@ -69,7 +69,7 @@ std::vector<std::shared_ptr<Variable>> get_targets(std::shared_ptr<Variable> var
     for(auto& block : function){
         for(auto& quadruple : block->statements){
             if(quadruple.op == mtac::Operator::ASSIGN || quadruple.op == mtac::Operator::FASSIGN || quadruple.op == mtac::Operator::PASSIGN){
-                if(auto* var_ptr = boost::get<std::shared_ptr<Variable>>(&*quadruple.arg1)){
+                if(auto* var_ptr = boost::get<variable_ref>(&*quadruple.arg1)){
                     if(*var_ptr == variable){
                         targets.push_back(quadruple.result); 
                     }
@@ -107,7 +107,7 @@ struct VariableReplace {
 
     inline bool optimize_optional(boost::optional<mtac::Argument>& arg){
         if(arg){
-            if(auto* ptr = boost::get<std::shared_ptr<Variable>>(&*arg)){
+            if(auto* ptr = boost::get<variable_ref>(&*arg)){
                 if(*ptr == source){
                     arg = target;
                     return true;
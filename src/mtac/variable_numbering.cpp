@@ -0,0 +1,65 @@
+//=======================================================================
+// Copyright Baptiste Wicht 2011-2016.
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#include "cpp_utils/assert.hpp"
+
+#include "Variable.hpp"
+#include "variant_utils.hpp"
+
+#include "mtac/variable_numbering.hpp"
+#include "mtac/Function.hpp"
+#include "mtac/Quadruple.hpp"
+
+using namespace eddic;
+
+mtac::variable_numbering::variable_numbering(mtac::Function& function){
+    for(auto& block : function){
+        for(auto& quadruple : block->statements){
+            if(quadruple.result){
+                add(quadruple.result);
+            }
+
+            if_init<variable_ref>(quadruple.arg1, [this](variable_ref var){ add(var); });
+            if_init<variable_ref>(quadruple.arg2, [this](variable_ref var){ add(var); });
+        }
+    }
+}
+
+std::size_t mtac::variable_numbering::add(variable_ref variable){
+    auto it = indices.find(variable);
+
+    if(it != indices.end()){
+        return it->second;
+    }
+
+    indices[variable] = variables.size();
+    variables.push_back(variable);
+
+    return variables.size() - 1;
+}
+
+std::size_t mtac::variable_numbering::index(variable_ref variable) const {
+    cpp_assert(contains(variable), "The variable has not been numbered");
+
+    return indices.find(variable)->second;
+}
+
+bool mtac::variable_numbering::contains(variable_ref variable) const {
+    return indices.find(variable) != indices.end();
+}
+
+const std::shared_ptr<Variable>& mtac::variable_numbering::variable(std::size_t index) const {
+    return variables[index].shared();
+}
+
+std::size_t mtac::variable_numbering::size() const {
+    return variables.size();
+}
+
+boost::dynamic_bitset<> mtac::variable_numbering::empty_set() const {
+    return boost::dynamic_bitset<>(variables.size());
+}
@@ -18,14 +18,14 @@ using namespace eddic;
 namespace {
 
 struct UsageCollector {
-    std::shared_ptr<Variable> var;
+    variable_ref var;
 
-    UsageCollector(std::shared_ptr<Variable> var) : var(var) {}
+    UsageCollector(variable_ref var) : var(var) {}
 
     template<typename T>
     bool collect_optional(T& opt){
         if(opt){
-            if(auto* variablePtr = boost::get<std::shared_ptr<Variable>>(&*opt)){
+            if(auto* variablePtr = boost::get<variable_ref>(&*opt)){
                 return *variablePtr == var;
             }
         }
@@ -48,8 +48,8 @@ mtac::Usage compute_read_usage(Container& loop){
                 ++usage.read[quadruple.result];
             }
 
-            if_init<std::shared_ptr<Variable>>(quadruple.arg1, [&usage](std::shared_ptr<Variable>& var){++usage.read[var];});
-            if_init<std::shared_ptr<Variable>>(quadruple.arg2, [&usage](std::shared_ptr<Variable>& var){++usage.read[var];});
+            if_init<variable_ref>(quadruple.arg1, [&usage](variable_ref var){++usage.read[var];});
+            if_init<variable_ref>(quadruple.arg2, [&usage](variable_ref var){++usage.read[var];});
         }
     }
 
@@ -117,8 +117,8 @@ mtac::VariableUsage mtac::compute_variable_usage_with_depth(mtac::Function& func
     for(auto& block : function){
         for(auto& quadruple : block->statements){
             usage[quadruple.result] += pow(depth_factor, block->depth);
-            if_init<std::shared_ptr<Variable>>(quadruple.arg1, [&usage, depth_factor, &block](std::shared_ptr<Variable>& var){ usage[var] += pow(depth_factor, block->depth); });
-            if_init<std::shared_ptr<Variable>>(quadruple.arg2, [&usage, depth_factor, &block](std::shared_ptr<Variable>& var){ usage[var] += pow(depth_factor, block->depth); });
+            if_init<variable_ref>(quadruple.arg1, [&usage, depth_factor, &block](variable_ref var){ usage[var] += pow(depth_factor, block->depth); });
+            if_init<variable_ref>(quadruple.arg2, [&usage, depth_factor, &block](variable_ref var){ usage[var] += pow(depth_factor, block->depth); });
         }
     }
 
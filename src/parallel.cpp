@@ -0,0 +1,114 @@
+//=======================================================================
+// Copyright Baptiste Wicht 2011-2016.
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "parallel.hpp"
+
+using namespace eddic;
+
+namespace {
+
+struct work_queue {
+    std::mutex mutex;
+    std::deque<std::size_t> tasks;
+
+    bool pop(std::size_t& task){
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if(tasks.empty()){
+            return false;
+        }
+
+        task = tasks.back();
+        tasks.pop_back();
+
+        return true;
+    }
+
+    bool steal(std::size_t& task){
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if(tasks.empty()){
+            return false;
+        }
+
+        task = tasks.front();
+        tasks.pop_front();
+
+        return true;
+    }
+};
+
+} //end of anonymous namespace
+
+std::size_t eddic::hardware_threads(){
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void eddic::parallel_for(std::size_t n, std::size_t threads, const std::function<void(std::size_t)>& task){
+    threads = std::min(threads, n);
+
+    if(threads <= 1){
+        for(std::size_t i = 0; i < n; ++i){
+            task(i);
+        }
+
+        return;
+    }
+
+    //Each worker starts with a contiguous range of tasks, in reverse order so that it pops them in order
+    std::vector<work_queue> queues(threads);
+
+    for(std::size_t w = 0; w < threads; ++w){
+        auto first = w * n / threads;
+        auto last = (w + 1) * n / threads;
+
+        for(auto i = last; i > first; --i){
+            queues[w].tasks.push_back(i - 1);
+        }
+    }
+
+    auto worker = [&](std::size_t w){
+        std::size_t current;
+
+        while(true){
+            if(queues[w].pop(current)){
+                task(current);
+                continue;
+            }
+
+            //Tasks never spawn new tasks, so once every queue is empty, the work is done
+            bool stolen = false;
+            for(std::size_t v = 1; v < threads && !stolen; ++v){
+                stolen = queues[(w + v) % threads].steal(current);
+            }
+
+            if(!stolen){
+                return;
+            }
+
+            task(current);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for(std::size_t w = 1; w < threads; ++w){
+        workers.emplace_back(worker, w);
+    }
+
+    //The calling thread is also used as a worker
+    worker(0);
+
+    for(auto& thread : workers){
+        thread.join();
+    }
+}
@@ -20,12 +20,12 @@
 #include <istream>
 #include <sstream>
 #include <iostream>
-#include <fstream>
 #include <string>
 
 #include "GlobalContext.hpp"
 
 #include "parser_x3/SpiritParser.hpp"
+#include "parser_x3/ast_cache.hpp"
 
 namespace x3 = boost::spirit::x3;
 
@@ -887,39 +887,56 @@ namespace x3_grammar {
 
 } // end of grammar namespace
 
+parser_x3::SpiritParser::SpiritParser(bool header_cache) : header_cache(header_cache) {
+    //The symbols must be filled before any file is parsed, they are then only read
+    x3_grammar::add_keywords();
+}
+
 bool parser_x3::SpiritParser::parse(const std::string& file, ast::SourceFile& program, GlobalContext & context){
+    if(parse(file, program, context, false, std::cerr)){
+        return true;
+    } else {
+        std::cout << "Invalid source file" << std::endl;
+        return false;
+    }
+}
+
+bool parser_x3::SpiritParser::parse(const std::string& file, ast::SourceFile& program, GlobalContext & context, bool header, std::ostream& errors){
     timing_timer timer(context.timing(), "parsing");
 
-    std::ifstream in(file.c_str(), std::ios::binary);
-    in.unsetf(std::ios::skipws);
+    //The parser runs directly on the mapping of the file
+    auto& file_contents = context.get_file_content(context.new_file(file));
 
-    //Collect the size of the file
-    in.seekg(0, std::istream::end);
-    std::size_t size(static_cast<size_t>(in.tellg()));
-    in.seekg(0, std::istream::beg);
+    if(!file_contents.valid()){
+        errors << "Cannot read the file " << file << std::endl;
+        return false;
+    }
 
-    int current_file = context.new_file(file);
+    x3_grammar::iterator_type it(file_contents.begin());
+    x3_grammar::iterator_type end(file_contents.end());
 
-    x3_grammar::add_keywords();
+    int id_file = context.error_handler.register_handler(it, end, file);
 
-    std::string& file_contents = context.get_file_content(current_file);
-    file_contents.resize(size);
-    in.read(&file_contents[0], size);
+    bool cache = header && header_cache;
 
-    x3_grammar::iterator_type it(file_contents.begin());
-    x3_grammar::iterator_type end(file_contents.end());
+    if(cache && load_cached_ast(file, id_file, file_contents.contents(), program, context)){
+        return true;
+    }
 
-    context.error_handler.register_handler(it, end, file);
+    x3_grammar::file_error_handler error_handler{context.error_handler.handler(id_file), id_file, errors};
 
-    auto const parser = x3::with<x3_grammar::error_handler_tag>(std::ref(context.error_handler))[x3_grammar::source_file];
+    auto const parser = x3::with<x3_grammar::error_handler_tag>(std::ref(error_handler))[x3_grammar::source_file];
     auto& skipper = x3_grammar::skipper;
 
     bool r = x3::phrase_parse(it, end, parser, skipper, program);
 
     if(r && it == end){
+        if(cache){
+            store_cached_ast(file, id_file, file_contents.contents(), program, context);
+        }
+
         return true;
     } else {
-        std::cout << "Invalid source file" << std::endl;
         return false;
     }
 }
@@ -0,0 +1,512 @@
+//=======================================================================
+// Copyright Baptiste Wicht 2011-2016.
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <type_traits>
+#include <utility>
+
+#include <link.h>
+#include <unistd.h>
+
+#include <boost/fusion/include/for_each.hpp>
+#include <boost/fusion/include/is_sequence.hpp>
+
+#include "parser_x3/ast_cache.hpp"
+
+#include "GlobalContext.hpp"
+#include "mapped_file.hpp"
+
+namespace x3 = boost::spirit::x3;
+
+using namespace eddic;
+
+namespace {
+
+const char magic[] = {'E', 'D', 'D', 'I', 'C', 'A', 'S', 'T'};
+
+template<typename T>
+struct is_vector : std::false_type {};
+
+template<typename T>
+struct is_vector<std::vector<T>> : std::true_type {};
+
+template<typename T>
+struct is_optional : std::false_type {};
+
+template<typename T>
+struct is_optional<boost::optional<T>> : std::true_type {};
+
+template<typename T>
+struct is_forward_ast : std::false_type {};
+
+template<typename T>
+struct is_forward_ast<x3::forward_ast<T>> : std::true_type {};
+
+template<typename T>
+struct is_variant : std::false_type {};
+
+template<typename... T>
+struct is_variant<x3::variant<T...>> : std::true_type {};
+
+//FNV-1a
+uint64_t hash(std::string_view contents, uint64_t value = 14695981039346656037ULL){
+    for(unsigned char c : contents){
+        value = (value ^ c) * 1099511628211ULL;
+    }
+
+    return value;
+}
+
+int find_build_id(dl_phdr_info* info, std::size_t, void* data){
+    auto& build_id = *static_cast<std::string*>(data);
+
+    for(std::size_t i = 0; i < info->dlpi_phnum; ++i){
+        auto& header = info->dlpi_phdr[i];
+
+        if(header.p_type != PT_NOTE){
+            continue;
+        }
+
+        auto* current = reinterpret_cast<const char*>(info->dlpi_addr + header.p_vaddr);
+        auto* end = current + header.p_memsz;
+
+        while(current + sizeof(ElfW(Nhdr)) <= end){
+            auto* note = reinterpret_cast<const ElfW(Nhdr)*>(current);
+            auto* name = current + sizeof(ElfW(Nhdr));
+            auto* desc = name + ((note->n_namesz + 3) & ~3U);
+
+            if(note->n_type == NT_GNU_BUILD_ID && note->n_namesz == 4 && std::memcmp(name, "GNU", 4) == 0 && desc + note->n_descsz <= end){
+                build_id.assign(desc, note->n_descsz);
+                return 1;
+            }
+
+            current = desc + ((note->n_descsz + 3) & ~3U);
+        }
+    }
+
+    //Only the executable itself is searched, it is always the first object
+    return 1;
+}
+
+/*!
+ * Return the key identifying the build of the compiler. The AST and the grammar are both compiled
+ * in the executable, an entry written by another build of the compiler is never reused.
+ */
+const std::string& cache_key(){
+    static const std::string key = []{
+        std::string build_id;
+        dl_iterate_phdr(find_build_id, &build_id);
+
+        //Without a build id, fall back to the content of the executable
+        if(build_id.empty()){
+            mapped_file executable("/proc/self/exe");
+
+            if(executable.valid()){
+                auto value = hash(executable.contents());
+                build_id.assign(reinterpret_cast<const char*>(&value), sizeof(value));
+            }
+        }
+
+        std::string key = "eddic ";
+        for(unsigned char c : build_id){
+            char hex[3];
+            std::snprintf(hex, sizeof(hex), "%02x", c);
+            key += hex;
+        }
+
+        return key;
+    }();
+
+    return key;
+}
+
+uint64_t key_hash(std::string_view contents){
+    return hash(contents, hash(cache_key()));
+}
+
+std::filesystem::path cache_directory(){
+    if(auto* directory = std::getenv("EDDIC_CACHE_DIR")){
+        return directory;
+    } else if(auto* directory = std::getenv("XDG_CACHE_HOME")){
+        return std::filesystem::path(directory) / "eddic";
+    } else if(auto* directory = std::getenv("HOME")){
+        return std::filesystem::path(directory) / ".cache" / "eddic";
+    }
+
+    return {};
+}
+
+//The entries are named <stem>-<build>-<key>.ast, with 8 and 16 hexadecimal digits
+std::filesystem::path cache_file(const std::string& file, uint64_t key){
+    auto directory = cache_directory();
+
+    if(directory.empty()){
+        return {};
+    }
+
+    char hex[26];
+    std::snprintf(hex, sizeof(hex), "%08x-%016llx", static_cast<unsigned int>(hash(cache_key())), static_cast<unsigned long long>(key));
+
+    return directory / (std::filesystem::path(file).stem().string() + "-" + hex + ".ast");
+}
+
+/*!
+ * Remove the other entries of the same file stem written by the same build of the compiler, for
+ * older versions of the file. The entries of the other builds are left alone, so that a debug and a
+ * release build do not evict each other. Different files sharing a stem evict each other, the cache
+ * holds at most one entry per stem and per build.
+ */
+void prune_entries(const std::filesystem::path& entry){
+    auto name = entry.filename().string();
+
+    //The prefix is the stem and the build id: <stem>-01234567-
+    auto prefix = name.substr(0, name.size() - std::string_view("0123456789abcdef.ast").size());
+
+    auto is_entry = [&prefix](const std::string& other){
+        if(other.size() != prefix.size() + 20 || other.compare(0, prefix.size(), prefix) != 0 || !other.ends_with(".ast")){
+            return false;
+        }
+
+        for(std::size_t i = prefix.size(); i < prefix.size() + 16; ++i){
+            if(!std::isxdigit(static_cast<unsigned char>(other[i]))){
+                return false;
+            }
+        }
+
+        return true;
+    };
+
+    std::error_code error;
+    for(auto& other : std::filesystem::directory_iterator(entry.parent_path(), error)){
+        auto other_name = other.path().filename().string();
+
+        if(other_name != name && is_entry(other_name)){
+            std::filesystem::remove(other.path(), error);
+        }
+    }
+}
+
+struct Writer {
+    std::string& out;
+
+    void bytes(const void* data, std::size_t size){
+        out.append(static_cast<const char*>(data), size);
+    }
+
+    template<typename T>
+    void position(const T& value){
+        if constexpr (std::is_base_of_v<x3::position_tagged, T>){
+            write(value.id_first);
+            write(value.id_last);
+        }
+
+        if constexpr (std::is_base_of_v<x3::file_position_tagged, T>){
+            write(value.id_file != -1);
+        }
+    }
+
+    template<typename T>
+    void write(const T& value){
+        if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>){
+            bytes(&value, sizeof(T));
+        } else if constexpr (std::is_same_v<T, std::string>){
+            write(value.size());
+            bytes(value.data(), value.size());
+        } else if constexpr (std::is_same_v<T, x3::unused_type>){
+            //Nothing to write
+        } else if constexpr (is_vector<T>::value){
+            write(value.size());
+
+            for(auto& element : value){
+                write(element);
+            }
+        } else if constexpr (is_optional<T>::value){
+            write(static_cast<bool>(value));
+
+            if(value){
+                write(*value);
+            }
+        } else if constexpr (is_forward_ast<T>::value){
+            write(value.get());
+        } else if constexpr (is_variant<T>::value){
+            write(static_cast<std::size_t>(value.get().which()));
+            boost::apply_visitor([this](const auto& alternative){ write(alternative); }, value.get());
+        } else if constexpr (std::is_same_v<T, ast::Scope>){
+            write(value.instructions);
+        } else if constexpr (boost::fusion::traits::is_sequence<T>::value){
+            position(value);
+            boost::fusion::for_each(value, [this](const auto& member){ write(member); });
+        } else {
+            static_assert(std::is_empty_v<T>, "Unhandled AST type in the cache");
+        }
+    }
+};
+
+struct Reader {
+    const char* current;
+    const char* end;
+    int file;
+    std::size_t positions = 0;
+    bool failed = false;
+
+    void bytes(void* data, std::size_t size){
+        if(failed || static_cast<std::size_t>(end - current) < size){
+            failed = true;
+            return;
+        }
+
+        std::memcpy(data, current, size);
+        current += size;
+    }
+
+    //Read the size of a sequence, it cannot be larger than the remaining data
+    std::size_t length(){
+        std::size_t size = 0;
+        read(size);
+
+        if(size > static_cast<std::size_t>(end - current)){
+            failed = true;
+            return 0;
+        }
+
+        return size;
+    }
+
+    void id(int& value){
+        read(value);
+
+        if(value < -1 || (value >= 0 && static_cast<std::size_t>(value) >= positions)){
+            failed = true;
+        }
+    }
+
+    template<typename T>
+    void position(T& value){
+        if constexpr (std::is_base_of_v<x3::position_tagged, T>){
+            id(value.id_first);
+            id(value.id_last);
+        }
+
+        if constexpr (std::is_base_of_v<x3::file_position_tagged, T>){
+            bool tagged = false;
+            read(tagged);
+            value.id_file = tagged ? file : -1;
+        }
+    }
+
+    template<typename Alternative, typename Variant>
+    void read_alternative(Variant& variant){
+        Alternative value;
+        read(value);
+        variant = std::move(value);
+    }
+
+    template<typename... Alternatives>
+    void read_variant(x3::variant<Alternatives...>& variant){
+        std::size_t which = 0;
+        read(which);
+
+        std::size_t index = 0;
+        bool found = ((which == index++ && (read_alternative<Alternatives>(variant), true)) || ...);
+
+        if(!found){
+            failed = true;
+        }
+    }
+
+    template<typename T>
+    void read(T& value){
+        if(failed){
+            return;
+        }
+
+        if constexpr (std::is_same_v<T, bool>){
+            unsigned char byte = 0;
+            bytes(&byte, 1);
+            failed |= byte > 1;
+            value = byte;
+        } else if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>){
+            bytes(&value, sizeof(T));
+        } else if constexpr (std::is_same_v<T, std::string>){
+            auto size = length();
+
+            if(!failed){
+                value.assign(current, size);
+                current += size;
+            }
+        } else if constexpr (std::is_same_v<T, x3::unused_type>){
+            //Nothing to read
+        } else if constexpr (is_vector<T>::value){
+            value.resize(length());
+
+            for(auto& element : value){
+                read(element);
+            }
+        } else if constexpr (is_optional<T>::value){
+            bool present = false;
+            read(present);
+
+            if(present){
+                typename T::value_type element;
+                read(element);
+                value = std::move(element);
+            }
+        } else if constexpr (is_forward_ast<T>::value){
+            read(value.get());
+        } else if constexpr (is_variant<T>::value){
+            read_variant(value);
+        } else if constexpr (std::is_same_v<T, ast::Scope>){
+            read(value.instructions);
+        } else if constexpr (boost::fusion::traits::is_sequence<T>::value){
+            position(value);
+            boost::fusion::for_each(value, [this](auto& member){ read(member); });
+        } else {
+            static_assert(std::is_empty_v<T>, "Unhandled AST type in the cache");
+        }
+    }
+};
+
+} //end of anonymous namespace
+
+bool parser_x3::load_cached_ast(const std::string& file, int id_file, std::string_view contents, ast::SourceFile& program, GlobalContext& context){
+    auto key = key_hash(contents);
+    auto path = cache_file(file, key);
+
+    if(path.empty()){
+        return false;
+    }
+
+    mapped_file data(path.string());
+
+    if(!data.valid()){
+        return false;
+    }
+
+    Reader reader{data.begin(), data.end(), id_file};
+
+    char header[sizeof(magic)];
+    reader.bytes(header, sizeof(header));
+
+    std::string entry_key;
+    uint64_t entry_hash = 0;
+    std::size_t entry_size = 0;
+    uint64_t checksum = 0;
+
+    reader.read(entry_key);
+    reader.read(entry_hash);
+    reader.read(entry_size);
+    reader.read(checksum);
+
+    //Guard against collisions, against files from other builds and against corrupted files
+    if(reader.failed || std::memcmp(header, magic, sizeof(magic)) != 0 || entry_key != cache_key() || entry_hash != key || entry_size != contents.size()){
+        return false;
+    }
+
+    if(hash({reader.current, static_cast<std::size_t>(reader.end - reader.current)}) != checksum){
+        return false;
+    }
+
+    std::vector<std::size_t> positions;
+    reader.read(positions);
+
+    for(auto offset : positions){
+        if(offset > contents.size()){
+            return false;
+        }
+    }
+
+    reader.positions = positions.size();
+
+    ast::SourceFile cached(program.context);
+    reader.position(cached);
+
+    auto blocks = reader.length();
+    for(std::size_t i = 0; i < blocks && !reader.failed; ++i){
+        cached.emplace_back();
+        reader.read(cached.back());
+    }
+
+    if(reader.failed || reader.current != reader.end){
+        return false;
+    }
+
+    context.error_handler.restore_positions(id_file, positions);
+
+    static_cast<x3::file_position_tagged&>(program) = cached;
+    for(auto& block : cached){
+        program.push_back(std::move(block));
+    }
+
+    return true;
+}
+
+void parser_x3::store_cached_ast(const std::string& file, int id_file, std::string_view contents, const ast::SourceFile& program, GlobalContext& context){
+    auto key = key_hash(contents);
+    auto path = cache_file(file, key);
+
+    if(path.empty()){
+        return;
+    }
+
+    std::string body;
+    Writer body_writer{body};
+
+    body_writer.write(context.error_handler.positions(id_file));
+
+    body_writer.position(program);
+
+    body_writer.write(program.size());
+    for(auto& block : program){
+        body_writer.write(block);
+    }
+
+    std::string data;
+    Writer writer{data};
+
+    writer.bytes(magic, sizeof(magic));
+    writer.write(cache_key());
+    writer.write(key);
+    writer.write(contents.size());
+    writer.write(hash(body));
+    writer.bytes(body.data(), body.size());
+
+    std::error_code error;
+    std::filesystem::create_directories(path.parent_path(), error);
+
+    if(error){
+        return;
+    }
+
+    //Several compilers can fill the cache at the same time, the entry is renamed once complete
+    auto temporary = path;
+    temporary += "." + std::to_string(getpid()) + ".tmp";
+
+    {
+        std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+        stream.write(data.data(), data.size());
+
+        if(!stream){
+            std::filesystem::remove(temporary, error);
+            return;
+        }
+    }
+
+    std::filesystem::rename(temporary, path, error);
+
+    if(error){
+        std::filesystem::remove(temporary, error);
+        return;
+    }
+
+    prune_entries(path);
+}
@@ -1,11 +1,30 @@
 #include "parser_x3/error_handling.hpp"
 #include "SemanticalException.hpp"
 
+int x3_grammar::global_error_handler::register_handler(iterator_type it, iterator_type end, std::string file){
+    std::lock_guard<std::mutex> lock(mutex);
+
+    error_handlers.push_back(std::make_unique<error_handler_type>(it, end, std::cerr, std::move(file)));
+
+    return error_handlers.size() - 1;
+}
+
+x3_grammar::error_handler_type& x3_grammar::global_error_handler::handler(int file){
+    std::lock_guard<std::mutex> lock(mutex);
+
+    //The handlers are never moved, the reference stays valid when other files are registered
+    return *error_handlers[file];
+}
+
+void x3_grammar::file_error_handler::operator()(iterator_type err_pos, const std::string& message){
+    handler(errors, err_pos, message);
+}
+
 void x3_grammar::global_error_handler::operator()(const boost::spirit::x3::file_position_tagged& t, const std::string& message){
     if(t.id_file == -1){
         std::cerr << "Unnotated AST node: " << message << std::endl;
     } else {
-        error_handlers[t.id_file](t, message);
+        handler(t.id_file)(t, message);
     }
 }
 
@@ -13,18 +32,33 @@ std::string x3_grammar::global_error_handler::to_string(const boost::spirit::x3:
     if(t.id_file == -1){
         return std::string("Unnotated AST node: ") + message;
     } else {
-        return error_handlers[t.id_file].to_string(t, message);
+        return handler(t.id_file).to_string(t, message);
     }
 }
 
-void x3_grammar::global_error_handler::operator()(iterator_type err_pos, const std::string& message){
-    current()(err_pos, message);
+void x3_grammar::global_error_handler::semantical_exception(const std::string& message, const boost::spirit::x3::file_position_tagged& t){
+    throw eddic::SemanticalException(to_string(t, message));
 }
 
-void x3_grammar::global_error_handler::operator()(iterator_type err_pos, iterator_type err_last, const std::string& message){
-    current()(err_pos, err_last, message);
+std::vector<std::size_t> x3_grammar::global_error_handler::positions(int file){
+    auto& file_handler = handler(file);
+
+    std::vector<std::size_t> offsets;
+    offsets.reserve(file_handler.positions().size());
+
+    for(auto& position : file_handler.positions()){
+        offsets.push_back(position - file_handler.first());
+    }
+
+    return offsets;
 }
 
-void x3_grammar::global_error_handler::semantical_exception(const std::string& message, const boost::spirit::x3::file_position_tagged& t){
-    throw eddic::SemanticalException(to_string(t, message));
+void x3_grammar::global_error_handler::restore_positions(int file, const std::vector<std::size_t>& offsets){
+    auto& file_handler = handler(file);
+
+    //The positions are always tagged by pair (first and last)
+    boost::spirit::x3::position_tagged tag;
+    for(std::size_t i = 0; i + 1 < offsets.size(); i += 2){
+        file_handler.tag(tag, file_handler.first() + offsets[i], file_handler.first() + offsets[i + 1]);
+    }
 }
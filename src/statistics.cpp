@@ -10,14 +10,26 @@
 using namespace eddic;
 
 void statistics::inc_counter(const std::string& a){
+    std::lock_guard<std::mutex> lock(mutex);
+
     ++counters[a];
 }
 
+void statistics::inc_counter(const std::string& a, std::size_t value){
+    std::lock_guard<std::mutex> lock(mutex);
+
+    counters[a] += value;
+}
+
 std::size_t statistics::counter(const std::string& a) const {
+    std::lock_guard<std::mutex> lock(mutex);
+
     return counters.at(a);
 }
 
 std::size_t statistics::counter_safe(const std::string& a) const {
+    std::lock_guard<std::mutex> lock(mutex);
+
     if (counters.contains(a)) {
         return counters.at(a);
     }
@@ -7,19 +7,68 @@
 
 #include <iostream>
 #include <iomanip>
+#include <fstream>
 #include <vector>
 #include <algorithm>
 
 #include "timing.hpp"
+#include "statistics.hpp"
 
 using namespace eddic;
 
-timing_timer::timing_timer(timing_system& system, const std::string& name) : system(system), name(name) {
+timing_timer::timing_timer(timing_system& system, const std::string& name) : system(system), name(name), start(Clock::now()) {
+    //Nothing
+}
+
+timing_timer::timing_timer(timing_system& system, const std::string& name, const std::string& detail) : system(system), name(name), detail(detail), start(Clock::now()) {
     //Nothing
 }
 
 timing_timer::~timing_timer(){
-    system.register_timing(name, timer.elapsed());
+    auto end = Clock::now();
+
+    system.register_timing(name, std::chrono::duration<double, std::milli>(end - start).count());
+
+    if(system.tracing()){
+        system.register_event(std::move(name), std::move(detail), start, end);
+    }
+}
+
+trace_timer::trace_timer(timing_system& system, const std::string& name, const std::string& detail) : system(system), start(Clock::now()) {
+    if(system.tracing()){
+        this->name = name;
+        this->detail = detail;
+    }
+}
+
+trace_timer::~trace_timer(){
+    if(system.tracing()){
+        system.register_event(std::move(name), std::move(detail), start, Clock::now());
+    }
+}
+
+namespace {
+
+void write_json_string(std::ostream& stream, const std::string& value){
+    stream << '"';
+
+    for(char c : value){
+        if(c == '"' || c == '\\'){
+            stream << '\\' << c;
+        } else if(static_cast<unsigned char>(c) < 0x20){
+            stream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec << std::setfill(' ');
+        } else {
+            stream << c;
+        }
+    }
+
+    stream << '"';
+}
+
+} //end of anonymous namespace
+
+timing_system::timing_system() : epoch(Clock::now()) {
+    //Nothing
 }
 
 bool is_aggregate(const std::string& name){
@@ -64,6 +113,86 @@ void timing_system::display(){
     }
 }
 
+timing_system::iterator timing_system::begin() const {
+    return timings.cbegin();
+}
+
+timing_system::iterator timing_system::end() const {
+    return timings.cend();
+}
+
 void timing_system::register_timing(std::string name, double time){
+    std::lock_guard<std::mutex> lock(mutex);
+
     timings[name] += time;
 }
+
+void timing_system::enable_trace(){
+    trace = true;
+}
+
+bool timing_system::tracing() const {
+    return trace;
+}
+
+void timing_system::register_event(std::string name, std::string detail, Clock::time_point start, Clock::time_point end){
+    auto begin = std::chrono::duration<double, std::micro>(start - epoch).count();
+    auto duration = std::chrono::duration<double, std::micro>(end - start).count();
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    //The threads are numbered in the order of their first event
+    auto thread = threads.emplace(std::this_thread::get_id(), threads.size()).first->second;
+
+    events.push_back({std::move(name), std::move(detail), thread, begin, duration});
+}
+
+void timing_system::write_trace(const std::string& file, const statistics& stats){
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::ofstream stream(file);
+
+    if(!stream){
+        std::cerr << "Cannot write the trace to " << file << std::endl;
+        return;
+    }
+
+    stream << std::fixed << std::setprecision(3);
+
+    stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool first = true;
+
+    //The complete events are nested by the viewers according to their time range on each thread
+    for(auto& event : events){
+        stream << (first ? "\n" : ",\n");
+        first = false;
+
+        stream << "{\"name\":";
+        write_json_string(stream, event.name);
+        stream << ",\"cat\":\"eddic\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread;
+        stream << ",\"ts\":" << event.start << ",\"dur\":" << event.duration;
+
+        if(!event.detail.empty()){
+            stream << ",\"args\":{\"detail\":";
+            write_json_string(stream, event.detail);
+            stream << "}";
+        }
+
+        stream << "}";
+    }
+
+    stream << "\n],\"otherData\":{";
+
+    first = true;
+
+    for(auto& counter : stats){
+        stream << (first ? "\n" : ",\n");
+        first = false;
+
+        write_json_string(stream, counter.first);
+        stream << ":" << counter.second;
+    }
+
+    stream << "\n}}" << std::endl;
+}
@@ -0,0 +1,69 @@
+//=======================================================================
+// Copyright Baptiste Wicht 2011-2016.
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#include "cpp_utils/assert.hpp"
+
+#include "variable_ref.hpp"
+#include "Variable.hpp"
+
+using namespace eddic;
+
+variable_table* variable_table::current_table = nullptr;
+
+variable_table::variable_table(){
+    //The id 0 is the null reference
+    add(nullptr);
+}
+
+variable_table::~variable_table(){
+    cpp_assert(current_table != this, "The current variable table cannot be destroyed");
+}
+
+uint32_t variable_table::add(const std::shared_ptr<Variable>& variable){
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto id = next++;
+
+    auto n = static_cast<uint64_t>(id) + base;
+    auto chunk = std::bit_width(n) - base_bits - 1;
+
+    if(!chunks[chunk]){
+        chunks[chunk] = std::make_unique<std::shared_ptr<Variable>[]>(base << chunk);
+    }
+
+    chunks[chunk][n - (base << chunk)] = variable;
+
+    if(variable){
+        variable->set_id(id);
+    }
+
+    return id;
+}
+
+std::size_t variable_table::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    return next;
+}
+
+variable_table::scope::scope(variable_table& table) : table(table), previous(current_table) {
+    current_table = &table;
+}
+
+variable_table::scope::~scope(){
+    cpp_assert(current_table == &table, "The variable table scopes must be nested");
+
+    current_table = previous;
+}
+
+variable_ref::variable_ref(const std::shared_ptr<Variable>& variable) : _id(variable ? variable->id() : 0) {
+    cpp_assert(!variable || _id, "The variable has not been added to the variable table");
+}
+
+std::ostream& eddic::operator<<(std::ostream& stream, variable_ref variable){
+    return stream << variable.shared();
+}
@@ -0,0 +1,240 @@
+//=======================================================================
+// Copyright Baptiste Wicht 2011-2016.
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include <elf.h>
+#include <unistd.h>
+
+#include "asm/Encoder.hpp"
+#include "asm/ElfWriter.hpp"
+
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace eddic;
+
+namespace {
+
+typedef std::vector<uint8_t> bytes_t;
+
+bytes_t encode(Platform platform, const std::string& assembly){
+    as::ObjectCode object;
+    std::string error;
+
+    BOOST_REQUIRE_MESSAGE(as::encode(platform, assembly, object, error), error);
+
+    return object.text;
+}
+
+/*
+ * The expected bytes are the ones assembled by nasm for the same line.
+ */
+void check_encoding(Platform platform, const std::string& assembly, const bytes_t& expected){
+    auto text = encode(platform, assembly);
+
+    BOOST_CHECK_MESSAGE(text == expected, "Wrong encoding of " << assembly);
+}
+
+void check_64(const std::string& assembly, const bytes_t& expected){
+    check_encoding(Platform::INTEL_X86_64, assembly, expected);
+}
+
+void check_32(const std::string& assembly, const bytes_t& expected){
+    check_encoding(Platform::INTEL_X86, assembly, expected);
+}
+
+/*
+ * Encode the assembly, write it as an executable and read the executable back.
+ */
+bytes_t link(Platform platform, const std::string& assembly){
+    as::ObjectCode object;
+    std::string error;
+
+    BOOST_REQUIRE_MESSAGE(as::encode(platform, assembly, object, error), error);
+
+    char path[] = "/tmp/eddic_elf_XXXXXX";
+    int fd = mkstemp(path);
+    BOOST_REQUIRE(fd >= 0);
+    close(fd);
+
+    BOOST_REQUIRE_MESSAGE(as::write_elf(platform, object, path, error), error);
+
+    std::ifstream stream(path, std::ios::binary);
+    bytes_t executable((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+    remove(path);
+
+    return executable;
+}
+
+template<typename T>
+T read(const bytes_t& executable, std::size_t offset){
+    BOOST_REQUIRE(offset + sizeof(T) <= executable.size());
+
+    T value;
+    std::memcpy(&value, executable.data() + offset, sizeof(T));
+    return value;
+}
+
+//_start calls f, f loads the address of value and returns
+const std::string program =
+    "section .text\n"
+    "_start:\n"
+    "call f\n"
+    "ret\n"
+    "f:\n"
+    "mov eax, value\n"
+    "ret\n"
+    "section .data\n"
+    "value dd 42\n";
+
+const bytes_t program_text = {0xE8, 0x01, 0x00, 0x00, 0x00, 0xC3, 0xB8};
+
+} //end of anonymous namespace
+
+BOOST_AUTO_TEST_CASE( encoder_modrm_sib ){
+    //rsp and r12 as base need a SIB byte
+    check_64("mov rax, [rsp]", {0x48, 0x8B, 0x04, 0x24});
+    check_64("mov rax, [r12]", {0x49, 0x8B, 0x04, 0x24});
+    check_64("mov rax, [rsp+8]", {0x48, 0x8B, 0x44, 0x24, 0x08});
+    check_32("mov eax, [esp]", {0x8B, 0x04, 0x24});
+
+    //rbp and r13 as base cannot use mod=0, they need a zero displacement
+    check_64("mov rax, [rbp]", {0x48, 0x8B, 0x45, 0x00});
+    check_64("mov rax, [r13]", {0x49, 0x8B, 0x45, 0x00});
+    check_32("mov eax, [ebp]", {0x8B, 0x45, 0x00});
+    check_32("mov eax, [ebp-4]", {0x8B, 0x45, 0xFC});
+
+    //Scaled index, with a 32-bit displacement
+    check_64("mov rax, [rbx+rcx*4]", {0x48, 0x8B, 0x04, 0x8B});
+    check_64("mov rax, [rbp+r13*2+256]", {0x4A, 0x8B, 0x84, 0x6D, 0x00, 0x01, 0x00, 0x00});
+    check_32("mov eax, [ebx+ecx*8+4]", {0x8B, 0x44, 0xCB, 0x04});
+}
+
+BOOST_AUTO_TEST_CASE( encoder_rex ){
+    check_64("mov r8d, eax", {0x41, 0x89, 0xC0});
+    check_64("mov r8b, al", {0x41, 0x88, 0xC0});
+    check_64("add rax, 1", {0x48, 0x83, 0xC0, 0x01});
+    check_64("push r12", {0x41, 0x54});
+    check_64("mov qword [rbp-8], 5", {0x48, 0xC7, 0x45, 0xF8, 0x05, 0x00, 0x00, 0x00});
+
+    //The mandatory prefix comes before the REX prefix
+    check_64("movsd xmm1, [r12+16]", {0xF2, 0x41, 0x0F, 0x10, 0x4C, 0x24, 0x10});
+
+    //No REX prefix in 32 bits
+    check_32("push ebx", {0x53});
+}
+
+BOOST_AUTO_TEST_CASE( encoder_fixups ){
+    as::ObjectCode object;
+    std::string error;
+
+    BOOST_REQUIRE_MESSAGE(as::encode(Platform::INTEL_X86_64, "call f\njmp f\nje f\nmov rax, f\nf:\nret\n", object, error), error);
+
+    bytes_t expected = {
+        0xE8, 0x00, 0x00, 0x00, 0x00,
+        0xE9, 0x00, 0x00, 0x00, 0x00,
+        0x0F, 0x84, 0x00, 0x00, 0x00, 0x00,
+        0x48, 0xB8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0xC3};
+
+    BOOST_CHECK(object.text == expected);
+
+    BOOST_REQUIRE_EQUAL(object.fixups.size(), 4);
+
+    std::size_t offsets[] = {1, 6, 12, 18};
+    as::FixupKind kinds[] = {as::FixupKind::RELATIVE_32, as::FixupKind::RELATIVE_32, as::FixupKind::RELATIVE_32, as::FixupKind::ABSOLUTE_64};
+
+    for(std::size_t i = 0; i < 4; ++i){
+        BOOST_CHECK_EQUAL(object.fixups[i].offset, offsets[i]);
+        BOOST_CHECK(object.fixups[i].kind == kinds[i]);
+        BOOST_CHECK_EQUAL(object.fixups[i].symbol, "f");
+    }
+
+    BOOST_REQUIRE(object.symbols.count("f"));
+    BOOST_CHECK_EQUAL(object.symbols["f"].offset, 26);
+}
+
+BOOST_AUTO_TEST_CASE( elf_64 ){
+    auto executable = link(Platform::INTEL_X86_64, program);
+
+    auto header = read<Elf64_Ehdr>(executable, 0);
+
+    BOOST_CHECK(std::memcmp(header.e_ident, ELFMAG, SELFMAG) == 0);
+    BOOST_CHECK_EQUAL(header.e_ident[EI_CLASS], ELFCLASS64);
+    BOOST_CHECK_EQUAL(header.e_ident[EI_DATA], ELFDATA2LSB);
+    BOOST_CHECK_EQUAL(header.e_type, ET_EXEC);
+    BOOST_CHECK_EQUAL(header.e_machine, EM_X86_64);
+    BOOST_CHECK_EQUAL(header.e_phoff, sizeof(Elf64_Ehdr));
+    BOOST_CHECK_EQUAL(header.e_phentsize, sizeof(Elf64_Phdr));
+    BOOST_REQUIRE_EQUAL(header.e_phnum, 2);
+    BOOST_CHECK_EQUAL(header.e_shnum, 0);
+
+    auto text = read<Elf64_Phdr>(executable, header.e_phoff);
+    auto data = read<Elf64_Phdr>(executable, header.e_phoff + sizeof(Elf64_Phdr));
+
+    //The text segment starts with the headers, _start is the first instruction
+    BOOST_CHECK_EQUAL(text.p_type, PT_LOAD);
+    BOOST_CHECK_EQUAL(text.p_flags, PF_R | PF_X);
+    BOOST_CHECK_EQUAL(text.p_offset, 0);
+    BOOST_CHECK_EQUAL(text.p_vaddr, 0x400000);
+    BOOST_CHECK_EQUAL(header.e_entry, text.p_vaddr + sizeof(Elf64_Ehdr) + 2 * sizeof(Elf64_Phdr));
+
+    BOOST_CHECK_EQUAL(data.p_type, PT_LOAD);
+    BOOST_CHECK_EQUAL(data.p_flags, PF_R | PF_W);
+    BOOST_CHECK_EQUAL(data.p_filesz, 4);
+    BOOST_CHECK_EQUAL(data.p_offset % data.p_align, data.p_vaddr % data.p_align);
+    BOOST_CHECK(data.p_vaddr >= text.p_vaddr + text.p_memsz);
+
+    //The rel32 of the call and the address of the data are resolved
+    auto code = header.e_entry - text.p_vaddr;
+    BOOST_CHECK(bytes_t(executable.begin() + code, executable.begin() + code + program_text.size()) == program_text);
+    BOOST_CHECK_EQUAL(read<uint32_t>(executable, code + program_text.size()), data.p_vaddr);
+    BOOST_CHECK_EQUAL(read<uint32_t>(executable, data.p_offset), 42);
+}
+
+BOOST_AUTO_TEST_CASE( elf_32 ){
+    auto executable = link(Platform::INTEL_X86, program);
+
+    auto header = read<Elf32_Ehdr>(executable, 0);
+
+    BOOST_CHECK(std::memcmp(header.e_ident, ELFMAG, SELFMAG) == 0);
+    BOOST_CHECK_EQUAL(header.e_ident[EI_CLASS], ELFCLASS32);
+    BOOST_CHECK_EQUAL(header.e_type, ET_EXEC);
+    BOOST_CHECK_EQUAL(header.e_machine, EM_386);
+    BOOST_CHECK_EQUAL(header.e_phoff, sizeof(Elf32_Ehdr));
+    BOOST_CHECK_EQUAL(header.e_phentsize, sizeof(Elf32_Phdr));
+    BOOST_REQUIRE_EQUAL(header.e_phnum, 2);
+
+    auto text = read<Elf32_Phdr>(executable, header.e_phoff);
+    auto data = read<Elf32_Phdr>(executable, header.e_phoff + sizeof(Elf32_Phdr));
+
+    BOOST_CHECK_EQUAL(text.p_flags, PF_R | PF_X);
+    BOOST_CHECK_EQUAL(text.p_vaddr, 0x8048000);
+    BOOST_CHECK_EQUAL(header.e_entry, text.p_vaddr + sizeof(Elf32_Ehdr) + 2 * sizeof(Elf32_Phdr));
+
+    BOOST_CHECK_EQUAL(data.p_flags, PF_R | PF_W);
+    BOOST_CHECK_EQUAL(data.p_offset % data.p_align, data.p_vaddr % data.p_align);
+
+    auto code = header.e_entry - text.p_vaddr;
+    BOOST_CHECK(bytes_t(executable.begin() + code, executable.begin() + code + program_text.size()) == program_text);
+    BOOST_CHECK_EQUAL(read<uint32_t>(executable, code + program_text.size()), data.p_vaddr);
+    BOOST_CHECK_EQUAL(read<uint32_t>(executable, data.p_offset), 42);
+}
+
+BOOST_AUTO_TEST_CASE( elf_undefined_symbol ){
+    as::ObjectCode object;
+    std::string error;
+
+    BOOST_REQUIRE(as::encode(Platform::INTEL_X86_64, "_start:\ncall g\n", object, error));
+    BOOST_CHECK(!as::write_elf(Platform::INTEL_X86_64, object, "/tmp/eddic_elf_undefined", error));
+    BOOST_CHECK_EQUAL(error, "The symbol g is not defined");
+}
@@ -10,6 +10,8 @@
 #include "Function.hpp"
 
 #include "mtac/Function.hpp"
+#include "mtac/fingerprint.hpp"
+#include "mtac/block_map.hpp"
 
 #define BOOST_TEST_DYN_LINK
 #include <boost/test/unit_test.hpp>
@@ -165,3 +167,66 @@ BOOST_AUTO_TEST_CASE( bb_at ){
     BOOST_CHECK(it_end == it);
     BOOST_CHECK(it_at == it_end);
 }
+
+BOOST_AUTO_TEST_CASE( fingerprint_statements ){
+    Function definition(nullptr, "test_function", "test_function");
+    auto function = std::make_shared<mtac::Function>(nullptr, "test_function", definition);
+
+    function->create_entry_bb();
+    auto bb = function->append_bb();
+    function->create_exit_bb();
+
+    bb->emplace_back(mtac::Operator::NOP);
+    bb->emplace_back(mtac::Operator::RETURN, 1);
+
+    mtac::purity_summary purity;
+
+    auto fingerprint = mtac::fingerprint(*function, purity);
+
+    BOOST_CHECK(fingerprint == mtac::fingerprint(*function, purity));
+
+    //Only the statements are compared, not their uids
+    bb->statements.front() = mtac::Quadruple(mtac::Operator::NOP);
+
+    BOOST_CHECK(fingerprint == mtac::fingerprint(*function, purity));
+
+    bb->statements.back().arg1 = mtac::Argument(2);
+
+    BOOST_CHECK(!(fingerprint == mtac::fingerprint(*function, purity)));
+
+    bb->statements.back().arg1 = mtac::Argument(1);
+    bb->statements.front().op = mtac::Operator::RETURN;
+
+    BOOST_CHECK(!(fingerprint == mtac::fingerprint(*function, purity)));
+}
+
+BOOST_AUTO_TEST_CASE( bb_ids ){
+    Function definition(nullptr, "test_function", "test_function");
+    auto function = std::make_shared<mtac::Function>(nullptr, "test_function", definition);
+
+    function->create_entry_bb();
+    auto bb1 = function->append_bb();
+    auto bb2 = function->append_bb();
+    function->create_exit_bb();
+
+    BOOST_CHECK_EQUAL(function->bb_ids(), 4u);
+
+    BOOST_CHECK_EQUAL(function->entry_bb()->id, 0u);
+    BOOST_CHECK_EQUAL(bb1->id, 1u);
+    BOOST_CHECK_EQUAL(bb2->id, 2u);
+    BOOST_CHECK_EQUAL(function->exit_bb()->id, 3u);
+
+    mtac::block_map<int> values(function->bb_ids());
+    values[bb2] = 2;
+
+    BOOST_CHECK(!values.contains(bb1));
+    BOOST_CHECK(values.find(bb2) && *values.find(bb2) == 2);
+
+    //The ids are never reused, the per-block data of a removed block cannot be given to a new block
+    function->remove(bb2);
+    auto bb3 = function->new_bb();
+
+    BOOST_CHECK_EQUAL(bb3->id, 4u);
+    BOOST_CHECK_EQUAL(function->bb_ids(), 5u);
+    BOOST_CHECK(!values.contains(bb3));
+}
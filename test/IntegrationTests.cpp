@@ -8,6 +8,12 @@
 #include <string>
 #include <iostream>
 #include <memory>
+#include <filesystem>
+#include <fstream>
+#include <cstdlib>
+#include <sstream>
+#include <optional>
+#include <stdexcept>
 
 #include "boost_cfg.hpp"
 #include <boost/algorithm/string.hpp>
@@ -23,6 +29,10 @@
 
 #include "mtac/Program.hpp"
 
+#include "ltac/PseudoRegister.hpp"
+#include "ltac/PseudoFloatRegister.hpp"
+#include "ltac/interference_graph.hpp"
+
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MODULE eddic_test_suite
 #include <boost/test/unit_test.hpp>
@@ -122,20 +132,24 @@ std::vector<std::string> split(std::string value){
     return parts;
 }
 
-std::string get_output(const std::string& file, const std::string& param1, const std::string& param2, const std::string& param3){
-    auto configuration = parse_options("test/cases/" + file, param3, {param1, param2});
+std::string get_output(const std::string& file, const std::string& output, std::vector<std::string> params){
+    auto configuration = parse_options("test/cases/" + file, output, params);
 
     eddic::Compiler compiler;
     int code = compiler.compile("test/cases/" + file, configuration);
 
     BOOST_REQUIRE_EQUAL (code, 0);
 
-    std::string out = eddic::execCommand("./" + param3);
-    remove("./" + param3);
+    std::string out = eddic::execCommand("./" + output);
+    remove("./" + output);
 
     return out;
 }
 
+std::string get_output(const std::string& file, const std::string& param1, const std::string& param2, const std::string& param3){
+    return get_output(file, param3, {param1, param2});
+}
+
 template<typename T>
 void validate_output(std::vector<std::string>& parts, int index, T first){
     auto value = boost::lexical_cast<T>(parts[index]);
@@ -180,6 +194,52 @@ void validate(const std::string& file, T... arguments){
     validate_output(file, "--64", "--O3", file + ".6.out", arguments...);
 }
 
+/*
+ * A temporary cache directory, used by the compilations for its lifetime.
+ */
+struct cache_directory {
+    std::filesystem::path path;
+    std::optional<std::string> previous;
+
+    cache_directory(){
+        char name[] = "/tmp/eddic_cache_XXXXXX";
+        if(!mkdtemp(name)){
+            throw std::runtime_error("Unable to create the cache directory");
+        }
+
+        path = name;
+        path /= "cache";
+
+        if(auto value = getenv("EDDIC_CACHE_DIR")){
+            previous = value;
+        }
+
+        setenv("EDDIC_CACHE_DIR", path.c_str(), 1);
+    }
+
+    ~cache_directory(){
+        if(previous){
+            setenv("EDDIC_CACHE_DIR", previous->c_str(), 1);
+        } else {
+            unsetenv("EDDIC_CACHE_DIR");
+        }
+
+        std::filesystem::remove_all(path.parent_path());
+    }
+
+    std::vector<std::filesystem::path> entries() const {
+        std::vector<std::filesystem::path> entries;
+
+        if(std::filesystem::exists(path)){
+            for(auto& entry : std::filesystem::directory_iterator(path)){
+                entries.push_back(entry.path());
+            }
+        }
+
+        return entries;
+    }
+};
+
 } // namespace
 
 #define assert_output_equals(file, output, param1, param2, param3) \
@@ -197,6 +257,9 @@ void validate(const std::string& file, T... arguments){
     assert_output_equals(file, output, "--64", "--O1", file ".5.out"); \
     assert_output_equals(file, output, "--64", "--O3", file ".6.out")
 
+//The tests never write into the cache of the user
+BOOST_GLOBAL_FIXTURE(cache_directory);
+
 /* Compiles all the applications */
 
 BOOST_AUTO_TEST_SUITE( ApplicationsSuite )
@@ -366,6 +429,14 @@ BOOST_AUTO_TEST_CASE( member_functions_param_stack ){
     assert_output("member_functions_param_stack.eddi", "0|1|100|180|260|");
 }
 
+BOOST_AUTO_TEST_CASE( allocator ){
+    assert_output("allocator.eddi", "18494|300|1600|5000|6600|0|100000|200000|300000|400000|");
+}
+
+BOOST_AUTO_TEST_CASE( imports ){
+    assert_output("imports.eddi", "22|42|21|");
+}
+
 BOOST_AUTO_TEST_CASE( memory ){
     assert_output("memory.eddi", "4|4|4|1|1|1|5|6|7|8|5|6|7|8|5|6|7|8|1|2|3|4|1|2|3|4|1|2|3|4|1|2|3|4|1|2|3|4|1|2|3|4|1|2|3|4|1|2|3|4|");
 }
@@ -478,6 +549,87 @@ BOOST_AUTO_TEST_CASE( struct_array ){
     assert_output("struct_arrays.eddi", "99|111|999|1111|99|111|999|1111|");
 }
 
+BOOST_AUTO_TEST_CASE( struct_padding ){
+    assert_output("struct_padding.eddi", "ab42c9|");
+}
+
+BOOST_AUTO_TEST_CASE( unbuffered_output ){
+    std::string expected;
+
+    for(int i = 0; i < 1000; ++i){
+        expected += std::to_string(i) + "|";
+    }
+
+    for(int i = 0; i < 500; ++i){
+        expected += "0123456789";
+    }
+
+    expected += "|";
+
+    for(int i = 0; i < 10; ++i){
+        expected += std::to_string(i) + "|";
+    }
+
+    for(std::string arch : {"--32", "--64"}){
+        auto buffered = get_output("print_heavy.eddi", "print_heavy.out", {arch, "--O2"});
+        auto unbuffered = get_output("print_heavy.eddi", "print_heavy.out", {arch, "--O2", "--unbuffered-output"});
+
+        BOOST_CHECK_EQUAL (expected, buffered);
+        BOOST_CHECK_EQUAL (buffered, unbuffered);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( struct_layout ){
+    assert_output("struct_layout.eddi", "a10Fx1.5000T0z|a11Tx1.5000F100z|a12Fx2.2500T200z|pq77r|st88u|");
+}
+
+BOOST_AUTO_TEST_CASE( struct_layout_reordered ){
+    for(std::string arch : {"--32", "--64"}){
+        for(std::string level : {"--O0", "--O1", "--O3"}){
+            auto out = get_output("struct_layout.eddi", "struct_layout.out", {arch, level, "--freorder-members"});
+            BOOST_CHECK_EQUAL ("a10Fx1.5000T0z|a11Tx1.5000F100z|a12Fx2.2500T200z|pq77r|st88u|", out);
+        }
+    }
+}
+
+std::string get_struct_layouts(std::vector<std::string> params){
+    params.push_back("--struct-layouts");
+    auto configuration = parse_options("test/cases/struct_layout.eddi", "struct_layout.out", params);
+
+    std::ostringstream out;
+    auto* buffer = std::cout.rdbuf(out.rdbuf());
+
+    eddic::Compiler compiler;
+    int code = compiler.compile("test/cases/struct_layout.eddi", configuration);
+
+    std::cout.rdbuf(buffer);
+    remove("./struct_layout.out");
+
+    BOOST_REQUIRE_EQUAL (code, 0);
+
+    return out.str();
+}
+
+BOOST_AUTO_TEST_CASE( struct_layouts_dump ){
+    auto layouts = get_struct_layouts({"--64", "--O2"});
+
+    BOOST_CHECK(layouts.find("struct U4Tiny (size 2, align 1)\n\t0\t1\tx\n\t1\t1\ty\n") != std::string::npos);
+    BOOST_CHECK(layouts.find("struct U6Packed (size 24, align 8)\n\t0\t2\tt\n\t8\t8\tn\n\t16\t1\tc\n") != std::string::npos);
+    BOOST_CHECK(layouts.find("struct U4Base (size 16, align 8)\n\t0\t8\tid\n\t8\t1\ttag\n\t9\t1\tflag\n") != std::string::npos);
+    BOOST_CHECK(layouts.find("struct U5Mixed (size 40, align 8)\n\t0\t8\tf\n\t8\t8\ti\n\t16\t1\tc\n\t17\t1\tb\n\t18\t1\td\n\t24\t16\t<parent U4Base>\n") != std::string::npos);
+
+    //The most aligned members are put first to remove the padding
+    auto reordered = get_struct_layouts({"--64", "--O2", "--freorder-members"});
+
+    BOOST_CHECK(reordered.find("struct U6Packed (size 16, align 8)\n\t0\t8\tn\n\t8\t2\tt\n\t10\t1\tc\n") != std::string::npos);
+
+    //32 bits
+    auto layouts_32 = get_struct_layouts({"--32", "--O2"});
+
+    BOOST_CHECK(layouts_32.find("struct U6Packed (size 12, align 4)\n\t0\t2\tt\n\t4\t4\tn\n\t8\t1\tc\n") != std::string::npos);
+    BOOST_CHECK(layouts_32.find("struct U5Mixed (size 20, align 4)\n\t0\t4\tf\n\t4\t4\ti\n\t8\t1\tc\n\t9\t1\tb\n\t10\t1\td\n\t12\t8\t<parent U4Base>\n") != std::string::npos);
+}
+
 BOOST_AUTO_TEST_CASE( swap ){
     assert_output("swap.eddi", "11|9|9|11|");
 }
@@ -612,6 +764,111 @@ BOOST_AUTO_TEST_CASE( std_vector ){
 
 BOOST_AUTO_TEST_SUITE_END()
 
+/* On-disk cache of the standard headers */
+
+BOOST_AUTO_TEST_SUITE(HeaderCacheSuite)
+
+BOOST_AUTO_TEST_CASE( header_cache_warm ){
+    cache_directory cache;
+
+    auto cold = get_output("stdlib_string.eddi", "header_cache.out", {"--64", "--O2"});
+    auto entries = cache.entries();
+
+    BOOST_REQUIRE(!entries.empty());
+
+    auto warm = get_output("stdlib_string.eddi", "header_cache.out", {"--64", "--O2"});
+
+    BOOST_CHECK_EQUAL (cold, warm);
+    BOOST_CHECK_EQUAL ("adsf|4|adsf|8|dddddddd|4|adsf|4|adsf|1|0|1|0|1|0|1|0|1|", warm);
+
+    //The warm compilation reused the entries
+    BOOST_CHECK(cache.entries() == entries);
+}
+
+BOOST_AUTO_TEST_CASE( header_cache_corrupted ){
+    cache_directory cache;
+
+    auto cold = get_output("stdlib_string.eddi", "header_cache.out", {"--64", "--O2"});
+    auto entries = cache.entries();
+
+    BOOST_REQUIRE(!entries.empty());
+
+    std::vector<std::uintmax_t> sizes;
+    for(auto& entry : entries){
+        sizes.push_back(std::filesystem::file_size(entry));
+    }
+
+    //Truncate the first entry and flip a byte in the middle of the others
+    std::filesystem::resize_file(entries[0], sizes[0] / 2);
+
+    for(std::size_t i = 1; i < entries.size(); ++i){
+        std::fstream stream(entries[i], std::ios::in | std::ios::out | std::ios::binary);
+        stream.seekg(sizes[i] / 2);
+        char c = stream.get();
+        stream.seekp(sizes[i] / 2);
+        stream.put(static_cast<char>(c ^ 0x5A));
+    }
+
+    auto fallback = get_output("stdlib_string.eddi", "header_cache.out", {"--64", "--O2"});
+
+    BOOST_CHECK_EQUAL (cold, fallback);
+
+    //The files have been parsed again and their entries rewritten
+    for(std::size_t i = 0; i < entries.size(); ++i){
+        BOOST_CHECK_EQUAL (std::filesystem::file_size(entries[i]), sizes[i]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( header_cache_builds ){
+    cache_directory cache;
+
+    get_output("stdlib_string.eddi", "header_cache.out", {"--64", "--O2"});
+    auto entries = cache.entries();
+
+    BOOST_REQUIRE(!entries.empty());
+
+    //For each entry <stem>-<build>-<key>.ast, an older entry of the same build and an entry of another build
+    std::vector<std::filesystem::path> same_build;
+    std::vector<std::filesystem::path> other_build;
+
+    for(auto& entry : entries){
+        auto name = entry.filename().string();
+        auto build = name.size() - std::string_view("01234567-0123456789abcdef.ast").size();
+
+        auto older = name;
+        older.replace(build + 9, 16, "0000000000000000");
+
+        auto other = name;
+        other[build] = other[build] == '0' ? '1' : '0';
+
+        std::filesystem::remove(entry);
+        std::ofstream(cache.path / older) << "older";
+        std::ofstream(cache.path / other) << "other";
+
+        same_build.push_back(cache.path / older);
+        other_build.push_back(cache.path / other);
+    }
+
+    get_output("stdlib_string.eddi", "header_cache.out", {"--64", "--O2"});
+
+    for(std::size_t i = 0; i < entries.size(); ++i){
+        BOOST_CHECK(std::filesystem::exists(entries[i]));
+        BOOST_CHECK(!std::filesystem::exists(same_build[i]));
+        BOOST_CHECK(std::filesystem::exists(other_build[i]));
+    }
+}
+
+BOOST_AUTO_TEST_CASE( header_cache_disabled ){
+    cache_directory cache;
+
+    auto out = get_output("stdlib_string.eddi", "header_cache.out", {"--64", "--O2", "--no-header-cache"});
+
+    BOOST_CHECK_EQUAL ("adsf|4|adsf|8|dddddddd|4|adsf|4|adsf|1|0|1|0|1|0|1|0|1|", out);
+    BOOST_CHECK(!std::filesystem::exists(cache.path));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
 /* Unit test for bug fixes regression */
 
 BOOST_AUTO_TEST_SUITE(BugFixesSuite)
@@ -651,6 +908,108 @@ void compute_stats_ltac(const std::string& file, const std::string & name, size_
     BOOST_TEST(program->context.stats().counter_safe(name) == value);
 }
 
+/*
+ * Compile the program instrumented, run it and compile it again with its profile.
+ */
+void validate_profile(const std::string& arch, std::size_t word){
+    char directory[] = "/tmp/eddic_profile_XXXXXX";
+    BOOST_REQUIRE(mkdtemp(directory));
+
+    //The quote must not end the name of the file in the generated assembly
+    std::string profile = std::string(directory) + "/pro\"file";
+
+    auto configuration = parse_options("test/cases/profile.eddi", "profile.out", {arch, "--O2", "--fprofile-generate=" + profile});
+
+    eddic::Compiler compiler;
+    BOOST_REQUIRE_EQUAL (compiler.compile("test/cases/profile.eddi", configuration), 0);
+
+    auto blocks = compiler.global_context().stats().counter_safe("profile_counters");
+    BOOST_REQUIRE(blocks > 0);
+
+    auto instrumented = eddic::execCommand("./profile.out");
+    remove("./profile.out");
+
+    BOOST_CHECK_EQUAL ("3117|2017|", instrumented);
+
+    //The counters are preceded by their number
+    BOOST_REQUIRE(std::filesystem::exists(profile));
+    BOOST_CHECK_EQUAL (std::filesystem::file_size(profile), (blocks + 1) * word);
+
+    configuration = parse_options("test/cases/profile.eddi", "profile.out", {arch, "--O2", "--fprofile-use=" + profile});
+
+    eddic::Compiler profiled_compiler;
+    BOOST_REQUIRE_EQUAL (profiled_compiler.compile("test/cases/profile.eddi", configuration), 0);
+
+    //The profile has been accepted
+    BOOST_CHECK_EQUAL (profiled_compiler.global_context().stats().counter_safe("profile_counters"), blocks);
+
+    //sum_squares starts with its loop, only its invocation counter makes the call of square hot
+    BOOST_CHECK (profiled_compiler.global_context().stats().counter_safe("profile_hot_call_sites") > 0);
+
+    auto profiled = eddic::execCommand("./profile.out");
+    remove("./profile.out");
+
+    BOOST_CHECK_EQUAL (instrumented, profiled);
+
+    std::filesystem::remove_all(directory);
+}
+
+BOOST_AUTO_TEST_CASE( profile_guided ){
+    validate_profile("--32", 4);
+    validate_profile("--64", 8);
+}
+
+/*
+ * Compile the program and verify that the spilled registers have been split inside the loop:
+ * the registers read several times in the loop body are reloaded less often than they are read.
+ */
+void validate_split_spills(const std::string& arch){
+    auto configuration = parse_options("test/cases/spill_loop.eddi", "spill_loop.out", {arch, "--O2"});
+
+    eddic::Compiler compiler;
+    BOOST_REQUIRE_EQUAL (compiler.compile("test/cases/spill_loop.eddi", configuration), 0);
+    remove("./spill_loop.out");
+
+    auto& stats = compiler.global_context().stats();
+
+    BOOST_CHECK (stats.counter_safe("split_spills") > 0);
+    BOOST_CHECK (stats.counter_safe("split_spill_reloads") > 0);
+    BOOST_CHECK (stats.counter_safe("split_spill_reloads") < stats.counter_safe("split_spill_reads"));
+}
+
+BOOST_AUTO_TEST_CASE( spill_loop ){
+    validate_split_spills("--32");
+    validate_split_spills("--64");
+
+    validate("spill_loop.eddi", 54495, 64495, 5000.0, 15000.0);
+}
+
+/*
+ * Store the interference graphs of all the functions in their sparse representation.
+ */
+struct sparse_interference_graphs {
+    std::size_t int_limit = eddic::ltac::interference_graph<eddic::ltac::PseudoRegister>::dense_limit;
+    std::size_t float_limit = eddic::ltac::interference_graph<eddic::ltac::PseudoFloatRegister>::dense_limit;
+
+    sparse_interference_graphs(){
+        eddic::ltac::interference_graph<eddic::ltac::PseudoRegister>::dense_limit = 0;
+        eddic::ltac::interference_graph<eddic::ltac::PseudoFloatRegister>::dense_limit = 0;
+    }
+
+    ~sparse_interference_graphs(){
+        eddic::ltac::interference_graph<eddic::ltac::PseudoRegister>::dense_limit = int_limit;
+        eddic::ltac::interference_graph<eddic::ltac::PseudoFloatRegister>::dense_limit = float_limit;
+    }
+};
+
+BOOST_AUTO_TEST_CASE( sparse_interference_graph ){
+    sparse_interference_graphs sparse;
+
+    validate("single_inheritance.eddi", 99, 55, 66, 77, 'B', 55, 66, 55.2, 55, 56.3, 55, 'B', 55, 66, 57.4, 55, 58.5, 55, 55, 66, 77);
+    assert_output("struct_layout.eddi", "a10Fx1.5000T0z|a11Tx1.5000F100z|a12Fx2.2500T200z|pq77r|st88u|");
+    assert_output("profile.eddi", "3117|2017|");
+}
+
 BOOST_AUTO_TEST_CASE( parameter_propagation ){
     validate_stats_mtac("parameter_propagation.eddi", "propagated_parameter", 5);
 }
@@ -0,0 +1,100 @@
+//=======================================================================
+// Copyright Baptiste Wicht 2011-2016.
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at
+//  http://opensource.org/licenses/MIT)
+//=======================================================================
+
+#include <random>
+
+#include "ltac/PseudoRegister.hpp"
+#include "ltac/interference_graph.hpp"
+
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+using namespace eddic;
+
+namespace {
+
+typedef ltac::interference_graph<ltac::PseudoRegister> graph_t;
+
+const std::size_t nodes = 300;
+
+/*
+ * Build the same random graph, the representation depends on the dense limit when it is built.
+ */
+void build(graph_t& graph, std::size_t dense_limit){
+    auto previous = graph_t::dense_limit;
+    graph_t::dense_limit = dense_limit;
+
+    for(unsigned short i = 0; i < nodes; ++i){
+        graph.gather(ltac::PseudoRegister(i));
+    }
+
+    graph.build_graph();
+
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<std::size_t> distribution(0, nodes - 1);
+
+    for(std::size_t e = 0; e < 4 * nodes; ++e){
+        auto i = distribution(generator);
+        auto j = distribution(generator);
+
+        graph.add_edge(i, j);
+    }
+
+    graph.build_adjacency_vectors();
+
+    graph_t::dense_limit = previous;
+}
+
+void check_same(graph_t& dense, graph_t& sparse){
+    for(std::size_t i = 0; i < nodes; ++i){
+        BOOST_REQUIRE_EQUAL(dense.degree(i), sparse.degree(i));
+        BOOST_REQUIRE(dense.neighbors(i) == sparse.neighbors(i));
+        BOOST_REQUIRE_EQUAL(dense.alias(i), sparse.alias(i));
+
+        for(std::size_t j = 0; j < nodes; ++j){
+            BOOST_REQUIRE_EQUAL(dense.connected(i, j), sparse.connected(i, j));
+            BOOST_REQUIRE_EQUAL(dense.connected(i, j), dense.connected(j, i));
+        }
+    }
+}
+
+} //end of anonymous namespace
+
+BOOST_AUTO_TEST_CASE( interference_graph_representations ){
+    graph_t dense;
+    build(dense, nodes);
+
+    graph_t sparse;
+    build(sparse, 0);
+
+    BOOST_CHECK(!dense.connected(0, 0));
+    BOOST_CHECK(!sparse.connected(0, 0));
+
+    check_same(dense, sparse);
+
+    //Merge the nodes that do not interfere, as the coalescing does
+    std::size_t merges = 0;
+
+    for(std::size_t i = 0; i + 1 < nodes; i += 2){
+        auto a = dense.alias(i);
+        auto b = dense.alias(i + 1);
+
+        if(a != b && !dense.connected(a, b)){
+            dense.merge(a, b);
+            sparse.merge(a, b);
+
+            BOOST_CHECK(dense.merged(a));
+            BOOST_CHECK_EQUAL(dense.degree(a), 0);
+
+            ++merges;
+        }
+    }
+
+    BOOST_CHECK(merges > 0);
+
+    check_same(dense, sparse);
+}
@@ -6,8 +6,11 @@
 //=======================================================================
 
 #include <string>
+#include <vector>
 
 #include "Utils.hpp"
+#include "Variable.hpp"
+#include "Type.hpp"
 
 #define BOOST_TEST_DYN_LINK
 #include <boost/test/unit_test.hpp>
@@ -23,3 +26,37 @@ BOOST_AUTO_TEST_CASE( toNumber ){
 
     BOOST_CHECK_EQUAL (value, 22);
 }
+
+BOOST_AUTO_TEST_CASE( variable_table ){
+    eddic::variable_table table;
+    eddic::variable_table::scope scope(table);
+
+    BOOST_CHECK(!eddic::variable_ref());
+    BOOST_CHECK(eddic::variable_ref(nullptr) == nullptr);
+
+    //Cross several chunks of the table
+    std::vector<std::shared_ptr<eddic::Variable>> variables;
+    for(int i = 0; i < 2000; ++i){
+        variables.push_back(eddic::make_variable("v" + std::to_string(i), eddic::INT, eddic::Position(eddic::PositionType::STACK, i)));
+    }
+
+    BOOST_CHECK_EQUAL (table.size(), 2001);
+
+    for(std::size_t i = 0; i < variables.size(); ++i){
+        eddic::variable_ref ref(variables[i]);
+
+        BOOST_CHECK_EQUAL (ref.id(), i + 1);
+        BOOST_CHECK(ref.shared() == variables[i]);
+        BOOST_CHECK(ref == variables[i]);
+    }
+
+    //The previous table is current again at the end of a nested scope
+    {
+        eddic::variable_table nested;
+        eddic::variable_table::scope nested_scope(nested);
+
+        BOOST_CHECK(&eddic::variable_table::current() == &nested);
+    }
+
+    BOOST_CHECK(&eddic::variable_table::current() == &table);
+}